@@ -0,0 +1,89 @@
+#include "aligned_buffer.h"
+
+#include <sys/mman.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_set>
+
+namespace {
+std::atomic<int> g_huge_page_mode{kHugePageTransparent};
+std::atomic<std::size_t> g_huge_page_allocations{0};
+
+// 显式巨页的映射（释放时需要munmap而不是free）
+std::mutex g_hugetlb_mutex;
+std::unordered_set<void*>& hugetlb_mappings() {
+  static std::unordered_set<void*> mappings;
+  return mappings;
+}
+
+std::size_t round_up(std::size_t bytes, std::size_t align) {
+  return (bytes + align - 1) / align * align;
+}
+
+void* alloc_hugetlb(std::size_t bytes) {
+#ifdef MAP_HUGETLB
+  void* p = mmap(nullptr, round_up(bytes, kHugePageBytes),
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p == MAP_FAILED) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(g_hugetlb_mutex);
+  hugetlb_mappings().insert(p);
+  return p;
+#else
+  (void)bytes;
+  return nullptr;
+#endif
+}
+}  // namespace
+
+void set_huge_page_mode(HugePageMode mode) { g_huge_page_mode = mode; }
+
+HugePageMode huge_page_mode() {
+  return static_cast<HugePageMode>(g_huge_page_mode.load());
+}
+
+std::size_t huge_page_allocations() { return g_huge_page_allocations; }
+
+void* tensor_alloc(std::size_t bytes) {
+  if (bytes == 0) {
+    bytes = 1;
+  }
+  HugePageMode mode = huge_page_mode();
+  bool huge = bytes >= kHugePageBytes && mode != kHugePageNone;
+  if (huge && mode == kHugePageExplicit) {
+    void* p = alloc_hugetlb(bytes);
+    if (p != nullptr) {
+      ++g_huge_page_allocations;
+      return p;
+    }
+  }
+  void* p = nullptr;
+  std::size_t align = huge ? kHugePageBytes : kTensorAlignment;
+  if (posix_memalign(&p, align, huge ? round_up(bytes, align) : bytes) != 0) {
+    return nullptr;
+  }
+#ifdef MADV_HUGEPAGE
+  if (huge && madvise(p, round_up(bytes, align), MADV_HUGEPAGE) == 0) {
+    ++g_huge_page_allocations;
+  }
+#endif
+  return p;
+}
+
+void tensor_free(void* ptr, std::size_t bytes) {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (bytes >= kHugePageBytes) {
+    std::lock_guard<std::mutex> lock(g_hugetlb_mutex);
+    if (hugetlb_mappings().erase(ptr) != 0) {
+      munmap(ptr, round_up(bytes, kHugePageBytes));
+      return;
+    }
+  }
+  free(ptr);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// 张量数据的对齐分配。std::vector<float>只保证16字节对齐，大块内存由malloc
+// 的头部错开，分块HWC布局中align_channels个通道的一组会跨缓存行；大的5维张量
+// 在C轴跨步扫描时每个像素落在不同的4KB页上，TLB缺失频繁。
+// 这里按kTensorAlignment对齐（覆盖64字节缓存行和VLEN<=1024的向量寄存器），
+// 不小于kHugePageBytes的分配按巨页对齐并按huge_page_mode使用巨页
+constexpr std::size_t kTensorAlignment = 128;
+constexpr std::size_t kHugePageBytes = 2 * 1024 * 1024;
+
+enum HugePageMode {
+  kHugePageNone = 0,         // 只按kTensorAlignment对齐
+  kHugePageTransparent = 1,  // 2MB对齐并madvise(MADV_HUGEPAGE)，由内核合并巨页
+  kHugePageExplicit = 2      // mmap(MAP_HUGETLB)显式巨页，失败时退回透明巨页
+};
+
+// 进程内全局的巨页策略（默认透明巨页），只影响之后的分配；
+// 系统不支持时（如rt-smart没有madvise/MAP_HUGETLB）按kHugePageNone处理
+void set_huge_page_mode(HugePageMode mode);
+HugePageMode huge_page_mode();
+
+// 按上述规则分配/释放bytes字节，失败时返回nullptr。
+// tensor_free的bytes必须与分配时相同（显式巨页按大小munmap）
+void* tensor_alloc(std::size_t bytes);
+void tensor_free(void* ptr, std::size_t bytes);
+
+// 实际落在巨页上的分配次数（显式巨页成功或透明巨页madvise成功）
+std::size_t huge_page_allocations();
+
+// 用tensor_alloc分配的std容器分配器
+template <typename T>
+struct AlignedAllocator {
+  using value_type = T;
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U>&) {}
+
+  T* allocate(std::size_t n) {
+    void* p = tensor_alloc(n * sizeof(T));
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+  void deallocate(T* p, std::size_t n) { tensor_free(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+  return true;
+}
+template <typename T, typename U>
+bool operator!=(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+  return false;
+}
+
+// 对齐的张量缓冲区，gather_hwc、convert_*和readFileAligned都提供该类型的版本
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
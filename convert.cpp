@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
@@ -5,95 +6,83 @@
 #include <stdexcept>
 #include <vector>
 
-/**
- * 3维CHW到HWC转换，按指定通道数对齐（分组存储）
- * @param input CHW格式的输入数据
- * @param c 通道数
- * @param h 高度
- * @param w 宽度
- * @param align_channels 对齐的通道数（如64）
- * @return HWC格式的输出数据（分组存储格式）
- */
-std::vector<float> convert_chw_to_hwc_3d(const std::vector<float>& input, int c,
-                                         int h, int w,
-                                         int align_channels = 64) {
-  if (input.size() != c * h * w) {
-    throw std::invalid_argument("输入数据大小与指定维度不匹配");
-  }
-
+#include "aligned_buffer.h"
+#include "elem_type.h"
+#include "gather_view.h"
+#include "tensor_util.h"
+#include "workspace.h"
+
+namespace {
+// index_t为下标的计算类型：补零后的张量元素数不超过INT32_MAX时用int32_t，
+// 否则用int64_t，避免大张量下标溢出
+
+template <typename out_t, typename in_t, typename index_t, typename OutVec,
+          typename PadVec, typename InVec>
+void chw_to_hwc_3d(OutVec& result, PadVec& padded_data,
+                   const InVec& input, index_t c, index_t h,
+                   index_t w, index_t align_channels) {
   // 计算需要补零的通道数和分组数
-  int padding_channels = (align_channels - c % align_channels) % align_channels;
-  int total_channels = c + padding_channels;
-  int num_groups = total_channels / align_channels;
+  index_t padding_channels =
+      (align_channels - c % align_channels) % align_channels;
+  index_t total_channels = c + padding_channels;
+  index_t num_groups = total_channels / align_channels;
 
   // 创建补零后的CHW数据
-  std::vector<float> padded_data(total_channels * h * w, 0.0f);
+  padded_data.assign(total_channels * h * w, in_t());
 
   // 将原始数据拷贝到补零缓冲区
-  for (int ci = 0; ci < c; ++ci) {
-    for (int hi = 0; hi < h; ++hi) {
-      for (int wi = 0; wi < w; ++wi) {
-        int src_idx = ci * h * w + hi * w + wi;
-        int dst_idx = ci * h * w + hi * w + wi;
+  for (index_t ci = 0; ci < c; ++ci) {
+    for (index_t hi = 0; hi < h; ++hi) {
+      for (index_t wi = 0; wi < w; ++wi) {
+        index_t src_idx = ci * h * w + hi * w + wi;
+        index_t dst_idx = ci * h * w + hi * w + wi;
         padded_data[dst_idx] = input[src_idx];
       }
     }
   }
 
   // 准备分组存储的结果数据缓冲区
-  std::vector<float> result;
+  result.clear();
   result.reserve(h * w * total_channels);
 
   // 按对齐分组提取数据
-  for (int g = 0; g < num_groups; ++g) {
-    int channel_start = g * align_channels;
-
-    for (int hi = 0; hi < h; ++hi) {
-      for (int wi = 0; wi < w; ++wi) {
-        for (int cg = 0; cg < align_channels; ++cg) {
-          int channel = channel_start + cg;
-          int idx = channel * h * w + hi * w + wi;
-          result.push_back(padded_data[idx]);
+  for (index_t g = 0; g < num_groups; ++g) {
+    index_t channel_start = g * align_channels;
+
+    for (index_t hi = 0; hi < h; ++hi) {
+      for (index_t wi = 0; wi < w; ++wi) {
+        for (index_t cg = 0; cg < align_channels; ++cg) {
+          index_t channel = channel_start + cg;
+          index_t idx = channel * h * w + hi * w + wi;
+          result.push_back(elem_cast<out_t>(padded_data[idx]));
         }
       }
     }
   }
-
-  return result;
 }
 
-/**
- * 3维HWC到CHW转换（从分组存储格式）
- * @param input HWC格式的输入数据（分组存储格式）
- * @param c 原始通道数（不包括padding）
- * @param h 高度
- * @param w 宽度
- * @param align_channels 对齐的通道数
- * @return CHW格式的输出数据
- */
-std::vector<float> convert_hwc_to_chw_3d(const std::vector<float>& input, int c,
-                                         int h, int w,
-                                         int align_channels = 64) {
-  int padding_channels = (align_channels - c % align_channels) % align_channels;
-  int total_channels = c + padding_channels;
-  int num_groups = total_channels / align_channels;
-
-  if (input.size() != h * w * total_channels) {
-    throw std::invalid_argument("输入数据大小与指定维度不匹配");
-  }
+template <typename out_t, typename in_t, typename index_t, typename OutVec,
+          typename PadVec, typename InVec>
+void hwc_to_chw_3d(OutVec& output, PadVec& padded_data,
+                   const InVec& input, index_t c, index_t h,
+                   index_t w, index_t align_channels) {
+  index_t padding_channels =
+      (align_channels - c % align_channels) % align_channels;
+  index_t total_channels = c + padding_channels;
+  index_t num_groups = total_channels / align_channels;
 
   // 从分组存储格式重构为补零CHW格式
-  std::vector<float> padded_data(total_channels * h * w, 0.0f);
+  padded_data.assign(total_channels * h * w, in_t());
 
-  int input_idx = 0;
-  for (int g = 0; g < num_groups; ++g) {
-    int channel_start = g * align_channels;
+  index_t input_idx = 0;
+  for (index_t g = 0; g < num_groups; ++g) {
+    index_t channel_start = g * align_channels;
 
-    for (int hi = 0; hi < h; ++hi) {
-      for (int wi = 0; wi < w; ++wi) {
-        for (int cg = 0; cg < align_channels; ++cg) {
-          int channel = channel_start + cg;
-          int chw_idx = channel * h * w + hi * w + wi;
+    for (index_t hi = 0; hi < h; ++hi) {
+      for (index_t wi = 0; wi < w; ++wi) {
+        for (index_t cg = 0; cg < align_channels; ++cg) {
+          index_t channel = channel_start + cg;
+          index_t chw_idx = channel * h * w + hi * w + wi;
           padded_data[chw_idx] = input[input_idx++];
         }
       }
@@ -101,52 +90,41 @@ std::vector<float> convert_hwc_to_chw_3d(const std::vector<float>& input, int c,
   }
 
   // 提取原始通道数据
-  std::vector<float> output(c * h * w);
-  for (int ci = 0; ci < c; ++ci) {
-    for (int hi = 0; hi < h; ++hi) {
-      for (int wi = 0; wi < w; ++wi) {
-        int src_idx = ci * h * w + hi * w + wi;
-        int dst_idx = ci * h * w + hi * w + wi;
-        output[dst_idx] = padded_data[src_idx];
+  output.resize(c * h * w);
+  for (index_t ci = 0; ci < c; ++ci) {
+    for (index_t hi = 0; hi < h; ++hi) {
+      for (index_t wi = 0; wi < w; ++wi) {
+        index_t src_idx = ci * h * w + hi * w + wi;
+        index_t dst_idx = ci * h * w + hi * w + wi;
+        output[dst_idx] = elem_cast<out_t>(padded_data[src_idx]);
       }
     }
   }
-
-  return output;
 }
 
-/**
- * 4维NCHW到NHWC转换，按指定通道数对齐（分组存储）
- * @param input NCHW格式的输入数据
- * @param n 批次数
- * @param c 通道数
- * @param h 高度
- * @param w 宽度
- * @param align_channels 对齐的通道数
- * @return NHWC格式的输出数据（分组存储格式）
- */
-std::vector<float> convert_nchw_to_nhwc_4d(const std::vector<float>& input,
-                                           int n, int c, int h, int w,
-                                           int align_channels = 64) {
-  if (input.size() != n * c * h * w) {
-    throw std::invalid_argument("输入数据大小与指定维度不匹配");
-  }
-
+template <typename out_t, typename in_t, typename index_t, typename OutVec,
+          typename PadVec, typename InVec>
+void nchw_to_nhwc_4d(OutVec& result,
+                     PadVec& padded_data,
+                     const InVec& input, index_t n, index_t c,
+                     index_t h, index_t w, index_t align_channels) {
   // 计算需要补零的通道数和分组数
-  int padding_channels = (align_channels - c % align_channels) % align_channels;
-  int total_channels = c + padding_channels;
-  int num_groups = total_channels / align_channels;
+  index_t padding_channels =
+      (align_channels - c % align_channels) % align_channels;
+  index_t total_channels = c + padding_channels;
+  index_t num_groups = total_channels / align_channels;
 
   // 创建补零后的NCHW数据
-  std::vector<float> padded_data(n * total_channels * h * w, 0.0f);
+  padded_data.assign(n * total_channels * h * w, in_t());
 
   // 将原始数据拷贝到补零缓冲区
-  for (int ni = 0; ni < n; ++ni) {
-    for (int ci = 0; ci < c; ++ci) {
-      for (int hi = 0; hi < h; ++hi) {
-        for (int wi = 0; wi < w; ++wi) {
-          int src_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          int dst_idx = ni * total_channels * h * w + ci * h * w + hi * w + wi;
+  for (index_t ni = 0; ni < n; ++ni) {
+    for (index_t ci = 0; ci < c; ++ci) {
+      for (index_t hi = 0; hi < h; ++hi) {
+        for (index_t wi = 0; wi < w; ++wi) {
+          index_t src_idx = ni * c * h * w + ci * h * w + hi * w + wi;
+          index_t dst_idx =
+              ni * total_channels * h * w + ci * h * w + hi * w + wi;
           padded_data[dst_idx] = input[src_idx];
         }
       }
@@ -154,64 +132,52 @@ std::vector<float> convert_nchw_to_nhwc_4d(const std::vector<float>& input,
   }
 
   // 准备分组存储的结果数据缓冲区
-  std::vector<float> result;
+  result.clear();
   result.reserve(n * h * w * total_channels);
 
   // 按对齐分组提取数据
-  for (int g = 0; g < num_groups; ++g) {
-    int channel_start = g * align_channels;
-
-    for (int ni = 0; ni < n; ++ni) {
-      for (int hi = 0; hi < h; ++hi) {
-        for (int wi = 0; wi < w; ++wi) {
-          for (int cg = 0; cg < align_channels; ++cg) {
-            int channel = channel_start + cg;
-            int idx =
+  for (index_t g = 0; g < num_groups; ++g) {
+    index_t channel_start = g * align_channels;
+
+    for (index_t ni = 0; ni < n; ++ni) {
+      for (index_t hi = 0; hi < h; ++hi) {
+        for (index_t wi = 0; wi < w; ++wi) {
+          for (index_t cg = 0; cg < align_channels; ++cg) {
+            index_t channel = channel_start + cg;
+            index_t idx =
                 ni * total_channels * h * w + channel * h * w + hi * w + wi;
-            result.push_back(padded_data[idx]);
+            result.push_back(elem_cast<out_t>(padded_data[idx]));
           }
         }
       }
     }
   }
-
-  return result;
 }
 
-/**
- * 4维NHWC到NCHW转换（从分组存储格式）
- * @param input NHWC格式的输入数据（分组存储格式）
- * @param n 批次数
- * @param c 原始通道数
- * @param h 高度
- * @param w 宽度
- * @param align_channels 对齐的通道数
- * @return NCHW格式的输出数据
- */
-std::vector<float> convert_nhwc_to_nchw_4d(const std::vector<float>& input,
-                                           int n, int c, int h, int w,
-                                           int align_channels = 64) {
-  int padding_channels = (align_channels - c % align_channels) % align_channels;
-  int total_channels = c + padding_channels;
-  int num_groups = total_channels / align_channels;
-
-  if (input.size() != n * h * w * total_channels) {
-    throw std::invalid_argument("输入数据大小与指定维度不匹配");
-  }
+template <typename out_t, typename in_t, typename index_t, typename OutVec,
+          typename PadVec, typename InVec>
+void nhwc_to_nchw_4d(OutVec& output,
+                     PadVec& padded_data,
+                     const InVec& input, index_t n, index_t c,
+                     index_t h, index_t w, index_t align_channels) {
+  index_t padding_channels =
+      (align_channels - c % align_channels) % align_channels;
+  index_t total_channels = c + padding_channels;
+  index_t num_groups = total_channels / align_channels;
 
   // 从分组存储格式重构为补零NCHW格式
-  std::vector<float> padded_data(n * total_channels * h * w, 0.0f);
-
-  int input_idx = 0;
-  for (int g = 0; g < num_groups; ++g) {
-    int channel_start = g * align_channels;
-
-    for (int ni = 0; ni < n; ++ni) {
-      for (int hi = 0; hi < h; ++hi) {
-        for (int wi = 0; wi < w; ++wi) {
-          for (int cg = 0; cg < align_channels; ++cg) {
-            int channel = channel_start + cg;
-            int nchw_idx =
+  padded_data.assign(n * total_channels * h * w, in_t());
+
+  index_t input_idx = 0;
+  for (index_t g = 0; g < num_groups; ++g) {
+    index_t channel_start = g * align_channels;
+
+    for (index_t ni = 0; ni < n; ++ni) {
+      for (index_t hi = 0; hi < h; ++hi) {
+        for (index_t wi = 0; wi < w; ++wi) {
+          for (index_t cg = 0; cg < align_channels; ++cg) {
+            index_t channel = channel_start + cg;
+            index_t nchw_idx =
                 ni * total_channels * h * w + channel * h * w + hi * w + wi;
             padded_data[nchw_idx] = input[input_idx++];
           }
@@ -221,59 +187,48 @@ std::vector<float> convert_nhwc_to_nchw_4d(const std::vector<float>& input,
   }
 
   // 提取原始通道数据
-  std::vector<float> output(n * c * h * w);
-  for (int ni = 0; ni < n; ++ni) {
-    for (int ci = 0; ci < c; ++ci) {
-      for (int hi = 0; hi < h; ++hi) {
-        for (int wi = 0; wi < w; ++wi) {
-          int src_idx = ni * total_channels * h * w + ci * h * w + hi * w + wi;
-          int dst_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          output[dst_idx] = padded_data[src_idx];
+  output.resize(n * c * h * w);
+  for (index_t ni = 0; ni < n; ++ni) {
+    for (index_t ci = 0; ci < c; ++ci) {
+      for (index_t hi = 0; hi < h; ++hi) {
+        for (index_t wi = 0; wi < w; ++wi) {
+          index_t src_idx =
+              ni * total_channels * h * w + ci * h * w + hi * w + wi;
+          index_t dst_idx = ni * c * h * w + ci * h * w + hi * w + wi;
+          output[dst_idx] = elem_cast<out_t>(padded_data[src_idx]);
         }
       }
     }
   }
-
-  return output;
 }
 
-/**
- * 5维LNCHW到LNHWC转换，按指定通道数对齐（分组存储）
- * @param input LNCHW格式的输入数据
- * @param l 长度/序列长度
- * @param n 批次数
- * @param h 高度
- * @param w 宽度
- * @param c 通道数
- * @param align_channels 对齐的通道数
- * @return LNHWC格式的输出数据（分组存储格式）
- */
-std::vector<float> convert_lnchw_to_lnhwc_5d(const std::vector<float>& input,
-                                             int l, int n, int h, int w, int c,
-                                             int align_channels) {
-  if (input.size() != l * n * c * h * w) {
-    throw std::invalid_argument("输入数据大小与指定维度不匹配");
-  }
-
+template <typename out_t, typename in_t, typename index_t, typename OutVec,
+          typename PadVec, typename InVec>
+void lnchw_to_lnhwc_5d(OutVec& result,
+                       PadVec& padded_data,
+                       const InVec& input, index_t l, index_t n,
+                       index_t h, index_t w, index_t c,
+                       index_t align_channels) {
   // 计算需要补零的通道数和分组数
-  int padding_channels = (align_channels - c % align_channels) % align_channels;
-  int total_channels = c + padding_channels;
-  int num_groups = total_channels / align_channels;
+  index_t padding_channels =
+      (align_channels - c % align_channels) % align_channels;
+  index_t total_channels = c + padding_channels;
+  index_t num_groups = total_channels / align_channels;
 
   // 创建补零后的LNCHW数据
-  std::vector<float> padded_data(l * n * total_channels * h * w, 0.0f);
+  padded_data.assign(l * n * total_channels * h * w, in_t());
 
   // 将原始数据拷贝到补零缓冲区
-  for (int li = 0; li < l; ++li) {
-    for (int ni = 0; ni < n; ++ni) {
-      for (int ci = 0; ci < c; ++ci) {
-        for (int hi = 0; hi < h; ++hi) {
-          for (int wi = 0; wi < w; ++wi) {
-            int src_idx =
+  for (index_t li = 0; li < l; ++li) {
+    for (index_t ni = 0; ni < n; ++ni) {
+      for (index_t ci = 0; ci < c; ++ci) {
+        for (index_t hi = 0; hi < h; ++hi) {
+          for (index_t wi = 0; wi < w; ++wi) {
+            index_t src_idx =
                 li * n * c * h * w + ni * c * h * w + ci * h * w + hi * w + wi;
-            int dst_idx = li * n * total_channels * h * w +
-                          ni * total_channels * h * w + ci * h * w + hi * w +
-                          wi;
+            index_t dst_idx = li * n * total_channels * h * w +
+                              ni * total_channels * h * w + ci * h * w +
+                              hi * w + wi;
             padded_data[dst_idx] = input[src_idx];
           }
         }
@@ -282,24 +237,62 @@ std::vector<float> convert_lnchw_to_lnhwc_5d(const std::vector<float>& input,
   }
 
   // 准备分组存储的结果数据缓冲区
-  std::vector<float> result;
+  result.clear();
   result.reserve(l * n * h * w * total_channels);
 
   // 按对齐分组提取数据
-  for (int g = 0; g < num_groups; ++g) {
-    int channel_start = g * align_channels;
+  for (index_t g = 0; g < num_groups; ++g) {
+    index_t channel_start = g * align_channels;
 
     // 按LNHWC顺序进行转换
-    for (int li = 0; li < l; ++li) {
-      for (int ni = 0; ni < n; ++ni) {
-        for (int hi = 0; hi < h; ++hi) {
-          for (int wi = 0; wi < w; ++wi) {
-            for (int cg = 0; cg < align_channels; ++cg) {
-              int channel = channel_start + cg;
-              int idx = li * n * total_channels * h * w +
-                        ni * total_channels * h * w + channel * h * w + hi * w +
-                        wi;
-              result.push_back(padded_data[idx]);
+    for (index_t li = 0; li < l; ++li) {
+      for (index_t ni = 0; ni < n; ++ni) {
+        for (index_t hi = 0; hi < h; ++hi) {
+          for (index_t wi = 0; wi < w; ++wi) {
+            for (index_t cg = 0; cg < align_channels; ++cg) {
+              index_t channel = channel_start + cg;
+              index_t idx = li * n * total_channels * h * w +
+                            ni * total_channels * h * w + channel * h * w +
+                            hi * w + wi;
+              result.push_back(elem_cast<out_t>(padded_data[idx]));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename out_t, typename in_t, typename index_t, typename OutVec,
+          typename PadVec, typename InVec>
+void lnhwc_to_lnchw_5d(OutVec& output,
+                       PadVec& padded_data,
+                       const InVec& input, index_t l, index_t n,
+                       index_t h, index_t w, index_t c,
+                       index_t align_channels) {
+  index_t padding_channels =
+      (align_channels - c % align_channels) % align_channels;
+  index_t total_channels = c + padding_channels;
+  index_t num_groups = total_channels / align_channels;
+
+  // 从分组存储格式重构为补零LNCHW格式
+  padded_data.assign(l * n * total_channels * h * w, in_t());
+
+  index_t input_idx = 0;
+  for (index_t g = 0; g < num_groups; ++g) {
+    index_t channel_start = g * align_channels;
+
+    // 按LNHWC顺序处理输入数据
+    for (index_t li = 0; li < l; ++li) {
+      for (index_t ni = 0; ni < n; ++ni) {
+        for (index_t hi = 0; hi < h; ++hi) {
+          for (index_t wi = 0; wi < w; ++wi) {
+            for (index_t cg = 0; cg < align_channels; ++cg) {
+              index_t channel = channel_start + cg;
+              index_t lnchw_idx = li * n * total_channels * h * w +
+                                  ni * total_channels * h * w +
+                                  channel * h * w + hi * w + wi;
+              padded_data[lnchw_idx] = input[input_idx++];
             }
           }
         }
@@ -307,8 +300,260 @@ std::vector<float> convert_lnchw_to_lnhwc_5d(const std::vector<float>& input,
     }
   }
 
+  // 提取原始通道数据
+  output.resize(l * n * c * h * w);
+  for (index_t li = 0; li < l; ++li) {
+    for (index_t ni = 0; ni < n; ++ni) {
+      for (index_t ci = 0; ci < c; ++ci) {
+        for (index_t hi = 0; hi < h; ++hi) {
+          for (index_t wi = 0; wi < w; ++wi) {
+            index_t src_idx = li * n * total_channels * h * w +
+                              ni * total_channels * h * w + ci * h * w +
+                              hi * w + wi;
+            index_t dst_idx =
+                li * n * c * h * w + ni * c * h * w + ci * h * w + hi * w + wi;
+            output[dst_idx] = elem_cast<out_t>(padded_data[src_idx]);
+          }
+        }
+      }
+    }
+  }
+}
+// 以下*_into检查参数，按补零后的张量大小选择下标类型，把结果写入result，
+// padded_data为补零临时张量。普通版本和工作区版本共用
+template <typename OutVec, typename PadVec, typename InVec>
+void chw_to_hwc_3d_into(OutVec& result, PadVec& padded_data,
+                        const InVec& input, int c, int h, int w,
+                        int align_channels) {
+  using out_t = typename OutVec::value_type;
+  using in_t = typename InVec::value_type;
+  if (static_cast<std::int64_t>(input.size()) != shape_numel({c, h, w})) {
+    throw std::invalid_argument("输入数据大小与指定维度不匹配");
+  }
+  if (fits_int32(padded_channels(c, align_channels) * h * w)) {
+    chw_to_hwc_3d<out_t, in_t, std::int32_t>(result, padded_data, input, c, h,
+                                             w, align_channels);
+    return;
+  }
+  chw_to_hwc_3d<out_t, in_t, std::int64_t>(result, padded_data, input, c, h, w,
+                                           align_channels);
+}
+
+template <typename OutVec, typename PadVec, typename InVec>
+void hwc_to_chw_3d_into(OutVec& output, PadVec& padded_data,
+                        const InVec& input, int c, int h, int w,
+                        int align_channels) {
+  using out_t = typename OutVec::value_type;
+  using in_t = typename InVec::value_type;
+  std::int64_t padded_size =
+      shape_numel({h, w}) * padded_channels(c, align_channels);
+  if (static_cast<std::int64_t>(input.size()) != padded_size) {
+    throw std::invalid_argument("输入数据大小与指定维度不匹配");
+  }
+  if (fits_int32(padded_size)) {
+    hwc_to_chw_3d<out_t, in_t, std::int32_t>(output, padded_data, input, c, h,
+                                             w, align_channels);
+    return;
+  }
+  hwc_to_chw_3d<out_t, in_t, std::int64_t>(output, padded_data, input, c, h, w,
+                                           align_channels);
+}
+
+template <typename OutVec, typename PadVec, typename InVec>
+void nchw_to_nhwc_4d_into(OutVec& result, PadVec& padded_data,
+                          const InVec& input, int n, int c, int h,
+                          int w, int align_channels) {
+  using out_t = typename OutVec::value_type;
+  using in_t = typename InVec::value_type;
+  if (static_cast<std::int64_t>(input.size()) != shape_numel({n, c, h, w})) {
+    throw std::invalid_argument("输入数据大小与指定维度不匹配");
+  }
+  if (fits_int32(shape_numel({n, h, w}) * padded_channels(c, align_channels))) {
+    nchw_to_nhwc_4d<out_t, in_t, std::int32_t>(result, padded_data, input, n,
+                                               c, h, w, align_channels);
+    return;
+  }
+  nchw_to_nhwc_4d<out_t, in_t, std::int64_t>(result, padded_data, input, n, c,
+                                             h, w, align_channels);
+}
+
+template <typename OutVec, typename PadVec, typename InVec>
+void nhwc_to_nchw_4d_into(OutVec& output, PadVec& padded_data,
+                          const InVec& input, int n, int c, int h,
+                          int w, int align_channels) {
+  using out_t = typename OutVec::value_type;
+  using in_t = typename InVec::value_type;
+  std::int64_t padded_size =
+      shape_numel({n, h, w}) * padded_channels(c, align_channels);
+  if (static_cast<std::int64_t>(input.size()) != padded_size) {
+    throw std::invalid_argument("输入数据大小与指定维度不匹配");
+  }
+  if (fits_int32(padded_size)) {
+    nhwc_to_nchw_4d<out_t, in_t, std::int32_t>(output, padded_data, input, n,
+                                               c, h, w, align_channels);
+    return;
+  }
+  nhwc_to_nchw_4d<out_t, in_t, std::int64_t>(output, padded_data, input, n, c,
+                                             h, w, align_channels);
+}
+
+template <typename OutVec, typename PadVec, typename InVec>
+void lnchw_to_lnhwc_5d_into(OutVec& result, PadVec& padded_data,
+                            const InVec& input, int l, int n,
+                            int h, int w, int c, int align_channels) {
+  using out_t = typename OutVec::value_type;
+  using in_t = typename InVec::value_type;
+  if (static_cast<std::int64_t>(input.size()) != shape_numel({l, n, c, h, w})) {
+    throw std::invalid_argument("输入数据大小与指定维度不匹配");
+  }
+  if (fits_int32(shape_numel({l, n, h, w}) *
+                 padded_channels(c, align_channels))) {
+    lnchw_to_lnhwc_5d<out_t, in_t, std::int32_t>(result, padded_data, input, l,
+                                                 n, h, w, c, align_channels);
+    return;
+  }
+  lnchw_to_lnhwc_5d<out_t, in_t, std::int64_t>(result, padded_data, input, l,
+                                               n, h, w, c, align_channels);
+}
+
+template <typename OutVec, typename PadVec, typename InVec>
+void lnhwc_to_lnchw_5d_into(OutVec& output, PadVec& padded_data,
+                            const InVec& input, int l, int n,
+                            int h, int w, int c, int align_channels) {
+  using out_t = typename OutVec::value_type;
+  using in_t = typename InVec::value_type;
+  std::int64_t padded_size =
+      shape_numel({l, n, h, w}) * padded_channels(c, align_channels);
+  if (static_cast<std::int64_t>(input.size()) != padded_size) {
+    throw std::invalid_argument("输入数据大小与指定维度不匹配");
+  }
+  if (fits_int32(padded_size)) {
+    lnhwc_to_lnchw_5d<out_t, in_t, std::int32_t>(output, padded_data, input, l,
+                                                 n, h, w, c, align_channels);
+    return;
+  }
+  lnhwc_to_lnchw_5d<out_t, in_t, std::int64_t>(output, padded_data, input, l,
+                                               n, h, w, c, align_channels);
+}
+
+// 普通版本：输出每次新分配，OutVec为std::vector或AlignedVector；
+// 补零临时张量总是对齐分配
+template <typename out_t, typename in_t, typename OutVec = std::vector<out_t>,
+          typename Into>
+OutVec convert_new(Into into) {
+  OutVec result;
+  AlignedVector<in_t> padded_data;
+  into(result, padded_data);
+  return result;
+}
+
+// 工作区版本：输出从ws取用（由调用者在帧之间reset归还），
+// 补零临时张量在返回前归还。抛出异常时输出缓冲区同样在reset时归还
+template <typename out_t, typename in_t, typename Into>
+std::vector<out_t>& convert_in_workspace(Workspace& ws, Into into) {
+  std::vector<out_t>& result = ws.acquire<out_t>(0);
+  WorkspaceScope scope(ws);
+  into(result, ws.acquire<in_t>(0));
   return result;
 }
+}  // namespace
+
+/**
+ * 3维CHW到HWC转换，按指定通道数对齐（分组存储）
+ * @param input CHW格式的输入数据
+ * @param c 通道数
+ * @param h 高度
+ * @param w 宽度
+ * @param align_channels 对齐的通道数（如64）
+ * @return HWC格式的输出数据（分组存储格式）
+ */
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_chw_to_hwc_3d(const std::vector<in_t>& input, int c,
+                                         int h, int w,
+                                         int align_channels) {
+  return convert_new<out_t, in_t>([&](auto& result, auto& padded_data) {
+    chw_to_hwc_3d_into(result, padded_data, input, c, h, w, align_channels);
+  });
+}
+
+/**
+ * 3维HWC到CHW转换（从分组存储格式）
+ * @param input HWC格式的输入数据（分组存储格式）
+ * @param c 原始通道数（不包括padding）
+ * @param h 高度
+ * @param w 宽度
+ * @param align_channels 对齐的通道数
+ * @return CHW格式的输出数据
+ */
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_hwc_to_chw_3d(const std::vector<in_t>& input, int c,
+                                         int h, int w,
+                                         int align_channels) {
+  return convert_new<out_t, in_t>([&](auto& output, auto& padded_data) {
+    hwc_to_chw_3d_into(output, padded_data, input, c, h, w, align_channels);
+  });
+}
+
+/**
+ * 4维NCHW到NHWC转换，按指定通道数对齐（分组存储）
+ * @param input NCHW格式的输入数据
+ * @param n 批次数
+ * @param c 通道数
+ * @param h 高度
+ * @param w 宽度
+ * @param align_channels 对齐的通道数
+ * @return NHWC格式的输出数据（分组存储格式）
+ */
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_nchw_to_nhwc_4d(const std::vector<in_t>& input,
+                                           int n, int c, int h, int w,
+                                           int align_channels) {
+  return convert_new<out_t, in_t>([&](auto& result, auto& padded_data) {
+    nchw_to_nhwc_4d_into(result, padded_data, input, n, c, h, w,
+                         align_channels);
+  });
+}
+
+/**
+ * 4维NHWC到NCHW转换（从分组存储格式）
+ * @param input NHWC格式的输入数据（分组存储格式）
+ * @param n 批次数
+ * @param c 原始通道数
+ * @param h 高度
+ * @param w 宽度
+ * @param align_channels 对齐的通道数
+ * @return NCHW格式的输出数据
+ */
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_nhwc_to_nchw_4d(const std::vector<in_t>& input,
+                                           int n, int c, int h, int w,
+                                           int align_channels) {
+  return convert_new<out_t, in_t>([&](auto& output, auto& padded_data) {
+    nhwc_to_nchw_4d_into(output, padded_data, input, n, c, h, w,
+                         align_channels);
+  });
+}
+
+/**
+ * 5维LNCHW到LNHWC转换，按指定通道数对齐（分组存储）
+ * @param input LNCHW格式的输入数据
+ * @param l 长度/序列长度
+ * @param n 批次数
+ * @param h 高度
+ * @param w 宽度
+ * @param c 通道数
+ * @param align_channels 对齐的通道数
+ * @return LNHWC格式的输出数据（分组存储格式）
+ */
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_lnchw_to_lnhwc_5d(const std::vector<in_t>& input,
+                                             int l, int n, int h, int w, int c,
+                                             int align_channels) {
+  return convert_new<out_t, in_t>([&](auto& result, auto& padded_data) {
+    lnchw_to_lnhwc_5d_into(result, padded_data, input, l, n, h, w, c,
+                           align_channels);
+  });
+}
 
 /**
  * 5维LNHWC到LNCHW转换（从分组存储格式）
@@ -321,64 +566,374 @@ std::vector<float> convert_lnchw_to_lnhwc_5d(const std::vector<float>& input,
  * @param align_channels 对齐的通道数
  * @return LNCHW格式的输出数据
  */
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_lnhwc_to_lnchw_5d(const std::vector<in_t>& input,
+                                             int l, int n, int h, int w, int c,
+                                             int align_channels) {
+  return convert_new<out_t, in_t>([&](auto& output, auto& padded_data) {
+    lnhwc_to_lnchw_5d_into(output, padded_data, input, l, n, h, w, c,
+                           align_channels);
+  });
+}
+
+// 对齐缓冲区版本，参数同上，输入和输出都是AlignedVector
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_chw_to_hwc_3d(const AlignedVector<in_t>& input,
+                                           int c, int h, int w,
+                                           int align_channels) {
+  return convert_new<out_t, in_t, AlignedVector<out_t>>(
+      [&](auto& result, auto& padded_data) {
+        chw_to_hwc_3d_into(result, padded_data, input, c, h, w,
+                           align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_hwc_to_chw_3d(const AlignedVector<in_t>& input,
+                                           int c, int h, int w,
+                                           int align_channels) {
+  return convert_new<out_t, in_t, AlignedVector<out_t>>(
+      [&](auto& output, auto& padded_data) {
+        hwc_to_chw_3d_into(output, padded_data, input, c, h, w,
+                           align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_nchw_to_nhwc_4d(const AlignedVector<in_t>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels) {
+  return convert_new<out_t, in_t, AlignedVector<out_t>>(
+      [&](auto& result, auto& padded_data) {
+        nchw_to_nhwc_4d_into(result, padded_data, input, n, c, h, w,
+                             align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_nhwc_to_nchw_4d(const AlignedVector<in_t>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels) {
+  return convert_new<out_t, in_t, AlignedVector<out_t>>(
+      [&](auto& output, auto& padded_data) {
+        nhwc_to_nchw_4d_into(output, padded_data, input, n, c, h, w,
+                             align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_lnchw_to_lnhwc_5d(
+    const AlignedVector<in_t>& input, int l, int n, int h, int w, int c,
+    int align_channels) {
+  return convert_new<out_t, in_t, AlignedVector<out_t>>(
+      [&](auto& result, auto& padded_data) {
+        lnchw_to_lnhwc_5d_into(result, padded_data, input, l, n, h, w, c,
+                               align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_lnhwc_to_lnchw_5d(
+    const AlignedVector<in_t>& input, int l, int n, int h, int w, int c,
+    int align_channels) {
+  return convert_new<out_t, in_t, AlignedVector<out_t>>(
+      [&](auto& output, auto& padded_data) {
+        lnhwc_to_lnchw_5d_into(output, padded_data, input, l, n, h, w, c,
+                               align_channels);
+      });
+}
+
+// 工作区版本，参数同上，返回的引用在ws.reset()之前有效
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_chw_to_hwc_3d(const std::vector<in_t>& input, int c,
+                                          int h, int w, int align_channels,
+                                          Workspace& ws) {
+  return convert_in_workspace<out_t, in_t>(
+      ws, [&](auto& result, auto& padded_data) {
+        chw_to_hwc_3d_into(result, padded_data, input, c, h, w,
+                           align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_hwc_to_chw_3d(const std::vector<in_t>& input, int c,
+                                          int h, int w, int align_channels,
+                                          Workspace& ws) {
+  return convert_in_workspace<out_t, in_t>(
+      ws, [&](auto& output, auto& padded_data) {
+        hwc_to_chw_3d_into(output, padded_data, input, c, h, w,
+                           align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_nchw_to_nhwc_4d(const std::vector<in_t>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws) {
+  return convert_in_workspace<out_t, in_t>(
+      ws, [&](auto& result, auto& padded_data) {
+        nchw_to_nhwc_4d_into(result, padded_data, input, n, c, h, w,
+                             align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_nhwc_to_nchw_4d(const std::vector<in_t>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws) {
+  return convert_in_workspace<out_t, in_t>(
+      ws, [&](auto& output, auto& padded_data) {
+        nhwc_to_nchw_4d_into(output, padded_data, input, n, c, h, w,
+                             align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_lnchw_to_lnhwc_5d(const std::vector<in_t>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws) {
+  return convert_in_workspace<out_t, in_t>(
+      ws, [&](auto& result, auto& padded_data) {
+        lnchw_to_lnhwc_5d_into(result, padded_data, input, l, n, h, w, c,
+                               align_channels);
+      });
+}
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_lnhwc_to_lnchw_5d(const std::vector<in_t>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws) {
+  return convert_in_workspace<out_t, in_t>(
+      ws, [&](auto& output, auto& padded_data) {
+        lnhwc_to_lnchw_5d_into(output, padded_data, input, l, n, h, w, c,
+                               align_channels);
+      });
+}
+
+// float32版本，与模板版本<float, float>相同
+std::vector<float> convert_chw_to_hwc_3d(const std::vector<float>& input, int c,
+                                         int h, int w, int align_channels) {
+  return convert_chw_to_hwc_3d<float, float>(input, c, h, w, align_channels);
+}
+
+std::vector<float> convert_hwc_to_chw_3d(const std::vector<float>& input, int c,
+                                         int h, int w, int align_channels) {
+  return convert_hwc_to_chw_3d<float, float>(input, c, h, w, align_channels);
+}
+
+std::vector<float> convert_nchw_to_nhwc_4d(const std::vector<float>& input,
+                                           int n, int c, int h, int w,
+                                           int align_channels) {
+  return convert_nchw_to_nhwc_4d<float, float>(input, n, c, h, w,
+                                               align_channels);
+}
+
+std::vector<float> convert_nhwc_to_nchw_4d(const std::vector<float>& input,
+                                           int n, int c, int h, int w,
+                                           int align_channels) {
+  return convert_nhwc_to_nchw_4d<float, float>(input, n, c, h, w,
+                                               align_channels);
+}
+
+std::vector<float> convert_lnchw_to_lnhwc_5d(const std::vector<float>& input,
+                                             int l, int n, int h, int w, int c,
+                                             int align_channels) {
+  return convert_lnchw_to_lnhwc_5d<float, float>(input, l, n, h, w, c,
+                                                 align_channels);
+}
+
 std::vector<float> convert_lnhwc_to_lnchw_5d(const std::vector<float>& input,
                                              int l, int n, int h, int w, int c,
                                              int align_channels) {
-  int padding_channels = (align_channels - c % align_channels) % align_channels;
-  int total_channels = c + padding_channels;
-  int num_groups = total_channels / align_channels;
+  return convert_lnhwc_to_lnchw_5d<float, float>(input, l, n, h, w, c,
+                                                 align_channels);
+}
 
-  if (input.size() != l * n * h * w * total_channels) {
-    throw std::invalid_argument("输入数据大小与指定维度不匹配");
-  }
+std::vector<float>& convert_chw_to_hwc_3d(const std::vector<float>& input,
+                                          int c, int h, int w,
+                                          int align_channels, Workspace& ws) {
+  return convert_chw_to_hwc_3d<float, float>(input, c, h, w, align_channels,
+                                             ws);
+}
 
-  // 从分组存储格式重构为补零LNCHW格式
-  std::vector<float> padded_data(l * n * total_channels * h * w, 0.0f);
+std::vector<float>& convert_hwc_to_chw_3d(const std::vector<float>& input,
+                                          int c, int h, int w,
+                                          int align_channels, Workspace& ws) {
+  return convert_hwc_to_chw_3d<float, float>(input, c, h, w, align_channels,
+                                             ws);
+}
 
-  int input_idx = 0;
-  for (int g = 0; g < num_groups; ++g) {
-    int channel_start = g * align_channels;
+std::vector<float>& convert_nchw_to_nhwc_4d(const std::vector<float>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws) {
+  return convert_nchw_to_nhwc_4d<float, float>(input, n, c, h, w,
+                                               align_channels, ws);
+}
 
-    // 按LNHWC顺序处理输入数据
-    for (int li = 0; li < l; ++li) {
-      for (int ni = 0; ni < n; ++ni) {
-        for (int hi = 0; hi < h; ++hi) {
-          for (int wi = 0; wi < w; ++wi) {
-            for (int cg = 0; cg < align_channels; ++cg) {
-              int channel = channel_start + cg;
-              int lnchw_idx = li * n * total_channels * h * w +
-                              ni * total_channels * h * w + channel * h * w +
-                              hi * w + wi;
-              padded_data[lnchw_idx] = input[input_idx++];
-            }
-          }
-        }
-      }
-    }
-  }
+std::vector<float>& convert_nhwc_to_nchw_4d(const std::vector<float>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws) {
+  return convert_nhwc_to_nchw_4d<float, float>(input, n, c, h, w,
+                                               align_channels, ws);
+}
 
-  // 提取原始通道数据
-  std::vector<float> output(l * n * c * h * w);
-  for (int li = 0; li < l; ++li) {
-    for (int ni = 0; ni < n; ++ni) {
-      for (int ci = 0; ci < c; ++ci) {
-        for (int hi = 0; hi < h; ++hi) {
-          for (int wi = 0; wi < w; ++wi) {
-            int src_idx = li * n * total_channels * h * w +
-                          ni * total_channels * h * w + ci * h * w + hi * w +
-                          wi;
-            int dst_idx =
-                li * n * c * h * w + ni * c * h * w + ci * h * w + hi * w + wi;
-            output[dst_idx] = padded_data[src_idx];
-          }
-        }
-      }
+std::vector<float>& convert_lnchw_to_lnhwc_5d(const std::vector<float>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws) {
+  return convert_lnchw_to_lnhwc_5d<float, float>(input, l, n, h, w, c,
+                                                 align_channels, ws);
+}
+
+std::vector<float>& convert_lnhwc_to_lnchw_5d(const std::vector<float>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws) {
+  return convert_lnhwc_to_lnchw_5d<float, float>(input, l, n, h, w, c,
+                                                 align_channels, ws);
+}
+
+AlignedVector<float> convert_chw_to_hwc_3d(const AlignedVector<float>& input,
+                                           int c, int h, int w,
+                                           int align_channels) {
+  return convert_chw_to_hwc_3d<float, float>(input, c, h, w, align_channels);
+}
+
+AlignedVector<float> convert_hwc_to_chw_3d(const AlignedVector<float>& input,
+                                           int c, int h, int w,
+                                           int align_channels) {
+  return convert_hwc_to_chw_3d<float, float>(input, c, h, w, align_channels);
+}
+
+AlignedVector<float> convert_nchw_to_nhwc_4d(const AlignedVector<float>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels) {
+  return convert_nchw_to_nhwc_4d<float, float>(input, n, c, h, w,
+                                               align_channels);
+}
+
+AlignedVector<float> convert_nhwc_to_nchw_4d(const AlignedVector<float>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels) {
+  return convert_nhwc_to_nchw_4d<float, float>(input, n, c, h, w,
+                                               align_channels);
+}
+
+AlignedVector<float> convert_lnchw_to_lnhwc_5d(
+    const AlignedVector<float>& input, int l, int n, int h, int w, int c,
+    int align_channels) {
+  return convert_lnchw_to_lnhwc_5d<float, float>(input, l, n, h, w, c,
+                                                 align_channels);
+}
+
+AlignedVector<float> convert_lnhwc_to_lnchw_5d(
+    const AlignedVector<float>& input, int l, int n, int h, int w, int c,
+    int align_channels) {
+  return convert_lnhwc_to_lnchw_5d<float, float>(input, l, n, h, w, c,
+                                                 align_channels);
+}
+
+// 视图版本：按输出布局的维顺序直接从视图读取，CHW视图的C维在3/4/5维时
+// 分别为第0/1/2维（与上面的3d/4d/5d转换一致）
+std::vector<float> convert_chw_to_hwc(const GatherView<float>& input,
+                                      int align_channels) {
+  int rank = input.shape.size();
+  if (input.align_channels != 0 || rank < 3 || rank > 5) {
+    throw std::invalid_argument("需要3~5维的CHW视图");
+  }
+  if (align_channels <= 0) {
+    throw std::invalid_argument("无效的align_channels");
+  }
+  int c_axis = rank - 3;
+  std::vector<int> order;
+  for (int d = 0; d < rank; ++d) {
+    if (d != c_axis) {
+      order.push_back(d);
     }
   }
+  order.push_back(c_axis);
+  std::vector<float> output;
+  if (mem::read_view(output, input, order, c_axis, align_channels) != 0) {
+    throw std::invalid_argument("视图读取失败");
+  }
+  return output;
+}
 
+std::vector<float> convert_hwc_to_chw(const GatherView<float>& input) {
+  int rank = input.shape.size();
+  if (input.align_channels <= 0 || rank < 3 || rank > 5) {
+    throw std::invalid_argument("需要3~5维的分块HWC视图");
+  }
+  // 视图维为[..., H, W, C]，C维移到倒数第3个位置
+  std::vector<int> order;
+  for (int d = 0; d < rank - 3; ++d) {
+    order.push_back(d);
+  }
+  order.push_back(rank - 1);
+  order.push_back(rank - 3);
+  order.push_back(rank - 2);
+  std::vector<float> output;
+  if (mem::read_view(output, input, order, -1, 0) != 0) {
+    throw std::invalid_argument("视图读取失败");
+  }
   return output;
 }
 
+// 16位存储、8位量化数据和融合精度转换支持的(输出类型, 输入类型)组合，与gather_hwc相同
+#define CONVERT_INSTANTIATE(out_t, in_t)                                      \
+  template std::vector<out_t> convert_chw_to_hwc_3d<out_t, in_t>(             \
+      const std::vector<in_t>&, int, int, int, int);                          \
+  template std::vector<out_t> convert_hwc_to_chw_3d<out_t, in_t>(             \
+      const std::vector<in_t>&, int, int, int, int);                          \
+  template std::vector<out_t> convert_nchw_to_nhwc_4d<out_t, in_t>(           \
+      const std::vector<in_t>&, int, int, int, int, int);                     \
+  template std::vector<out_t> convert_nhwc_to_nchw_4d<out_t, in_t>(           \
+      const std::vector<in_t>&, int, int, int, int, int);                     \
+  template std::vector<out_t> convert_lnchw_to_lnhwc_5d<out_t, in_t>(         \
+      const std::vector<in_t>&, int, int, int, int, int, int);                \
+  template std::vector<out_t> convert_lnhwc_to_lnchw_5d<out_t, in_t>(         \
+      const std::vector<in_t>&, int, int, int, int, int, int);                \
+  template AlignedVector<out_t> convert_chw_to_hwc_3d<out_t, in_t>(           \
+      const AlignedVector<in_t>&, int, int, int, int);                        \
+  template AlignedVector<out_t> convert_hwc_to_chw_3d<out_t, in_t>(           \
+      const AlignedVector<in_t>&, int, int, int, int);                        \
+  template AlignedVector<out_t> convert_nchw_to_nhwc_4d<out_t, in_t>(         \
+      const AlignedVector<in_t>&, int, int, int, int, int);                   \
+  template AlignedVector<out_t> convert_nhwc_to_nchw_4d<out_t, in_t>(         \
+      const AlignedVector<in_t>&, int, int, int, int, int);                   \
+  template AlignedVector<out_t> convert_lnchw_to_lnhwc_5d<out_t, in_t>(       \
+      const AlignedVector<in_t>&, int, int, int, int, int, int);              \
+  template AlignedVector<out_t> convert_lnhwc_to_lnchw_5d<out_t, in_t>(       \
+      const AlignedVector<in_t>&, int, int, int, int, int, int);              \
+  template std::vector<out_t>& convert_chw_to_hwc_3d<out_t, in_t>(            \
+      const std::vector<in_t>&, int, int, int, int, Workspace&);              \
+  template std::vector<out_t>& convert_hwc_to_chw_3d<out_t, in_t>(            \
+      const std::vector<in_t>&, int, int, int, int, Workspace&);              \
+  template std::vector<out_t>& convert_nchw_to_nhwc_4d<out_t, in_t>(          \
+      const std::vector<in_t>&, int, int, int, int, int, Workspace&);         \
+  template std::vector<out_t>& convert_nhwc_to_nchw_4d<out_t, in_t>(          \
+      const std::vector<in_t>&, int, int, int, int, int, Workspace&);         \
+  template std::vector<out_t>& convert_lnchw_to_lnhwc_5d<out_t, in_t>(        \
+      const std::vector<in_t>&, int, int, int, int, int, int, Workspace&);    \
+  template std::vector<out_t>& convert_lnhwc_to_lnchw_5d<out_t, in_t>(        \
+      const std::vector<in_t>&, int, int, int, int, int, int, Workspace&);
+
+CONVERT_INSTANTIATE(float16, float16)
+CONVERT_INSTANTIATE(bfloat16, bfloat16)
+CONVERT_INSTANTIATE(float, float16)
+CONVERT_INSTANTIATE(float16, float)
+CONVERT_INSTANTIATE(float, bfloat16)
+CONVERT_INSTANTIATE(bfloat16, float)
+CONVERT_INSTANTIATE(std::int8_t, std::int8_t)
+CONVERT_INSTANTIATE(std::uint8_t, std::uint8_t)
+#undef CONVERT_INSTANTIATE
+
 /**
  * 将数据直接保存到单个文件
  * @param data 要保存的数据
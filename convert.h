@@ -3,6 +3,11 @@
 #include <string>
 #include <vector>
 
+#include "elem_type.h"
+#include "aligned_buffer.h"
+#include "gather_view.h"
+#include "workspace.h"
+
 /**
  * 3维CHW到HWC转换，按指定通道数对齐
  * @param input CHW格式的输入数据
@@ -85,6 +90,178 @@ std::vector<float> convert_lnhwc_to_lnchw_5d(const std::vector<float>& input,
                                              int l, int n, int h, int w, int c,
                                              int align_channels = 64);
 
+/**
+ * 以上转换的16位存储（float16/bfloat16）版本：out_t与in_t相同时按位搬运，
+ * 不同时在写出时转换精度（float与float16/bfloat16之间），参数同float32版本。
+ * int8_t/uint8_t量化数据只做同类型转换，布局变化不影响按通道的量化参数
+ */
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_chw_to_hwc_3d(const std::vector<in_t>& input, int c,
+                                         int h, int w, int align_channels = 64);
+
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_hwc_to_chw_3d(const std::vector<in_t>& input, int c,
+                                         int h, int w, int align_channels = 64);
+
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_nchw_to_nhwc_4d(const std::vector<in_t>& input,
+                                           int n, int c, int h, int w,
+                                           int align_channels = 64);
+
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_nhwc_to_nchw_4d(const std::vector<in_t>& input,
+                                           int n, int c, int h, int w,
+                                           int align_channels = 64);
+
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_lnchw_to_lnhwc_5d(const std::vector<in_t>& input,
+                                             int l, int n, int h, int w, int c,
+                                             int align_channels = 64);
+
+template <typename out_t, typename in_t>
+std::vector<out_t> convert_lnhwc_to_lnchw_5d(const std::vector<in_t>& input,
+                                             int l, int n, int h, int w, int c,
+                                             int align_channels = 64);
+
+/**
+ * 以上转换的对齐缓冲区版本（见aligned_buffer.h）：输入和输出都是AlignedVector，
+ * 按缓存行和向量寄存器对齐，大张量落在巨页上。参数同普通版本
+ */
+AlignedVector<float> convert_chw_to_hwc_3d(const AlignedVector<float>& input,
+                                           int c, int h, int w,
+                                           int align_channels = 64);
+
+AlignedVector<float> convert_hwc_to_chw_3d(const AlignedVector<float>& input,
+                                           int c, int h, int w,
+                                           int align_channels = 64);
+
+AlignedVector<float> convert_nchw_to_nhwc_4d(const AlignedVector<float>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels = 64);
+
+AlignedVector<float> convert_nhwc_to_nchw_4d(const AlignedVector<float>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels = 64);
+
+AlignedVector<float> convert_lnchw_to_lnhwc_5d(
+    const AlignedVector<float>& input, int l, int n, int h, int w, int c,
+    int align_channels = 64);
+
+AlignedVector<float> convert_lnhwc_to_lnchw_5d(
+    const AlignedVector<float>& input, int l, int n, int h, int w, int c,
+    int align_channels = 64);
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_chw_to_hwc_3d(const AlignedVector<in_t>& input,
+                                           int c, int h, int w,
+                                           int align_channels = 64);
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_hwc_to_chw_3d(const AlignedVector<in_t>& input,
+                                           int c, int h, int w,
+                                           int align_channels = 64);
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_nchw_to_nhwc_4d(const AlignedVector<in_t>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels = 64);
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_nhwc_to_nchw_4d(const AlignedVector<in_t>& input,
+                                             int n, int c, int h, int w,
+                                             int align_channels = 64);
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_lnchw_to_lnhwc_5d(
+    const AlignedVector<in_t>& input, int l, int n, int h, int w, int c,
+    int align_channels = 64);
+
+template <typename out_t, typename in_t>
+AlignedVector<out_t> convert_lnhwc_to_lnchw_5d(
+    const AlignedVector<in_t>& input, int l, int n, int h, int w, int c,
+    int align_channels = 64);
+
+/**
+ * 以上转换的工作区版本（见workspace.h）：输出和补零临时张量都从ws取用，
+ * 临时张量在返回前归还，输出在调用者ws.reset()之前有效。
+ * 每帧按同样的顺序调用时，第一帧之后不再分配内存。参数同普通版本
+ */
+std::vector<float>& convert_chw_to_hwc_3d(const std::vector<float>& input,
+                                          int c, int h, int w,
+                                          int align_channels, Workspace& ws);
+
+std::vector<float>& convert_hwc_to_chw_3d(const std::vector<float>& input,
+                                          int c, int h, int w,
+                                          int align_channels, Workspace& ws);
+
+std::vector<float>& convert_nchw_to_nhwc_4d(const std::vector<float>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws);
+
+std::vector<float>& convert_nhwc_to_nchw_4d(const std::vector<float>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws);
+
+std::vector<float>& convert_lnchw_to_lnhwc_5d(const std::vector<float>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws);
+
+std::vector<float>& convert_lnhwc_to_lnchw_5d(const std::vector<float>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws);
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_chw_to_hwc_3d(const std::vector<in_t>& input, int c,
+                                          int h, int w, int align_channels,
+                                          Workspace& ws);
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_hwc_to_chw_3d(const std::vector<in_t>& input, int c,
+                                          int h, int w, int align_channels,
+                                          Workspace& ws);
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_nchw_to_nhwc_4d(const std::vector<in_t>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws);
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_nhwc_to_nchw_4d(const std::vector<in_t>& input,
+                                            int n, int c, int h, int w,
+                                            int align_channels,
+                                            Workspace& ws);
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_lnchw_to_lnhwc_5d(const std::vector<in_t>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws);
+
+template <typename out_t, typename in_t>
+std::vector<out_t>& convert_lnhwc_to_lnchw_5d(const std::vector<in_t>& input,
+                                              int l, int n, int h, int w,
+                                              int c, int align_channels,
+                                              Workspace& ws);
+
+/**
+ * 直接读取gather视图完成布局转换，不先写出gather结果。
+ * CHW视图按维数对应3维CHW、4维NCHW、5维LNCHW，转换为按align_channels
+ * 分组存储的HWC；分块HWC视图转换回CHW，通道数取视图形状中的C。
+ * 视图类型或维数不支持时抛出std::invalid_argument
+ * @param input gather视图（见gather_view.h）
+ * @param align_channels 对齐的通道数（默认64）
+ * @return 转换后的数据
+ */
+std::vector<float> convert_chw_to_hwc(const GatherView<float>& input,
+                                      int align_channels = 64);
+
+std::vector<float> convert_hwc_to_chw(const GatherView<float>& input);
+
 /**
  * 将数据直接保存到单个文件
  * @param data 要保存的数据
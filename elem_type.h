@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 16位存储的元素类型，只保存位模式，不参与计算：
+// float16为IEEE半精度，bfloat16为float32的高16位。
+// gather/convert对它们只做搬运，输出类型与输入不同时在写出时顺带转换精度
+struct float16 {
+  std::uint16_t bits;
+};
+
+struct bfloat16 {
+  std::uint16_t bits;
+};
+
+// float32 -> float16，就近舍入到偶数，超出范围变为inf，NaN保持为NaN
+inline std::uint16_t float_to_half_bits(float f) {
+  std::uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  std::uint32_t sign = (x >> 16) & 0x8000;
+  std::uint32_t abs = x & 0x7fffffff;
+  if (abs >= 0x7f800000) {
+    return sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0);
+  }
+  if (abs >= 0x477ff000) {  // >= 65520，舍入后溢出
+    return sign | 0x7c00;
+  }
+  if (abs < 0x38800000) {
+    // 结果为半精度非规格化数：加0.5f后尾数低位正好是以2^-24为单位的舍入结果
+    float a;
+    std::memcpy(&a, &abs, sizeof(a));
+    a += 0.5f;
+    std::uint32_t r;
+    std::memcpy(&r, &a, sizeof(r));
+    return sign | (r - 0x3f000000);
+  }
+  // 规格化数：指数偏置从127改为15，尾数从23位舍入到10位
+  abs += 0xc8000fff + ((abs >> 13) & 1);
+  return sign | (abs >> 13);
+}
+
+inline float half_bits_to_float(std::uint16_t h) {
+  std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000) << 16;
+  std::uint32_t exp = (h >> 10) & 0x1f;
+  std::uint32_t mant = h & 0x3ff;
+  std::uint32_t x;
+  if (exp == 0x1f) {
+    x = sign | 0x7f800000 | (mant << 13);
+  } else if (exp != 0) {
+    x = sign | ((exp + 112) << 23) | (mant << 13);
+  } else {
+    // 非规格化数（含0）：mant * 2^-24
+    float f = mant * (1.0f / 16777216.0f);
+    std::memcpy(&x, &f, sizeof(x));
+    x |= sign;
+  }
+  float f;
+  std::memcpy(&f, &x, sizeof(f));
+  return f;
+}
+
+// float32 -> bfloat16，就近舍入到偶数
+inline std::uint16_t float_to_bfloat16_bits(float f) {
+  std::uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  if ((x & 0x7fffffff) > 0x7f800000) {
+    return (x >> 16) | 0x40;
+  }
+  x += 0x7fff + ((x >> 16) & 1);
+  return x >> 16;
+}
+
+inline float bfloat16_bits_to_float(std::uint16_t h) {
+  std::uint32_t x = static_cast<std::uint32_t>(h) << 16;
+  float f;
+  std::memcpy(&f, &x, sizeof(f));
+  return f;
+}
+
+// 元素类型之间的转换，同类型时原样返回
+template <typename out_t, typename in_t>
+struct ElemCast;
+
+template <typename T>
+struct ElemCast<T, T> {
+  static T cast(T x) { return x; }
+};
+
+template <>
+struct ElemCast<float, float16> {
+  static float cast(float16 x) { return half_bits_to_float(x.bits); }
+};
+
+template <>
+struct ElemCast<float16, float> {
+  static float16 cast(float x) { return float16{float_to_half_bits(x)}; }
+};
+
+template <>
+struct ElemCast<float, bfloat16> {
+  static float cast(bfloat16 x) { return bfloat16_bits_to_float(x.bits); }
+};
+
+template <>
+struct ElemCast<bfloat16, float> {
+  static bfloat16 cast(float x) {
+    return bfloat16{float_to_bfloat16_bits(x)};
+  }
+};
+
+template <typename out_t, typename in_t>
+inline out_t elem_cast(in_t x) {
+  return ElemCast<out_t, in_t>::cast(x);
+}
+
+// 标量路径的连续拷贝：同类型时memcpy，否则逐个转换
+template <typename out_t, typename in_t>
+struct ElemCopy {
+  static void copy(out_t* dst, const in_t* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = elem_cast<out_t>(src[i]);
+    }
+  }
+};
+
+template <typename T>
+struct ElemCopy<T, T> {
+  static void copy(T* dst, const T* src, std::size_t n) {
+    std::memcpy(dst, src, n * sizeof(T));
+  }
+};
+
+template <typename out_t, typename in_t>
+inline void copy_elems(out_t* dst, const in_t* src, std::size_t n) {
+  ElemCopy<out_t, in_t>::copy(dst, src, n);
+}
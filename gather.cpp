@@ -1,13 +1,117 @@
+#include "gather.h"
+
 #include <riscv_vector.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <vector>
 
+#include "gather_tune.h"
+#include "rvv_elem.h"
+#include "rvv_tune.h"
+#include "tensor_util.h"
+
 namespace {
-int gather_hwc_batch_rvv(std::vector<float> &output,
-                         const std::vector<float> &input,
+// W轴gather（3/4/5维共用）：每个索引只搬运一个像素，原实现在(cb, n, d, h)的多层
+// 循环里逐像素计算偏移。这里把W之外的维展平为一个外层循环、行偏移增量更新，
+// 索引先统一检查并把连续的索引合并为多像素的连续段；同类型搬运的小像素、
+// 索引大多不连续时改为按预先算好的整行字节偏移表做索引加载
+template <typename out_t, typename in_t, typename index_t,
+          typename Copy = RvvCopy<out_t, in_t>, typename OutVec,
+          typename InVec>
+int gather_hwc_width_rvv(OutVec &output,
+                         const InVec &input,
+                         const std::vector<int> &in_shape_hwc,
+                         const std::vector<int> &indices,
+                         int align_channels) {
+  using Gather = RvvGather<out_t, in_t>;
+  const int rank = in_shape_hwc.size();
+  const index_t A = align_channels;
+  const index_t W = in_shape_hwc[rank - 2];
+  const index_t out_W = indices.size();
+  index_t rows = padded_channels(in_shape_hwc[rank - 1], A) / A;
+  for (int d = 0; d < rank - 2; ++d) {
+    rows *= in_shape_hwc[d];
+  }
+
+  // 行内的搬运段（单位为元素），连续的索引合并为一段
+  struct PixelRun {
+    index_t src;
+    index_t dst;
+    index_t len;
+  };
+  std::vector<PixelRun> runs;
+  std::vector<index_t> w_src(out_W);
+  for (index_t i = 0; i < out_W; ++i) {
+    index_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
+    if (w_idx < 0 || w_idx >= W) {
+      std::cerr << "索引越界：" << indices[i] << std::endl;
+      return -1;
+    }
+    w_src[i] = w_idx * A;
+    if (!runs.empty() && runs.back().src + runs.back().len == w_src[i]) {
+      runs.back().len += A;
+    } else {
+      runs.push_back({w_src[i], i * A, A});
+    }
+  }
+  const index_t in_row = W * A;
+  const index_t out_row = out_W * A;
+  output.resize(rows * out_row, out_t());
+
+  const in_t *in = input.data();
+  out_t *out = output.data();
+  // 像素不超过rvv_indexed_max_pixel（随VLEN变化）且索引大多不连续时走索引加载
+  bool indexed = Gather::supported &&
+                 static_cast<std::size_t>(A) <= rvv_indexed_max_pixel() &&
+                 2 * static_cast<index_t>(runs.size()) > out_W &&
+                 fits_int32(in_row * sizeof(in_t));
+  if (indexed) {
+    std::vector<std::uint32_t> offsets(out_row);
+    for (index_t j = 0; j < out_row; ++j) {
+      offsets[j] = (w_src[j / A] + j % A) * sizeof(in_t);
+    }
+    for (index_t r = 0; r < rows; ++r, in += in_row, out += out_row) {
+      std::size_t n = out_row;
+      const std::uint32_t *off = offsets.data();
+      out_t *dst = out;
+      while (n > 0) {
+        std::size_t vl = Gather::setvl(n);
+        Gather::gather(dst, in, off, vl);
+        off += vl;
+        dst += vl;
+        n -= vl;
+      }
+    }
+    return 0;
+  }
+  for (index_t r = 0; r < rows; ++r, in += in_row, out += out_row) {
+    for (const PixelRun &run : runs) {
+      const in_t *src = in + run.src;
+      out_t *dst = out + run.dst;
+      std::size_t n = run.len;
+      while (n > 0) {
+        std::size_t vl = Copy::setvl(n);
+        Copy::copy(dst, src, vl);
+        src += vl;
+        dst += vl;
+        n -= vl;
+      }
+    }
+  }
+  return 0;
+}
+
+// index_t为偏移的计算类型：输入输出元素数都不超过INT32_MAX时用int32_t（快速路径），
+// 否则用int64_t，避免大张量（如5维视频张量）的偏移溢出
+template <typename out_t, typename in_t, typename index_t,
+          typename Copy = RvvCopy<out_t, in_t>, typename OutVec,
+          typename InVec>
+int gather_hwc_batch_rvv(OutVec &output,
+                         const InVec &input,
                          const std::vector<int> &in_shape_nhwc,
                          const std::vector<int> &indices, int axis_nchw,
                          int align_channels) {
@@ -18,52 +122,40 @@ int gather_hwc_batch_rvv(std::vector<float> &output,
   }
 
   // 从NHWC形状提取维度
-  auto N = in_shape_nhwc[0];
-  auto H = in_shape_nhwc[1];
-  auto W = in_shape_nhwc[2];
-  auto C = in_shape_nhwc[3];
-
-  // 将NCHW格式的axis转换为NHWC格式的axis
-  std::size_t axis_nhwc;
-  if (axis_nchw == 0) {
-    axis_nhwc = 0;
-  } else if (axis_nchw == 1) {
-    axis_nhwc = 3;
-  } else if (axis_nchw == 2) {
-    axis_nhwc = 1;
-  } else { // axis_nchw == 3
-    axis_nhwc = 2;
-  }
+  const index_t N = in_shape_nhwc[0];
+  const index_t H = in_shape_nhwc[1];
+  const index_t W = in_shape_nhwc[2];
+  const index_t C = in_shape_nhwc[3];
 
-  // 计算通道块数
-  auto num_channel_blocks = (C + align_channels - 1) / align_channels;
+  // 计算通道块数和填充后的通道数
+  const index_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  const index_t C_padded = num_channel_blocks * align_channels;
 
   if (axis_nchw == 0) {
     // 在N维度上gather (axis_nhwc=0)
-    auto out_N = indices.size();
-    output.resize(out_N * H * W * C, 0.0f);
+    const index_t out_N = indices.size();
+    output.resize(out_N * H * W * C_padded, out_t());
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_N; ++i) {
       // 处理负索引
-      std::size_t n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
-      if (n_idx >= N) {
+      index_t n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
+      if (n_idx < 0 || n_idx >= N) {
         std::cerr << "索引越界" << std::endl;
         return -1;
       }
 
       // 对每个通道块处理
-      for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-        auto input_start = c_block * (N * H * W * align_channels) +
-                           n_idx * (H * W * align_channels);
-        auto output_start = c_block * (out_N * H * W * align_channels) +
-                            i * (H * W * align_channels);
-        auto n = H * W * align_channels;
+      for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+        index_t input_start = c_block * (N * H * W * align_channels) +
+                              n_idx * (H * W * align_channels);
+        index_t output_start = c_block * (out_N * H * W * align_channels) +
+                               i * (H * W * align_channels);
+        std::size_t n = H * W * align_channels;
         while (n > 0) {
           // 加载vl个元素到向量寄存器
-          auto vl = vsetvl_e32m8(n);
-          auto v_in = vle32_v_f32m8(input.data() + input_start, vl);
-          // 输出到output
-          vse32_v_f32m8(output.data() + output_start, v_in, vl);
+          std::size_t vl = Copy::setvl(n);
+          Copy::copy(output.data() + output_start, input.data() + input_start,
+                     vl);
           // 更新偏移
           input_start += vl;
           output_start += vl;
@@ -73,39 +165,38 @@ int gather_hwc_batch_rvv(std::vector<float> &output,
     }
   } else if (axis_nchw == 1) {
     // 在C维度上gather (axis_nhwc=3)
-    auto out_C = indices.size();
-    auto out_num_channel_blocks = (out_C + align_channels - 1) / align_channels;
-    auto C_padded_out = out_num_channel_blocks * align_channels;
-    output.resize(N * H * W * C_padded_out, 0.0f);
+    const index_t out_C = indices.size();
+    const index_t out_num_channel_blocks =
+        (out_C + align_channels - 1) / align_channels;
+    const index_t C_padded_out = out_num_channel_blocks * align_channels;
+    output.resize(N * H * W * C_padded_out, out_t());
 
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_C; ++i) {
       // 处理负索引
-      std::size_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
-      if (c_idx >= C) {
+      index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+      if (c_idx < 0 || c_idx >= C) {
         std::cerr << "索引越界" << std::endl;
         return -1;
       }
 
       // 计算原始通道所在的块索引和块内偏移
-      auto c_block = c_idx / align_channels;
-      auto c_offset = c_idx % align_channels;
+      index_t c_block = c_idx / align_channels;
+      index_t c_offset = c_idx % align_channels;
 
       // 计算输出通道的块索引和块内偏移
-      auto out_c_block = i / align_channels;
-      auto out_c_offset = i % align_channels;
+      index_t out_c_block = i / align_channels;
+      index_t out_c_offset = i % align_channels;
 
-      auto input_start = c_block * (N * H * W * align_channels) + c_offset;
-      auto output_start =
+      index_t input_start = c_block * (N * H * W * align_channels) + c_offset;
+      index_t output_start =
           out_c_block * (N * H * W * align_channels) + out_c_offset;
 
-      // in bytes
-      auto stride = align_channels * sizeof(float);
-      auto n = N * H * W;
+      std::size_t n = N * H * W;
       while (n > 0) {
-        std::size_t vl = vsetvl_e32m8(n);
-        auto v_in = vlse32_v_f32m8(input.data() + input_start, stride, vl);
-        vsse32_v_f32m8(output.data() + output_start, stride, v_in, vl);
+        std::size_t vl = Copy::setvl(n);
+        Copy::copy_strided(output.data() + output_start,
+                           input.data() + input_start, align_channels, vl);
         input_start += vl * align_channels;
         output_start += vl * align_channels;
         n -= vl;
@@ -113,82 +204,51 @@ int gather_hwc_batch_rvv(std::vector<float> &output,
     }
   } else if (axis_nchw == 2) {
     // 在H维度上gather (axis_nhwc=1)
-    auto out_H = indices.size();
-    output.resize(N * out_H * W * C, 0.0f);
-
-    for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-      for (std::size_t n = 0; n < N; ++n) {
-        for (std::size_t i = 0; i < indices.size(); ++i) {
-          std::size_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
-          if (h_idx >= H) {
+    const index_t out_H = indices.size();
+    output.resize(N * out_H * W * C_padded, out_t());
+
+    for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+      for (index_t n = 0; n < N; ++n) {
+        for (index_t i = 0; i < out_H; ++i) {
+          index_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
+          if (h_idx < 0 || h_idx >= H) {
             std::cerr << "索引越界" << std::endl;
             return -1;
           }
-          auto input_start = c_block * (N * H * W * align_channels) +
-                             n * (H * W * align_channels) +
-                             h_idx * (W * align_channels);
-          auto output_start = c_block * (N * out_H * W * align_channels) +
-                              n * (out_H * W * align_channels) +
-                              i * (W * align_channels);
-
-          auto n = W * align_channels;
-          while (n > 0) {
-            auto vl = vsetvl_e32m8(n);
-            auto v_in = vle32_v_f32m8(input.data() + input_start, vl);
-            // 输出到output
-            vse32_v_f32m8(output.data() + output_start, v_in, vl);
+          index_t input_start = c_block * (N * H * W * align_channels) +
+                                n * (H * W * align_channels) +
+                                h_idx * (W * align_channels);
+          index_t output_start = c_block * (N * out_H * W * align_channels) +
+                                 n * (out_H * W * align_channels) +
+                                 i * (W * align_channels);
+
+          std::size_t remain = W * align_channels;
+          while (remain > 0) {
+            std::size_t vl = Copy::setvl(remain);
+            Copy::copy(output.data() + output_start, input.data() + input_start,
+                       vl);
             input_start += vl;
             output_start += vl;
-            n -= vl;
+            remain -= vl;
           }
         }
       }
     }
   } else if (axis_nchw == 3) {
     // 在W维度上gather (axis_nhwc=2)
-    auto out_W = indices.size();
-    output.resize(N * H * out_W * C, 0.0f);
-
-    for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-      for (std::size_t n = 0; n < N; ++n) {
-        for (std::size_t h = 0; h < H; ++h) {
-          for (std::size_t i = 0; i < indices.size(); ++i) {
-            std::size_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
-            if (w_idx >= W) {
-              std::cerr << "索引越界" << std::endl;
-              return -1;
-            }
-            auto input_start = c_block * (N * H * W * align_channels) +
-                               n * (H * W * align_channels) +
-                               h * (W * align_channels) +
-                               w_idx * align_channels;
-            auto output_start = c_block * (N * H * out_W * align_channels) +
-                                n * (H * out_W * align_channels) +
-                                h * (out_W * align_channels) +
-                                i * align_channels;
-
-            auto n = align_channels;
-            while (n > 0) {
-              auto vl = vsetvl_e32m8(n);
-              auto v_in = vle32_v_f32m8(input.data() + input_start, vl);
-              // 输出到output
-              vse32_v_f32m8(output.data() + output_start, v_in, vl);
-              input_start += vl;
-              output_start += vl;
-              n -= vl;
-            }
-          }
-        }
-      }
-    }
+    return gather_hwc_width_rvv<out_t, in_t, index_t, Copy>(
+        output, input, in_shape_nhwc, indices, align_channels);
   }
 
   return 0;
 }
 
 // NDHWC <-> NCDHW : RVV gather 5-D
+template <typename out_t, typename in_t, typename index_t,
+          typename Copy = RvvCopy<out_t, in_t>, typename OutVec,
+          typename InVec>
 int gather_hwc_batch5d_rvv(
-    std::vector<float> &output, const std::vector<float> &input,
+    OutVec &output, const InVec &input,
     const std::vector<int> &in_shape_ndhwc, // {N,D,H,W,C}
     const std::vector<int> &indices,
     int axis_ncdhw, // 以 NCDHW 编号
@@ -199,39 +259,39 @@ int gather_hwc_batch5d_rvv(
   }
 
   /* ---------- 解析 NDHWC 形状 ---------- */
-  const int N = in_shape_ndhwc[0];
-  const int D = in_shape_ndhwc[1];
-  const int H = in_shape_ndhwc[2];
-  const int W = in_shape_ndhwc[3];
-  const int C = in_shape_ndhwc[4];
+  const index_t N = in_shape_ndhwc[0];
+  const index_t D = in_shape_ndhwc[1];
+  const index_t H = in_shape_ndhwc[2];
+  const index_t W = in_shape_ndhwc[3];
+  const index_t C = in_shape_ndhwc[4];
 
-  const int num_c_blocks = (C + align_channels - 1) / align_channels;
+  const index_t num_c_blocks = (C + align_channels - 1) / align_channels;
+  const index_t C_pad = num_c_blocks * align_channels;
 
   /* ================= 按轴处理 ================= */
 
   /* -------- axis = N (batch) -------- */
   if (axis_ncdhw == 0) {
-    const int outN = indices.size();
-    output.resize(outN * D * H * W * C, 0.f);
+    const index_t outN = indices.size();
+    output.resize(outN * D * H * W * C_pad, out_t());
 
-    for (int i = 0; i < outN; ++i) {
-      int n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
+    for (index_t i = 0; i < outN; ++i) {
+      index_t n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
       if (n_idx < 0 || n_idx >= N) {
         std::cerr << "索引越界\n";
         return -1;
       }
 
-      for (int cb = 0; cb < num_c_blocks; ++cb) {
-        int in_off = cb * (N * D * H * W * align_channels) +
-                     n_idx * (D * H * W * align_channels);
-        int out_off = cb * (outN * D * H * W * align_channels) +
-                      i * (D * H * W * align_channels);
+      for (index_t cb = 0; cb < num_c_blocks; ++cb) {
+        index_t in_off = cb * (N * D * H * W * align_channels) +
+                         n_idx * (D * H * W * align_channels);
+        index_t out_off = cb * (outN * D * H * W * align_channels) +
+                          i * (D * H * W * align_channels);
 
-        int n = D * H * W * align_channels;
+        std::size_t n = D * H * W * align_channels;
         while (n > 0) {
-          int vl = vsetvl_e32m8(n);
-          auto v = vle32_v_f32m8(input.data() + in_off, vl);
-          vse32_v_f32m8(output.data() + out_off, v, vl);
+          std::size_t vl = Copy::setvl(n);
+          Copy::copy(output.data() + out_off, input.data() + in_off, vl);
           in_off += vl;
           out_off += vl;
           n -= vl;
@@ -242,33 +302,33 @@ int gather_hwc_batch5d_rvv(
 
   /* -------- axis = C (channel) -------- */
   else if (axis_ncdhw == 1) {
-    const int outC = indices.size();
-    const int out_c_blocks = (outC + align_channels - 1) / align_channels;
-    const int C_pad_out = out_c_blocks * align_channels;
-    output.resize(N * D * H * W * C_pad_out, 0.f);
+    const index_t outC = indices.size();
+    const index_t out_c_blocks = (outC + align_channels - 1) / align_channels;
+    const index_t C_pad_out = out_c_blocks * align_channels;
+    output.resize(N * D * H * W * C_pad_out, out_t());
 
-    for (int i = 0; i < outC; ++i) {
-      int c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+    for (index_t i = 0; i < outC; ++i) {
+      index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
       if (c_idx < 0 || c_idx >= C) {
         std::cerr << "索引越界\n";
         return -1;
       }
 
-      int in_blk = c_idx / align_channels;
-      int in_offC = c_idx % align_channels;
-      int out_blk = i / align_channels;
-      int out_offC = i % align_channels;
+      index_t in_blk = c_idx / align_channels;
+      index_t in_offC = c_idx % align_channels;
+      index_t out_blk = i / align_channels;
+      index_t out_offC = i % align_channels;
 
-      int stride = align_channels * sizeof(float);
 
-      int input_base = in_blk * (N * D * H * W * align_channels) + in_offC;
-      int output_base = out_blk * (N * D * H * W * align_channels) + out_offC;
+      index_t input_base = in_blk * (N * D * H * W * align_channels) + in_offC;
+      index_t output_base =
+          out_blk * (N * D * H * W * align_channels) + out_offC;
 
-      int n_elems = N * D * H * W;
+      std::size_t n_elems = N * D * H * W;
       while (n_elems > 0) {
-        int vl = vsetvl_e32m8(n_elems);
-        auto v = vlse32_v_f32m8(input.data() + input_base, stride, vl);
-        vsse32_v_f32m8(output.data() + output_base, stride, v, vl);
+        std::size_t vl = Copy::setvl(n_elems);
+        Copy::copy_strided(output.data() + output_base,
+                           input.data() + input_base, align_channels, vl);
         input_base += vl * align_channels;
         output_base += vl * align_channels;
         n_elems -= vl;
@@ -278,30 +338,29 @@ int gather_hwc_batch5d_rvv(
 
   /* -------- axis = D (depth) -------- */
   else if (axis_ncdhw == 2) {
-    const int outD = indices.size();
-    output.resize(N * outD * H * W * C, 0.f);
+    const index_t outD = indices.size();
+    output.resize(N * outD * H * W * C_pad, out_t());
 
-    for (int cb = 0; cb < num_c_blocks; ++cb)
-      for (int n = 0; n < N; ++n)
-        for (int i = 0; i < outD; ++i) {
-          int d_idx = indices[i] >= 0 ? indices[i] : indices[i] + D;
+    for (index_t cb = 0; cb < num_c_blocks; ++cb)
+      for (index_t n = 0; n < N; ++n)
+        for (index_t i = 0; i < outD; ++i) {
+          index_t d_idx = indices[i] >= 0 ? indices[i] : indices[i] + D;
           if (d_idx < 0 || d_idx >= D) {
             std::cerr << "索引越界\n";
             return -1;
           }
 
-          int in_off = cb * (N * D * H * W * align_channels) +
-                       n * (D * H * W * align_channels) +
-                       d_idx * (H * W * align_channels);
-          int out_off = cb * (N * outD * H * W * align_channels) +
-                        n * (outD * H * W * align_channels) +
-                        i * (H * W * align_channels);
+          index_t in_off = cb * (N * D * H * W * align_channels) +
+                           n * (D * H * W * align_channels) +
+                           d_idx * (H * W * align_channels);
+          index_t out_off = cb * (N * outD * H * W * align_channels) +
+                            n * (outD * H * W * align_channels) +
+                            i * (H * W * align_channels);
 
-          int n_elem = H * W * align_channels;
+          std::size_t n_elem = H * W * align_channels;
           while (n_elem > 0) {
-            int vl = vsetvl_e32m8(n_elem);
-            auto v = vle32_v_f32m8(input.data() + in_off, vl);
-            vse32_v_f32m8(output.data() + out_off, v, vl);
+            std::size_t vl = Copy::setvl(n_elem);
+            Copy::copy(output.data() + out_off, input.data() + in_off, vl);
             in_off += vl;
             out_off += vl;
             n_elem -= vl;
@@ -311,34 +370,33 @@ int gather_hwc_batch5d_rvv(
 
   /* -------- axis = H (height) -------- */
   else if (axis_ncdhw == 3) {
-    const int outH = indices.size();
-    output.resize(N * D * outH * W * C, 0.f);
-
-    for (int cb = 0; cb < num_c_blocks; ++cb)
-      for (int n = 0; n < N; ++n)
-        for (int d = 0; d < D; ++d)
-          for (int i = 0; i < outH; ++i) {
-            int h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
+    const index_t outH = indices.size();
+    output.resize(N * D * outH * W * C_pad, out_t());
+
+    for (index_t cb = 0; cb < num_c_blocks; ++cb)
+      for (index_t n = 0; n < N; ++n)
+        for (index_t d = 0; d < D; ++d)
+          for (index_t i = 0; i < outH; ++i) {
+            index_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
             if (h_idx < 0 || h_idx >= H) {
               std::cerr << "索引越界\n";
               return -1;
             }
 
-            int in_off = cb * (N * D * H * W * align_channels) +
-                         n * (D * H * W * align_channels) +
-                         d * (H * W * align_channels) +
-                         h_idx * (W * align_channels);
+            index_t in_off = cb * (N * D * H * W * align_channels) +
+                             n * (D * H * W * align_channels) +
+                             d * (H * W * align_channels) +
+                             h_idx * (W * align_channels);
 
-            int out_off = cb * (N * D * outH * W * align_channels) +
-                          n * (D * outH * W * align_channels) +
-                          d * (outH * W * align_channels) +
-                          i * (W * align_channels);
+            index_t out_off = cb * (N * D * outH * W * align_channels) +
+                              n * (D * outH * W * align_channels) +
+                              d * (outH * W * align_channels) +
+                              i * (W * align_channels);
 
-            int n_elem = W * align_channels;
+            std::size_t n_elem = W * align_channels;
             while (n_elem > 0) {
-              int vl = vsetvl_e32m8(n_elem);
-              auto v = vle32_v_f32m8(input.data() + in_off, vl);
-              vse32_v_f32m8(output.data() + out_off, v, vl);
+              std::size_t vl = Copy::setvl(n_elem);
+              Copy::copy(output.data() + out_off, input.data() + in_off, vl);
               in_off += vl;
               out_off += vl;
               n_elem -= vl;
@@ -349,50 +407,125 @@ int gather_hwc_batch5d_rvv(
   /* -------- axis = W (width) -------- */
   else /* axis_ncdhw == 4 */
   {
-    const int outW = indices.size();
-    output.resize(N * D * H * outW * C, 0.f);
-
-    for (int cb = 0; cb < num_c_blocks; ++cb)
-      for (int n = 0; n < N; ++n)
-        for (int d = 0; d < D; ++d)
-          for (int h = 0; h < H; ++h)
-            for (int i = 0; i < outW; ++i) {
-              int w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
-              if (w_idx < 0 || w_idx >= W) {
-                std::cerr << "索引越界\n";
-                return -1;
-              }
+    return gather_hwc_width_rvv<out_t, in_t, index_t, Copy>(
+        output, input, in_shape_ndhwc, indices, align_channels);
+  }
 
-              int in_off = cb * (N * D * H * W * align_channels) +
-                           n * (D * H * W * align_channels) +
-                           d * (H * W * align_channels) +
-                           h * (W * align_channels) + w_idx * align_channels;
-
-              int out_off = cb * (N * D * H * outW * align_channels) +
-                            n * (D * H * outW * align_channels) +
-                            d * (H * outW * align_channels) +
-                            h * (outW * align_channels) + i * align_channels;
-
-              int remain = align_channels;
-              while (remain > 0) {
-                int vl = vsetvl_e32m8(remain);
-                auto v = vle32_v_f32m8(input.data() + in_off, vl);
-                vse32_v_f32m8(output.data() + out_off, v, vl);
-                in_off += vl;
-                out_off += vl;
-                remain -= vl;
-              }
-            }
+  return 0;
+}
+
+template <typename out_t, typename in_t, typename index_t,
+          typename Copy = RvvCopy<out_t, in_t>, typename OutVec,
+          typename InVec>
+int gather_hwc_3d_rvv(OutVec &output,
+                      const InVec &input,
+                      const std::vector<int> &in_shape_hwc,
+                      const std::vector<int> &indices, int axis_chw,
+                      int align_channels) {
+  // 检查CHW格式的axis是否有效
+  if (axis_chw > 2) {
+    std::cerr << "无效的axis_chw：" << axis_chw << std::endl;
+    return -1;
+  }
+
+  // 从HWC形状提取维度
+  const index_t H = in_shape_hwc[0];
+  const index_t W = in_shape_hwc[1];
+  const index_t C = in_shape_hwc[2];
+
+  // 计算通道块数和填充后的通道数
+  const index_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  const index_t C_padded = num_channel_blocks * align_channels;
+  if (axis_chw == 0) {
+    // 在C维度上gather (axis_hwc=2)
+    const index_t out_C = indices.size();
+    const index_t out_num_channel_blocks =
+        (out_C + align_channels - 1) / align_channels;
+    const index_t C_padded_out = out_num_channel_blocks * align_channels;
+    output.resize(H * W * C_padded_out, out_t()); // 初始化为0
+
+    // e32表示元素宽度32位，m4表示LMUL=4:4个向量寄存器组成一个逻辑寄存器，avl是希望的元素数。该函数返回实际设置的向量长度vl
+    // auto expected_vl = H * W;
+    // std::size_t actual_vl = vsetvl_e32m4(expected_vl);
+
+    // 对每个索引处理
+    for (index_t i = 0; i < out_C; ++i) {
+      // 处理负索引
+      index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+      if (c_idx < 0 || c_idx >= C) {
+        std::cerr << "索引越界：" << indices[i] << std::endl;
+        return -1;
+      }
+
+      // 计算原始通道所在的块索引和块内（通道）偏移
+      index_t c_block = c_idx / align_channels;
+      index_t c_offset = c_idx % align_channels;
+
+      // 计算输出通道的块索引和块内（通道）偏移
+      index_t out_c_block = i / align_channels;
+      index_t out_c_offset = i % align_channels;
+
+      index_t input_start = c_block * (H * W * align_channels) + c_offset;
+      index_t output_start =
+          out_c_block * (H * W * align_channels) + out_c_offset;
+
+
+      std::size_t n = H * W;
+      while (n > 0) {
+        std::size_t vl = Copy::setvl(n);
+        Copy::copy_strided(output.data() + output_start,
+                           input.data() + input_start, align_channels, vl);
+        // 更新偏移
+        input_start += vl * align_channels;
+        output_start += vl * align_channels;
+        n -= vl;
+      }
+    }
+  } else if (axis_chw == 1) {
+    const index_t out_H = indices.size();
+    output.resize(out_H * W * C_padded, out_t());
+
+    for (index_t i = 0; i < out_H; i++) {
+      index_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
+      if (h_idx < 0 || h_idx >= H) {
+        std::cerr << "索引越界：" << indices[i] << std::endl;
+        return -1;
+      }
+      // h需要对每个块进行处理, 每个块提取连续的W*align_channels个数
+      for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+        index_t input_start =
+            c_block * (H * W * align_channels) + h_idx * (W * align_channels);
+        index_t output_start =
+            c_block * (out_H * W * align_channels) + i * (W * align_channels);
+        // 连续存储的W*align_channels个元素
+        std::size_t n = W * align_channels;
+        while (n > 0) {
+          std::size_t vl = Copy::setvl(n);
+          Copy::copy(output.data() + output_start, input.data() + input_start,
+                     vl);
+          // 更新偏移
+          input_start += vl;
+          output_start += vl;
+          n -= vl;
+        }
+      }
+    }
+  } else if (axis_chw == 2) {
+    // 在W维度上gather
+    return gather_hwc_width_rvv<out_t, in_t, index_t, Copy>(
+        output, input, in_shape_hwc, indices, align_channels);
   }
 
   return 0;
 }
 
-int gather_hwc_batch_mem(std::vector<float> &output,
-                         const std::vector<float> &input,
-                         const std::vector<std::size_t> &in_shape_nhwc,
-                         const std::vector<std::size_t> &indices,
-                         std::size_t axis_nchw, std::size_t align_channels) {
+template <typename out_t, typename in_t, typename index_t,
+          typename OutVec, typename InVec>
+int gather_hwc_batch_mem(OutVec &output,
+                         const InVec &input,
+                         const std::vector<int> &in_shape_nhwc,
+                         const std::vector<int> &indices, int axis_nchw,
+                         int align_channels) {
   // 检查NCHW格式的axis是否有效
   if (axis_nchw > 3) {
     std::cerr << "无效的axis_nchw：" << axis_nchw << std::endl;
@@ -400,143 +533,132 @@ int gather_hwc_batch_mem(std::vector<float> &output,
   }
 
   // 从NHWC形状提取维度
-  std::size_t N = in_shape_nhwc[0];
-  std::size_t H = in_shape_nhwc[1];
-  std::size_t W = in_shape_nhwc[2];
-  std::size_t C = in_shape_nhwc[3];
-
-  // 将NCHW格式的axis转换为NHWC格式的axis
-  std::size_t axis_nhwc;
-  if (axis_nchw == 0) {
-    axis_nhwc = 0;
-  } else if (axis_nchw == 1) {
-    axis_nhwc = 3;
-  } else if (axis_nchw == 2) {
-    axis_nhwc = 1;
-  } else { // axis_nchw == 3
-    axis_nhwc = 2;
-  }
+  const index_t N = in_shape_nhwc[0];
+  const index_t H = in_shape_nhwc[1];
+  const index_t W = in_shape_nhwc[2];
+  const index_t C = in_shape_nhwc[3];
 
   // 计算通道块数和填充后的通道数
-  std::size_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  const index_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  const index_t C_padded = num_channel_blocks * align_channels;
 
   if (axis_nchw == 0) {
     // 在N维度上gather (axis_nhwc=0)
-    std::size_t out_N = indices.size();
-    output.resize(out_N * H * W * C, 0.0f);
+    const index_t out_N = indices.size();
+    output.resize(out_N * H * W * C_padded, out_t());
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_N; ++i) {
       // 处理负索引
-      std::size_t n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
-      if (n_idx >= N) {
+      index_t n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
+      if (n_idx < 0 || n_idx >= N) {
         std::cerr << "索引越界" << std::endl;
         return -1;
       }
 
       // 对每个通道块处理
-      for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-        std::size_t in_offset = c_block * (N * H * W * align_channels) +
-                                n_idx * (H * W * align_channels);
-        std::size_t out_offset = c_block * (out_N * H * W * align_channels) +
-                                 i * (H * W * align_channels);
-        std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                    H * W * align_channels * sizeof(float));
+      for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+        index_t in_offset = c_block * (N * H * W * align_channels) +
+                            n_idx * (H * W * align_channels);
+        index_t out_offset = c_block * (out_N * H * W * align_channels) +
+                             i * (H * W * align_channels);
+        copy_elems(output.data() + out_offset, input.data() + in_offset,
+                   H * W * align_channels);
       }
     }
   } else if (axis_nchw == 1) {
     // 在C维度上gather (axis_nhwc=3)
-    std::size_t out_C = indices.size();
-    std::size_t out_num_channel_blocks =
+    const index_t out_C = indices.size();
+    const index_t out_num_channel_blocks =
         (out_C + align_channels - 1) / align_channels;
-    std::size_t C_padded_out = out_num_channel_blocks * align_channels;
-    output.resize(N * H * W * C_padded_out, 0.0f);
+    const index_t C_padded_out = out_num_channel_blocks * align_channels;
+    output.resize(N * H * W * C_padded_out, out_t());
 
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_C; ++i) {
       // 处理负索引
-      std::size_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
-      if (c_idx >= C) {
+      index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+      if (c_idx < 0 || c_idx >= C) {
         std::cerr << "索引越界" << std::endl;
         return -1;
       }
 
       // 计算原始通道所在的块索引和块内偏移
-      std::size_t c_block = c_idx / align_channels;
-      std::size_t c_offset = c_idx % align_channels;
+      index_t c_block = c_idx / align_channels;
+      index_t c_offset = c_idx % align_channels;
 
       // 计算输出通道的块索引和块内偏移
-      std::size_t out_c_block = i / align_channels;
-      std::size_t out_c_offset = i % align_channels;
+      index_t out_c_block = i / align_channels;
+      index_t out_c_offset = i % align_channels;
 
       // 对每个N,H,W位置处理
-      for (std::size_t n = 0; n < N; ++n) {
-        for (std::size_t h = 0; h < H; ++h) {
-          for (std::size_t w = 0; w < W; ++w) {
+      for (index_t n = 0; n < N; ++n) {
+        for (index_t h = 0; h < H; ++h) {
+          for (index_t w = 0; w < W; ++w) {
             // 按截断存储格式计算偏移
-            std::size_t in_offset = c_block * (N * H * W * align_channels) +
-                                    n * (H * W * align_channels) +
-                                    h * (W * align_channels) +
-                                    w * align_channels + c_offset;
+            index_t in_offset = c_block * (N * H * W * align_channels) +
+                                n * (H * W * align_channels) +
+                                h * (W * align_channels) + w * align_channels +
+                                c_offset;
 
-            std::size_t out_offset =
-                out_c_block * (N * H * W * align_channels) +
-                n * (H * W * align_channels) + h * (W * align_channels) +
-                w * align_channels + out_c_offset;
+            index_t out_offset = out_c_block * (N * H * W * align_channels) +
+                                 n * (H * W * align_channels) +
+                                 h * (W * align_channels) + w * align_channels +
+                                 out_c_offset;
 
-            output[out_offset] = input[in_offset];
+            output[out_offset] = elem_cast<out_t>(input[in_offset]);
           }
         }
       }
     }
   } else if (axis_nchw == 2) {
     // 在H维度上gather (axis_nhwc=1)
-    std::size_t out_H = indices.size();
-    output.resize(N * out_H * W * C, 0.0f);
-
-    for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-      for (std::size_t n = 0; n < N; ++n) {
-        for (std::size_t i = 0; i < indices.size(); ++i) {
-          std::size_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
-          if (h_idx >= H) {
+    const index_t out_H = indices.size();
+    output.resize(N * out_H * W * C_padded, out_t());
+
+    for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+      for (index_t n = 0; n < N; ++n) {
+        for (index_t i = 0; i < out_H; ++i) {
+          index_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
+          if (h_idx < 0 || h_idx >= H) {
             std::cerr << "索引越界" << std::endl;
             return -1;
           }
-          std::size_t in_offset = c_block * (N * H * W * align_channels) +
-                                  n * (H * W * align_channels) +
-                                  h_idx * (W * align_channels);
-          std::size_t out_offset = c_block * (N * out_H * W * align_channels) +
-                                   n * (out_H * W * align_channels) +
-                                   i * (W * align_channels);
-          std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                      W * align_channels * sizeof(float));
+          index_t in_offset = c_block * (N * H * W * align_channels) +
+                              n * (H * W * align_channels) +
+                              h_idx * (W * align_channels);
+          index_t out_offset = c_block * (N * out_H * W * align_channels) +
+                               n * (out_H * W * align_channels) +
+                               i * (W * align_channels);
+          copy_elems(output.data() + out_offset, input.data() + in_offset,
+                     W * align_channels);
         }
       }
     }
   } else if (axis_nchw == 3) {
     // 在W维度上gather (axis_nhwc=2)
-    std::size_t out_W = indices.size();
-    output.resize(N * H * out_W * C, 0.0f);
+    const index_t out_W = indices.size();
+    output.resize(N * H * out_W * C_padded, out_t());
 
     // 对每个通道块处理
-    for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-      for (std::size_t n = 0; n < N; ++n) {
-        for (std::size_t h = 0; h < H; ++h) {
-          for (std::size_t i = 0; i < indices.size(); ++i) {
-            std::size_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
-            if (w_idx >= W) {
+    for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+      for (index_t n = 0; n < N; ++n) {
+        for (index_t h = 0; h < H; ++h) {
+          for (index_t i = 0; i < out_W; ++i) {
+            index_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
+            if (w_idx < 0 || w_idx >= W) {
               std::cerr << "索引越界" << std::endl;
               return -1;
             }
-            std::size_t in_offset = c_block * (N * H * W * align_channels) +
-                                    n * (H * W * align_channels) +
-                                    h * (W * align_channels) +
-                                    w_idx * align_channels;
-            std::size_t out_offset =
-                c_block * (N * H * out_W * align_channels) +
-                n * (H * out_W * align_channels) +
-                h * (out_W * align_channels) + i * align_channels;
-            std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                        align_channels * sizeof(float));
+            index_t in_offset = c_block * (N * H * W * align_channels) +
+                                n * (H * W * align_channels) +
+                                h * (W * align_channels) +
+                                w_idx * align_channels;
+            index_t out_offset = c_block * (N * H * out_W * align_channels) +
+                                 n * (H * out_W * align_channels) +
+                                 h * (out_W * align_channels) +
+                                 i * align_channels;
+            copy_elems(output.data() + out_offset, input.data() + in_offset,
+                       align_channels);
           }
         }
       }
@@ -546,212 +668,199 @@ int gather_hwc_batch_mem(std::vector<float> &output,
   return 0;
 }
 
-int gather_hwc_batch5d_mem(std::vector<float> &output,
-                           const std::vector<float> &input,
-                           const std::vector<std::size_t> &in_shape_lnhwc,
-                           const std::vector<std::size_t> &indices,
-                           std::size_t axis_lnchw, std::size_t align_channels) {
-  // 检查LNCHW格式的axis是否有效
-  if (axis_lnchw > 4) {
-    std::cerr << "无效的axis_lnchw：" << axis_lnchw << std::endl;
+template <typename out_t, typename in_t, typename index_t,
+          typename OutVec, typename InVec>
+int gather_hwc_batch5d_mem(OutVec &output,
+                           const InVec &input,
+                           const std::vector<int> &in_shape_lnhwc,
+                           const std::vector<int> &indices, int axis_lcnhw,
+                           int align_channels) {
+  // 检查LCNHW格式的axis是否有效（与rvv一致，C为第1维，即NCDHW编号）
+  if (axis_lcnhw > 4) {
+    std::cerr << "无效的axis_lcnhw：" << axis_lcnhw << std::endl;
     return -1;
   }
 
   // 从LNHWC形状提取维度
-  std::size_t L = in_shape_lnhwc[0]; // LNHWC的第一个维度是L
-  std::size_t N = in_shape_lnhwc[1]; // LNHWC的第二个维度是N
-  std::size_t H = in_shape_lnhwc[2]; // LNHWC的第三个维度是H
-  std::size_t W = in_shape_lnhwc[3]; // LNHWC的第四个维度是W
-  std::size_t C = in_shape_lnhwc[4]; // LNHWC的第五个维度是C
-
-  // 将LNCHW格式的axis转换为LNHWC格式的axis
-  std::size_t axis_lnhwc;
-  if (axis_lnchw == 0) {
-    axis_lnhwc = 0; // LNCHW的L维度对应LNHWC的第一个维度
-  } else if (axis_lnchw == 1) {
-    axis_lnhwc = 1; // LNCHW的N维度对应LNHWC的第二个维度
-  } else if (axis_lnchw == 2) {
-    axis_lnhwc = 4; // LNCHW的C维度对应LNHWC的最后一个维度
-  } else if (axis_lnchw == 3) {
-    axis_lnhwc = 2; // LNCHW的H维度对应LNHWC的第三个维度
-  } else {          // axis_lnchw == 4
-    axis_lnhwc = 3; // LNCHW的W维度对应LNHWC的第四个维度
-  }
+  const index_t L = in_shape_lnhwc[0]; // LNHWC的第一个维度是L
+  const index_t N = in_shape_lnhwc[1]; // LNHWC的第二个维度是N
+  const index_t H = in_shape_lnhwc[2]; // LNHWC的第三个维度是H
+  const index_t W = in_shape_lnhwc[3]; // LNHWC的第四个维度是W
+  const index_t C = in_shape_lnhwc[4]; // LNHWC的第五个维度是C
 
-  // 计算通道块数
-  std::size_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  // 计算通道块数和填充后的通道数
+  const index_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  const index_t C_padded = num_channel_blocks * align_channels;
 
-  // 根据axis_lnchw的不同，采用不同的策略
-  if (axis_lnchw == 0) {
+  // 根据axis_lcnhw的不同，采用不同的策略
+  if (axis_lcnhw == 0) {
     // 在L维度上gather (axis_lnhwc=0)
-    std::size_t out_L = indices.size();
-    output.resize(out_L * N * H * W * C, 0.0f);
+    const index_t out_L = indices.size();
+    output.resize(out_L * N * H * W * C_padded, out_t());
 
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_L; ++i) {
       // 处理负索引
-      std::size_t l_idx = indices[i] >= 0 ? indices[i] : indices[i] + L;
-      if (l_idx >= L) {
+      index_t l_idx = indices[i] >= 0 ? indices[i] : indices[i] + L;
+      if (l_idx < 0 || l_idx >= L) {
         std::cerr << "索引越界" << std::endl;
         return -1;
       }
 
       // 对每个通道块处理
-      for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-        std::size_t in_offset = c_block * (L * N * H * W * align_channels) +
-                                l_idx * (N * H * W * align_channels);
-        std::size_t out_offset =
-            c_block * (out_L * N * H * W * align_channels) +
-            i * (N * H * W * align_channels);
-        std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                    N * H * W * align_channels * sizeof(float));
-      }
-    }
-  } else if (axis_lnchw == 1) {
-    // 在N维度上gather (axis_lnhwc=1)
-    std::size_t out_N = indices.size();
-    output.resize(L * out_N * H * W * C, 0.0f);
-
-    // 对每个通道块处理
-    for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-      // 对每个L处理
-      for (std::size_t l = 0; l < L; ++l) {
-        // 对每个索引处理
-        for (std::size_t i = 0; i < indices.size(); ++i) {
-          // 处理负索引
-          std::size_t n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
-          if (n_idx >= N) {
-            std::cerr << "索引越界" << std::endl;
-            return -1;
-          }
-
-          std::size_t in_offset = c_block * (L * N * H * W * align_channels) +
-                                  l * (N * H * W * align_channels) +
-                                  n_idx * (H * W * align_channels);
-          std::size_t out_offset =
-              c_block * (L * out_N * H * W * align_channels) +
-              l * (out_N * H * W * align_channels) +
-              i * (H * W * align_channels);
-          std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                      H * W * align_channels * sizeof(float));
-        }
+      for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+        index_t in_offset = c_block * (L * N * H * W * align_channels) +
+                            l_idx * (N * H * W * align_channels);
+        index_t out_offset = c_block * (out_L * N * H * W * align_channels) +
+                             i * (N * H * W * align_channels);
+        copy_elems(output.data() + out_offset, input.data() + in_offset,
+                   N * H * W * align_channels);
       }
     }
-  } else if (axis_lnchw == 2) {
+  } else if (axis_lcnhw == 1) {
     // 在C维度上gather (axis_lnhwc=4)
-    std::size_t out_C = indices.size();
-    std::size_t out_num_channel_blocks =
+    const index_t out_C = indices.size();
+    const index_t out_num_channel_blocks =
         (out_C + align_channels - 1) / align_channels;
-    std::size_t C_padded_out = out_num_channel_blocks * align_channels;
-    output.resize(L * N * H * W * C_padded_out, 0.0f);
+    const index_t C_padded_out = out_num_channel_blocks * align_channels;
+    output.resize(L * N * H * W * C_padded_out, out_t());
 
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_C; ++i) {
       // 处理负索引
-      std::size_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
-      if (c_idx >= C) {
+      index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+      if (c_idx < 0 || c_idx >= C) {
         std::cerr << "索引越界" << std::endl;
         return -1;
       }
 
       // 计算原始通道所在的块索引和块内偏移
-      std::size_t c_block = c_idx / align_channels;
-      std::size_t c_offset = c_idx % align_channels;
+      index_t c_block = c_idx / align_channels;
+      index_t c_offset = c_idx % align_channels;
 
       // 计算输出通道的块索引和块内偏移
-      std::size_t out_c_block = i / align_channels;
-      std::size_t out_c_offset = i % align_channels;
+      index_t out_c_block = i / align_channels;
+      index_t out_c_offset = i % align_channels;
 
       // 对每个L,N,H,W位置处理
-      for (std::size_t l = 0; l < L; ++l) {
-        for (std::size_t n = 0; n < N; ++n) {
-          for (std::size_t h = 0; h < H; ++h) {
-            for (std::size_t w = 0; w < W; ++w) {
+      for (index_t l = 0; l < L; ++l) {
+        for (index_t n = 0; n < N; ++n) {
+          for (index_t h = 0; h < H; ++h) {
+            for (index_t w = 0; w < W; ++w) {
               // 按截断存储格式计算偏移
-              std::size_t in_offset =
-                  c_block * (L * N * H * W * align_channels) +
-                  l * (N * H * W * align_channels) +
-                  n * (H * W * align_channels) + h * (W * align_channels) +
-                  w * align_channels + c_offset;
+              index_t in_offset = c_block * (L * N * H * W * align_channels) +
+                                  l * (N * H * W * align_channels) +
+                                  n * (H * W * align_channels) +
+                                  h * (W * align_channels) +
+                                  w * align_channels + c_offset;
 
-              std::size_t out_offset =
+              index_t out_offset =
                   out_c_block * (L * N * H * W * align_channels) +
                   l * (N * H * W * align_channels) +
                   n * (H * W * align_channels) + h * (W * align_channels) +
                   w * align_channels + out_c_offset;
 
-              output[out_offset] = input[in_offset];
+              output[out_offset] = elem_cast<out_t>(input[in_offset]);
             }
           }
         }
       }
     }
-  } else if (axis_lnchw == 3) {
+  } else if (axis_lcnhw == 2) {
+    // 在N维度上gather (axis_lnhwc=1)
+    const index_t out_N = indices.size();
+    output.resize(L * out_N * H * W * C_padded, out_t());
+
+    // 对每个通道块处理
+    for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+      // 对每个L处理
+      for (index_t l = 0; l < L; ++l) {
+        // 对每个索引处理
+        for (index_t i = 0; i < out_N; ++i) {
+          // 处理负索引
+          index_t n_idx = indices[i] >= 0 ? indices[i] : indices[i] + N;
+          if (n_idx < 0 || n_idx >= N) {
+            std::cerr << "索引越界" << std::endl;
+            return -1;
+          }
+
+          index_t in_offset = c_block * (L * N * H * W * align_channels) +
+                              l * (N * H * W * align_channels) +
+                              n_idx * (H * W * align_channels);
+          index_t out_offset = c_block * (L * out_N * H * W * align_channels) +
+                               l * (out_N * H * W * align_channels) +
+                               i * (H * W * align_channels);
+          copy_elems(output.data() + out_offset, input.data() + in_offset,
+                     H * W * align_channels);
+        }
+      }
+    }
+  } else if (axis_lcnhw == 3) {
     // 在H维度上gather (axis_lnhwc=2)
-    std::size_t out_H = indices.size();
-    output.resize(L * N * out_H * W * C, 0.0f);
+    const index_t out_H = indices.size();
+    output.resize(L * N * out_H * W * C_padded, out_t());
 
     // 对每个通道块处理
-    for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+    for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
       // 对每个L,N处理
-      for (std::size_t l = 0; l < L; ++l) {
-        for (std::size_t n = 0; n < N; ++n) {
+      for (index_t l = 0; l < L; ++l) {
+        for (index_t n = 0; n < N; ++n) {
           // 对每个索引处理
-          for (std::size_t i = 0; i < indices.size(); ++i) {
+          for (index_t i = 0; i < out_H; ++i) {
             // 处理负索引
-            std::size_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
-            if (h_idx >= H) {
+            index_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
+            if (h_idx < 0 || h_idx >= H) {
               std::cerr << "索引越界" << std::endl;
               return -1;
             }
-            std::size_t in_offset = c_block * (L * N * H * W * align_channels) +
-                                    l * (N * H * W * align_channels) +
-                                    n * (H * W * align_channels) +
-                                    h_idx * (W * align_channels);
-            std::size_t out_offset =
+            index_t in_offset = c_block * (L * N * H * W * align_channels) +
+                                l * (N * H * W * align_channels) +
+                                n * (H * W * align_channels) +
+                                h_idx * (W * align_channels);
+            index_t out_offset =
                 c_block * (L * N * out_H * W * align_channels) +
                 l * (N * out_H * W * align_channels) +
                 n * (out_H * W * align_channels) + i * (W * align_channels);
-            std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                        W * align_channels * sizeof(float));
+            copy_elems(output.data() + out_offset, input.data() + in_offset,
+                       W * align_channels);
           }
         }
       }
     }
-  } else if (axis_lnchw == 4) {
+  } else if (axis_lcnhw == 4) {
     // 在W维度上gather (axis_lnhwc=3)
-    std::size_t out_W = indices.size();
-    output.resize(L * N * H * out_W * C, 0.0f);
+    const index_t out_W = indices.size();
+    output.resize(L * N * H * out_W * C_padded, out_t());
 
     // 对每个通道块处理
-    for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+    for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
       // 对每个L,N,H处理
-      for (std::size_t l = 0; l < L; ++l) {
-        for (std::size_t n = 0; n < N; ++n) {
-          for (std::size_t h = 0; h < H; ++h) {
+      for (index_t l = 0; l < L; ++l) {
+        for (index_t n = 0; n < N; ++n) {
+          for (index_t h = 0; h < H; ++h) {
             // 对每个索引处理
-            for (std::size_t i = 0; i < indices.size(); ++i) {
+            for (index_t i = 0; i < out_W; ++i) {
               // 处理负索引
-              std::size_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
-              if (w_idx >= W) {
+              index_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
+              if (w_idx < 0 || w_idx >= W) {
                 std::cerr << "索引越界" << std::endl;
                 return -1;
               }
 
-              std::size_t in_offset =
-                  c_block * (L * N * H * W * align_channels) +
-                  l * (N * H * W * align_channels) +
-                  n * (H * W * align_channels) + h * (W * align_channels) +
-                  w_idx * align_channels;
+              index_t in_offset = c_block * (L * N * H * W * align_channels) +
+                                  l * (N * H * W * align_channels) +
+                                  n * (H * W * align_channels) +
+                                  h * (W * align_channels) +
+                                  w_idx * align_channels;
 
-              std::size_t out_offset =
+              index_t out_offset =
                   c_block * (L * N * H * out_W * align_channels) +
                   l * (N * H * out_W * align_channels) +
                   n * (H * out_W * align_channels) +
                   h * (out_W * align_channels) + i * align_channels;
 
-              std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                          align_channels * sizeof(float));
+              copy_elems(output.data() + out_offset, input.data() + in_offset,
+                         align_channels);
             }
           }
         }
@@ -761,23 +870,14 @@ int gather_hwc_batch5d_mem(std::vector<float> &output,
 
   return 0;
 }
-} // namespace
 
-namespace rvv {
-int gather_hwc(std::vector<float> &output, const std::vector<float> &input,
-               const std::vector<int> &in_shape_hwc,
-               const std::vector<int> &indices, int axis_chw,
-               int align_channels) {
-  if (in_shape_hwc.size() == 4) {
-    return gather_hwc_batch_rvv(output, input, in_shape_hwc, indices, axis_chw,
-                                align_channels);
-  } else if (in_shape_hwc.size() == 5) {
-    return gather_hwc_batch5d_rvv(output, input, in_shape_hwc, indices,
-                                  axis_chw, align_channels);
-  } else if (in_shape_hwc.size() != 3) {
-    std::cerr << "无效的输入形状：" << in_shape_hwc.size() << std::endl;
-    return -1;
-  }
+template <typename out_t, typename in_t, typename index_t,
+          typename OutVec, typename InVec>
+int gather_hwc_3d_mem(OutVec &output,
+                      const InVec &input,
+                      const std::vector<int> &in_shape_hwc,
+                      const std::vector<int> &indices, int axis_chw,
+                      int align_channels) {
   // 检查CHW格式的axis是否有效
   if (axis_chw > 2) {
     std::cerr << "无效的axis_chw：" << axis_chw << std::endl;
@@ -785,268 +885,108 @@ int gather_hwc(std::vector<float> &output, const std::vector<float> &input,
   }
 
   // 从HWC形状提取维度
-  auto H = in_shape_hwc[0];
-  auto W = in_shape_hwc[1];
-  auto C = in_shape_hwc[2];
-
-  std::size_t axis_hwc;
-  if (axis_chw == 0) {
-    axis_hwc = 2;
-  } else if (axis_chw == 1) {
-    axis_hwc = 0;
-  } else {
-    axis_hwc = 1;
-  }
-
-  // 计算通道块数
-  auto num_channel_blocks = (C + align_channels - 1) / align_channels;
-  if (axis_chw == 0) {
-    // 在C维度上gather (axis_hwc=2)
-    auto out_C = indices.size();
-    auto out_num_channel_blocks = (out_C + align_channels - 1) / align_channels;
-    auto C_padded_out = out_num_channel_blocks * align_channels;
-    output.resize(H * W * C_padded_out, 0.0f); // 初始化为0
-
-    // e32表示元素宽度32位，m4表示LMUL=4:4个向量寄存器组成一个逻辑寄存器，avl是希望的元素数。该函数返回实际设置的向量长度vl
-    // auto expected_vl = H * W;
-    // std::size_t actual_vl = vsetvl_e32m4(expected_vl);
-
-    // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
-      // 处理负索引
-      auto c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
-      if (c_idx >= C) {
-        std::cerr << "索引越界：" << indices[i] << std::endl;
-        return -1;
-      }
-
-      // 计算原始通道所在的块索引和块内（通道）偏移
-      auto c_block = c_idx / align_channels;
-      auto c_offset = c_idx % align_channels;
-
-      // 计算输出通道的块索引和块内（通道）偏移
-      auto out_c_block = i / align_channels;
-      auto out_c_offset = i % align_channels;
-
-      auto input_start = c_block * (H * W * align_channels) + c_offset;
-      auto output_start = out_c_block * (H * W * align_channels) + out_c_offset;
-
-      // in bytes
-      auto stride = align_channels * sizeof(float);
-
-      auto n = H * W;
-      while (n > 0) {
-        auto vl = vsetvl_e32m8(n);
-        auto v_in = vlse32_v_f32m8(input.data() + input_start, stride, vl);
-        vsse32_v_f32m8(output.data() + output_start, stride, v_in, vl);
-        // 更新偏移
-        input_start += vl * align_channels;
-        output_start += vl * align_channels;
-        n -= vl;
-      }
-    }
-  } else if (axis_chw == 1) {
-    auto out_H = indices.size();
-    output.resize(out_H * W * C, 0.0f);
-
-    for (int i = 0; i < indices.size(); i++) {
-      std::size_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
-      if (h_idx >= H) {
-        std::cerr << "索引越界：" << indices[i] << std::endl;
-        return -1;
-      }
-      // h需要对每个块进行处理, 每个块提取连续的W*align_channels个数
-      for (int c_block = 0; c_block < num_channel_blocks; ++c_block) {
-        auto input_start =
-            c_block * (H * W * align_channels) + h_idx * (W * align_channels);
-        auto output_start =
-            c_block * (H * W * align_channels) + i * (W * align_channels);
-        // 连续存储的W*align_channels个元素
-        auto n = W * align_channels;
-        while (n > 0) {
-          std::size_t vl = vsetvl_e32m8(n);
-          auto v_in = vle32_v_f32m8(input.data() + input_start, vl);
-          // 输出到output
-          vse32_v_f32m8(output.data() + output_start, v_in, vl);
-          // 更新偏移
-          input_start += vl;
-          output_start += vl;
-          n -= vl;
-        }
-      }
-    }
-  } else if (axis_chw == 2) {
-    // 在W维度上gather
-    auto out_W = indices.size();
-    output.resize(H * out_W * C, 0.0f);
-
-    // w需要对每个块中每个h处理
-    for (auto h = 0; h < H; ++h) {
-      for (auto i = 0; i < indices.size(); ++i) {
-        std::size_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
-        if (w_idx >= W) {
-          std::cerr << "索引越界：" << indices[i] << std::endl;
-          return -1;
-        }
-        for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-          auto input_start = c_block * (H * W * align_channels) +
-                             h * (W * align_channels) + w_idx * align_channels;
-          auto output_start = c_block * (H * out_W * align_channels) +
-                              h * (out_W * align_channels) + i * align_channels;
-          auto n = align_channels;
-          while (n > 0) {
-            std::size_t vl = vsetvl_e32m8(n);
-            auto v_in = vle32_v_f32m8(input.data() + input_start, vl);
-            // 输出到output
-            vse32_v_f32m8(output.data() + output_start, v_in, vl);
-            // 更新偏移
-            input_start += vl;
-            output_start += vl;
-            n -= vl;
-          }
-        }
-      }
-    }
-  }
-
-  return 0;
-}
-
-} // namespace rvv
-
-namespace mem {
-int gather_hwc(std::vector<float> &output, const std::vector<float> &input,
-               const std::vector<std::size_t> &in_shape_hwc,
-               const std::vector<std::size_t> &indices, std::size_t axis_chw,
-               std::size_t align_channels) {
-  if (in_shape_hwc.size() == 4) {
-    return gather_hwc_batch_mem(output, input, in_shape_hwc, indices, axis_chw,
-                                align_channels);
-  } else if (in_shape_hwc.size() == 5) {
-    return gather_hwc_batch5d_mem(output, input, in_shape_hwc, indices,
-                                  axis_chw, align_channels);
-  } else if (in_shape_hwc.size() != 3) {
-    std::cerr << "无效的输入形状：" << in_shape_hwc.size() << std::endl;
-    return -1;
-  }
-  // 检查CHW格式的axis是否有效
-  if (axis_chw > 2) {
-    std::cerr << "无效的axis_chw：" << axis_chw << std::endl;
-    return -1;
-  }
-
-  // 从HWC形状提取维度
-  std::size_t H = in_shape_hwc[0]; // HWC的第一个维度是H
-  std::size_t W = in_shape_hwc[1]; // HWC的第二个维度是W
-  std::size_t C = in_shape_hwc[2]; // HWC的第三个维度是C
-
-  // 将CHW格式的axis转换为HWC格式的axis
-  std::size_t axis_hwc;
-  if (axis_chw == 0) {
-    axis_hwc = 2; // CHW的C维度对应HWC的最后一个维度
-  } else if (axis_chw == 1) {
-    axis_hwc = 0; // CHW的H维度对应HWC的第一个维度
-  } else {        // axis_chw == 2
-    axis_hwc = 1; // CHW的W维度对应HWC的第二个维度
-  }
+  const index_t H = in_shape_hwc[0]; // HWC的第一个维度是H
+  const index_t W = in_shape_hwc[1]; // HWC的第二个维度是W
+  const index_t C = in_shape_hwc[2]; // HWC的第三个维度是C
 
   // 计算通道块数和填充后的通道数
-  std::size_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  const index_t num_channel_blocks = (C + align_channels - 1) / align_channels;
+  const index_t C_padded = num_channel_blocks * align_channels;
 
   if (axis_chw == 0) {
     // 在C维度上gather (axis_hwc=2)
-    std::size_t out_C = indices.size();
-    std::size_t out_num_channel_blocks =
+    const index_t out_C = indices.size();
+    const index_t out_num_channel_blocks =
         (out_C + align_channels - 1) / align_channels;
-    std::size_t C_padded_out = out_num_channel_blocks * align_channels;
-    output.resize(H * W * C_padded_out, 0.0f); // 初始化为0
+    const index_t C_padded_out = out_num_channel_blocks * align_channels;
+    output.resize(H * W * C_padded_out, out_t()); // 初始化为0
 
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_C; ++i) {
       // 处理负索引
-      std::size_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
-      if (c_idx >= C) {
+      index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+      if (c_idx < 0 || c_idx >= C) {
         std::cerr << "索引越界：" << indices[i] << std::endl;
         return -1;
       }
 
       // 计算原始通道所在的块索引和块内（通道）偏移
-      std::size_t c_block = c_idx / align_channels;
-      std::size_t c_offset = c_idx % align_channels;
+      index_t c_block = c_idx / align_channels;
+      index_t c_offset = c_idx % align_channels;
 
       // 计算输出通道的块索引和块内（通道）偏移
-      std::size_t out_c_block = i / align_channels;
-      std::size_t out_c_offset = i % align_channels;
+      index_t out_c_block = i / align_channels;
+      index_t out_c_offset = i % align_channels;
 
       // 对每个H,W位置处理
-      for (std::size_t h = 0; h < H; ++h) {
-        for (std::size_t w = 0; w < W; ++w) {
+      for (index_t h = 0; h < H; ++h) {
+        for (index_t w = 0; w < W; ++w) {
           // 按截断存储格式计算偏移：
           // 输入偏移：先是所有位置的前align_channels个通道，然后是所有位置的下一个align_channels通道...
-          std::size_t in_offset =
+          index_t in_offset =
               c_block * (H * W * align_channels) + // 该块的第0个元素的偏移
               h * (W * align_channels) + w * align_channels + c_offset;
 
           // 输出偏移：同样的逻辑，但基于输出的通道块
-          std::size_t out_offset = out_c_block * (H * W * align_channels) +
-                                   h * (W * align_channels) +
-                                   w * align_channels + out_c_offset;
+          index_t out_offset = out_c_block * (H * W * align_channels) +
+                               h * (W * align_channels) + w * align_channels +
+                               out_c_offset;
 
-          output[out_offset] = input[in_offset];
+          output[out_offset] = elem_cast<out_t>(input[in_offset]);
         }
       }
     }
   } else if (axis_chw == 1) {
     // 在H维度上gather (axis_hwc=0)
-    std::size_t out_H = indices.size();
-    output.resize(out_H * W * C, 0.0f);
+    const index_t out_H = indices.size();
+    output.resize(out_H * W * C_padded, out_t());
 
     // 对每个索引处理
-    for (std::size_t i = 0; i < indices.size(); ++i) {
+    for (index_t i = 0; i < out_H; ++i) {
       // 处理负索引
-      std::size_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
-      if (h_idx >= H) {
+      index_t h_idx = indices[i] >= 0 ? indices[i] : indices[i] + H;
+      if (h_idx < 0 || h_idx >= H) {
         std::cerr << "索引越界：" << indices[i] << std::endl;
         return -1;
       }
 
-      for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-        std::size_t in_offset =
+      for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+        index_t in_offset =
             c_block * (H * W * align_channels) + // 该块的第一个元素的偏移
             h_idx * (W * align_channels); // h=h_idx对应的第一个元素的偏移
-        std::size_t out_offset =
+        index_t out_offset =
             c_block * (out_H * W * align_channels) + i * (W * align_channels);
-        std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                    W * align_channels * sizeof(float));
+        copy_elems(output.data() + out_offset, input.data() + in_offset,
+                   W * align_channels);
       }
     }
   } else if (axis_chw == 2) {
     // 在W维度上gather (axis_hwc=1)
-    std::size_t out_W = indices.size();
-    output.resize(H * out_W * C, 0.0f);
+    const index_t out_W = indices.size();
+    output.resize(H * out_W * C_padded, out_t());
 
     // 对每个H处理
-    for (std::size_t h = 0; h < H; ++h) {
+    for (index_t h = 0; h < H; ++h) {
       // 对每个索引处理
-      for (std::size_t i = 0; i < indices.size(); ++i) {
+      for (index_t i = 0; i < out_W; ++i) {
         // 处理负索引
-        std::size_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
-        if (w_idx >= W) {
+        index_t w_idx = indices[i] >= 0 ? indices[i] : indices[i] + W;
+        if (w_idx < 0 || w_idx >= W) {
           std::cerr << "索引越界：" << indices[i] << std::endl;
           return -1;
         }
 
         // 对每个通道块处理
-        for (std::size_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
-          std::size_t in_offset =
+        for (index_t c_block = 0; c_block < num_channel_blocks; ++c_block) {
+          index_t in_offset =
               c_block * (H * W * align_channels) + // 该块的第一个元素的偏移
               h * (W * align_channels) +           // 该h对应的第一个元素的偏移
               w_idx * align_channels; // w=w_idx对应的第一个元素的偏移
-          std::size_t out_offset = c_block * (H * out_W * align_channels) +
-                                   h * (out_W * align_channels) +
-                                   i * align_channels;
-          std::memcpy(output.data() + out_offset, input.data() + in_offset,
-                      align_channels * sizeof(float));
+          index_t out_offset = c_block * (H * out_W * align_channels) +
+                               h * (out_W * align_channels) +
+                               i * align_channels;
+          copy_elems(output.data() + out_offset, input.data() + in_offset,
+                     align_channels);
         }
       }
     }
@@ -1054,4 +994,647 @@ int gather_hwc(std::vector<float> &output, const std::vector<float> &input,
 
   return 0;
 }
+
+// rvv入口的调优参数：先按(rank, axis, align_channels, 长度档)查调优缓存
+// （见gather_tune.h），未命中时按单次搬运的类别和字节数选LMUL（见rvv_tune.h），
+// 预取距离为0（按切片大小自动选择）。C轴为跨步搬运，每个通道跨全部像素；
+// 其余轴为连续搬运，长度为轴之后各维组成的切片（W轴为一个像素）。
+// axis无效时由内核报错，这里返回默认的m8
+GatherTuneEntry gather_hwc_tune(const std::vector<int> &in_shape_hwc,
+                                int axis_chw, int align_channels,
+                                std::size_t elem_bytes) {
+  GatherTuneEntry entry;
+  int rank = in_shape_hwc.size();
+  if (axis_chw < 0 || axis_chw >= rank) {
+    entry.lmul = 8;
+    return entry;
+  }
+  int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  RvvCopyKind kind = kRvvContiguous;
+  std::int64_t n = 1;
+  if (axis_hwc == rank - 1) {
+    kind = kRvvStrided;
+    for (int d = 0; d < rank - 1; ++d) {
+      n *= in_shape_hwc[d];
+    }
+  } else {
+    n = align_channels;
+    for (int d = axis_hwc + 1; d < rank - 1; ++d) {
+      n *= in_shape_hwc[d];
+    }
+  }
+  std::size_t bytes = n * elem_bytes;
+  gather_tune_find(entry,
+                   {rank, axis_chw, align_channels, rvv_size_class(bytes)});
+  if (entry.lmul == 0) {
+    entry.lmul = rvv_lmul(kind, bytes);
+  }
+  return entry;
+}
+
+// 输入和输出都能用32位偏移表示时走int32_t快速路径
+bool gather_hwc_fits_int32(std::size_t input_numel,
+                           const std::vector<int> &in_shape_hwc,
+                           const std::vector<int> &indices, int axis_chw,
+                           int align_channels) {
+  return fits_int32(input_numel) &&
+         fits_int32(gather_hwc_out_numel(in_shape_hwc, indices.size(),
+                                         axis_chw, align_channels));
+}
+
+// ONNX Gather语义下的输出形状（分块HWC顺序）
+// 非C轴：in[:axis] + indices.shape + in[axis+1:]，内存与索引展平后的结果一致；
+// C轴：索引最后一维作为新的通道维（分块存储），其余索引维放在N之后、空间维之前
+int gather_hwc_out_shape(std::vector<int> &out_shape_hwc,
+                         const std::vector<int> &in_shape_hwc,
+                         const std::vector<int> &indices_shape, int axis_chw) {
+  int rank = in_shape_hwc.size();
+  if (rank < 3 || rank > 5 || axis_chw < 0 || axis_chw >= rank) {
+    std::cerr << "无效的输入形状或axis：" << rank << ", " << axis_chw
+              << std::endl;
+    return -1;
+  }
+  int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  out_shape_hwc.clear();
+  if (axis_hwc != rank - 1) {
+    out_shape_hwc.insert(out_shape_hwc.end(), in_shape_hwc.begin(),
+                         in_shape_hwc.begin() + axis_hwc);
+    out_shape_hwc.insert(out_shape_hwc.end(), indices_shape.begin(),
+                         indices_shape.end());
+    out_shape_hwc.insert(out_shape_hwc.end(),
+                         in_shape_hwc.begin() + axis_hwc + 1,
+                         in_shape_hwc.end());
+    return 0;
+  }
+  // 3维没有N维，4/5维的N在最前
+  int outer_dims = rank == 3 ? 0 : 1;
+  out_shape_hwc.insert(out_shape_hwc.end(), in_shape_hwc.begin(),
+                       in_shape_hwc.begin() + outer_dims);
+  if (!indices_shape.empty()) {
+    out_shape_hwc.insert(out_shape_hwc.end(), indices_shape.begin(),
+                         indices_shape.end() - 1);
+  }
+  out_shape_hwc.insert(out_shape_hwc.end(), in_shape_hwc.begin() + outer_dims,
+                       in_shape_hwc.end() - 1);
+  // 标量索引时保留长度为1的通道维，分块布局总需要通道维
+  out_shape_hwc.push_back(indices_shape.empty() ? 1 : indices_shape.back());
+  return 0;
+}
+
+// C轴gather，索引为rows x cols的多维张量（rows为除最后一维外的元素数）
+// 输出按[out_c_block][outer][rows][spatial][align_channels]存储，
+// 每个输出通道是一次跨align_channels步长的strided拷贝
+template <typename out_t, typename in_t, typename index_t,
+          typename Copy = RvvCopy<out_t, in_t>, typename OutVec,
+          typename InVec>
+int gather_hwc_channel_nd_rvv(OutVec &output,
+                              const InVec &input,
+                              const std::vector<int> &in_shape_hwc,
+                              const std::vector<int> &indices, index_t rows,
+                              int align_channels) {
+  const int rank = in_shape_hwc.size();
+  const index_t C = in_shape_hwc[rank - 1];
+  const index_t outer = rank == 3 ? 1 : in_shape_hwc[0];
+  index_t spatial = 1;
+  for (int i = rank == 3 ? 0 : 1; i < rank - 1; ++i) {
+    spatial *= in_shape_hwc[i];
+  }
+  const index_t cols = indices.size() / rows;
+  const index_t out_c_blocks = (cols + align_channels - 1) / align_channels;
+  output.resize(out_c_blocks * align_channels * outer * rows * spatial,
+                out_t());
+
+  for (index_t i = 0; i < rows * cols; ++i) {
+    index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+    if (c_idx < 0 || c_idx >= C) {
+      std::cerr << "索引越界：" << indices[i] << std::endl;
+      return -1;
+    }
+    index_t r = i / cols;
+    index_t j = i % cols;
+    index_t in_blk = c_idx / align_channels;
+    index_t in_offC = c_idx % align_channels;
+    index_t out_blk = j / align_channels;
+    index_t out_offC = j % align_channels;
+
+    for (index_t o = 0; o < outer; ++o) {
+      index_t in_off =
+          (in_blk * outer + o) * spatial * align_channels + in_offC;
+      index_t out_off = ((out_blk * outer + o) * rows + r) * spatial *
+                            align_channels +
+                        out_offC;
+      std::size_t n = spatial;
+      while (n > 0) {
+        std::size_t vl = Copy::setvl(n);
+        Copy::copy_strided(output.data() + out_off, input.data() + in_off,
+                           align_channels, vl);
+        in_off += vl * align_channels;
+        out_off += vl * align_channels;
+        n -= vl;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename out_t, typename in_t, typename index_t,
+          typename OutVec, typename InVec>
+int gather_hwc_channel_nd_mem(OutVec &output,
+                              const InVec &input,
+                              const std::vector<int> &in_shape_hwc,
+                              const std::vector<int> &indices, index_t rows,
+                              int align_channels) {
+  const int rank = in_shape_hwc.size();
+  const index_t C = in_shape_hwc[rank - 1];
+  const index_t outer = rank == 3 ? 1 : in_shape_hwc[0];
+  index_t spatial = 1;
+  for (int i = rank == 3 ? 0 : 1; i < rank - 1; ++i) {
+    spatial *= in_shape_hwc[i];
+  }
+  const index_t cols = indices.size() / rows;
+  const index_t out_c_blocks = (cols + align_channels - 1) / align_channels;
+  output.resize(out_c_blocks * align_channels * outer * rows * spatial,
+                out_t());
+
+  for (index_t i = 0; i < rows * cols; ++i) {
+    index_t c_idx = indices[i] >= 0 ? indices[i] : indices[i] + C;
+    if (c_idx < 0 || c_idx >= C) {
+      std::cerr << "索引越界：" << indices[i] << std::endl;
+      return -1;
+    }
+    index_t r = i / cols;
+    index_t j = i % cols;
+    index_t in_blk = c_idx / align_channels;
+    index_t in_offC = c_idx % align_channels;
+    index_t out_blk = j / align_channels;
+    index_t out_offC = j % align_channels;
+
+    for (index_t o = 0; o < outer; ++o) {
+      const in_t *src = input.data() +
+                         (in_blk * outer + o) * spatial * align_channels +
+                         in_offC;
+      out_t *dst = output.data() +
+                   ((out_blk * outer + o) * rows + r) * spatial *
+                       align_channels +
+                   out_offC;
+      for (index_t p = 0; p < spatial; ++p) {
+        dst[p * align_channels] = elem_cast<out_t>(src[p * align_channels]);
+      }
+    }
+  }
+  return 0;
+}
+
+// 检查索引形状并计算输出形状，返回C轴多维索引时的行数（除最后一维外的元素数）；
+// 返回0表示可直接复用展平索引的kernel，返回-1表示参数错误
+std::int64_t gather_hwc_nd_prepare(std::vector<int> &out_shape_hwc,
+                                   const std::vector<int> &in_shape_hwc,
+                                   const std::vector<int> &indices,
+                                   const std::vector<int> &indices_shape,
+                                   int axis_chw) {
+  if (shape_numel(indices_shape) != static_cast<std::int64_t>(indices.size())) {
+    std::cerr << "索引形状与索引数量不匹配：" << indices.size() << std::endl;
+    return -1;
+  }
+  if (gather_hwc_out_shape(out_shape_hwc, in_shape_hwc, indices_shape,
+                           axis_chw) != 0) {
+    return -1;
+  }
+  int rank = in_shape_hwc.size();
+  if (chw_axis_to_hwc(axis_chw, rank) != rank - 1 ||
+      indices_shape.size() <= 1 || indices.empty()) {
+    return 0;
+  }
+  return indices.size() / indices_shape.back();
+}
+
+// 软件预取参数：每个源切片最多预取开头kPrefetchHeadBytes字节（更长的切片在开头
+// 之后由硬件预取接管），自动选择距离时希望提前kPrefetchAheadBytes字节发出预取
+constexpr std::size_t kCacheLineBytes = 64;
+constexpr std::size_t kPrefetchHeadBytes = 1024;
+constexpr std::size_t kPrefetchAheadBytes = 4096;
+constexpr int kMaxPrefetchDistance = 16;
+
+inline void prefetch_head(const void *p, std::size_t bytes) {
+  const char *c = static_cast<const char *>(p);
+  bytes = std::min(bytes, kPrefetchHeadBytes);
+  for (std::size_t off = 0; off < bytes; off += kCacheLineBytes) {
+    __builtin_prefetch(c + off, 0, 0);
+  }
+}
+
+// 非C轴gather：每个输出切片是一段连续的源切片（N/D/H轴为整块，W轴为一个像素的
+// align_channels个通道）。按(外层, 索引)展平的顺序复制，复制第j个切片前预取
+// 第j+distance个切片的源地址，跨外层（通道块、批次等）时预取下一外层的切片
+template <typename out_t, typename in_t, typename index_t,
+          typename Copy = RvvCopy<out_t, in_t>, typename OutVec,
+          typename InVec>
+int gather_hwc_slices_prefetch_rvv(OutVec &output,
+                                   const InVec &input,
+                                   const std::vector<int> &in_shape_hwc,
+                                   const std::vector<int> &indices,
+                                   int axis_hwc, int align_channels,
+                                   int distance) {
+  const int rank = in_shape_hwc.size();
+  const index_t dim = in_shape_hwc[axis_hwc];
+  const index_t out_n = indices.size();
+  index_t slice = align_channels;
+  for (int d = axis_hwc + 1; d < rank - 1; ++d) {
+    slice *= in_shape_hwc[d];
+  }
+  index_t outer =
+      padded_channels(in_shape_hwc[rank - 1], align_channels) / align_channels;
+  for (int d = 0; d < axis_hwc; ++d) {
+    outer *= in_shape_hwc[d];
+  }
+
+  std::vector<index_t> src(out_n);
+  for (index_t i = 0; i < out_n; ++i) {
+    index_t idx = indices[i] >= 0 ? indices[i] : indices[i] + dim;
+    if (idx < 0 || idx >= dim) {
+      std::cerr << "索引越界：" << indices[i] << std::endl;
+      return -1;
+    }
+    src[i] = idx * slice;
+  }
+  output.resize(outer * out_n * slice, out_t());
+  if (out_n == 0 || slice == 0) {
+    return 0;
+  }
+
+  const std::size_t slice_bytes = slice * sizeof(in_t);
+  if (distance <= 0) {
+    distance = gather_prefetch_distance(slice_bytes);
+  }
+  const index_t in_stride = dim * slice;
+  const in_t *in = input.data();
+  out_t *out = output.data();
+
+  // 预取位置(ahead_o, ahead_i)始终领先当前位置distance个切片
+  index_t ahead_o = 0;
+  index_t ahead_i = 0;
+  for (int k = 0; k < distance && ahead_o < outer; ++k) {
+    prefetch_head(in + ahead_o * in_stride + src[ahead_i], slice_bytes);
+    if (++ahead_i == out_n) {
+      ahead_i = 0;
+      ++ahead_o;
+    }
+  }
+  for (index_t o = 0; o < outer; ++o) {
+    const in_t *in_o = in + o * in_stride;
+    for (index_t i = 0; i < out_n; ++i) {
+      if (ahead_o < outer) {
+        prefetch_head(in + ahead_o * in_stride + src[ahead_i], slice_bytes);
+        if (++ahead_i == out_n) {
+          ahead_i = 0;
+          ++ahead_o;
+        }
+      }
+      const in_t *s = in_o + src[i];
+      std::size_t n = slice;
+      while (n > 0) {
+        std::size_t vl = Copy::setvl(n);
+        Copy::copy(out, s, vl);
+        s += vl;
+        out += vl;
+        n -= vl;
+      }
+    }
+  }
+  return 0;
+}
+} // namespace
+
+int gather_prefetch_distance(std::size_t slice_bytes) {
+  std::size_t head = std::min(slice_bytes, kPrefetchHeadBytes);
+  if (head == 0) {
+    return 1;
+  }
+  std::size_t distance = (kPrefetchAheadBytes + head - 1) / head;
+  return static_cast<int>(std::min<std::size_t>(
+      std::max<std::size_t>(distance, 1), kMaxPrefetchDistance));
+}
+
+// 支持的(输出类型, 输入类型)组合：float、16位存储、8位量化数据和融合精度转换
+#define GATHER_HWC_INSTANTIATE(out_t, in_t)                                   \
+  template int gather_hwc<out_t, in_t>(                                        \
+      std::vector<out_t> &, const std::vector<in_t> &,                         \
+      const std::vector<int> &, const std::vector<int> &, int, int);           \
+  template int gather_hwc<out_t, in_t>(                                        \
+      AlignedVector<out_t> &, const AlignedVector<in_t> &,                     \
+      const std::vector<int> &, const std::vector<int> &, int, int);           \
+  template int gather_hwc<out_t, in_t>(                                        \
+      std::vector<out_t> &, std::vector<int> &, const std::vector<in_t> &,     \
+      const std::vector<int> &, const std::vector<int> &,                      \
+      const std::vector<int> &, int, int);
+
+namespace rvv {
+namespace {
+// 展平索引的入口实现，OutVec/InVec为std::vector或AlignedVector
+template <typename out_t, typename in_t, typename OutVec, typename InVec>
+int gather_hwc_flat(OutVec &output, const InVec &input,
+                    const std::vector<int> &in_shape_hwc,
+                    const std::vector<int> &indices, int axis_chw,
+                    int align_channels) {
+  if (in_shape_hwc.size() < 3 || in_shape_hwc.size() > 5) {
+    std::cerr << "无效的输入形状：" << in_shape_hwc.size() << std::endl;
+    return -1;
+  }
+  bool small = gather_hwc_fits_int32(input.size(), in_shape_hwc, indices,
+                                     axis_chw, align_channels);
+  int lmul = gather_hwc_tune(in_shape_hwc, axis_chw, align_channels,
+                             sizeof(in_t)).lmul;
+  return with_rvv_lmul<out_t, in_t>(lmul, [&](auto copy) {
+    using Copy = decltype(copy);
+    if (in_shape_hwc.size() == 4) {
+      return small ? gather_hwc_batch_rvv<out_t, in_t, std::int32_t, Copy>(
+                         output, input, in_shape_hwc, indices, axis_chw,
+                         align_channels)
+                   : gather_hwc_batch_rvv<out_t, in_t, std::int64_t, Copy>(
+                         output, input, in_shape_hwc, indices, axis_chw,
+                         align_channels);
+    } else if (in_shape_hwc.size() == 5) {
+      return small ? gather_hwc_batch5d_rvv<out_t, in_t, std::int32_t, Copy>(
+                         output, input, in_shape_hwc, indices, axis_chw,
+                         align_channels)
+                   : gather_hwc_batch5d_rvv<out_t, in_t, std::int64_t, Copy>(
+                         output, input, in_shape_hwc, indices, axis_chw,
+                         align_channels);
+    }
+    return small ? gather_hwc_3d_rvv<out_t, in_t, std::int32_t, Copy>(
+                       output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels)
+                 : gather_hwc_3d_rvv<out_t, in_t, std::int64_t, Copy>(
+                       output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels);
+  });
+}
+} // namespace
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, const std::vector<in_t> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc_flat<out_t, in_t>(output, input, in_shape_hwc, indices,
+                                      axis_chw, align_channels);
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc(AlignedVector<out_t> &output,
+               const AlignedVector<in_t> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc_flat<out_t, in_t>(output, input, in_shape_hwc, indices,
+                                      axis_chw, align_channels);
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, std::vector<int> &out_shape_hwc,
+               const std::vector<in_t> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices,
+               const std::vector<int> &indices_shape, int axis_chw,
+               int align_channels) {
+  std::int64_t rows = gather_hwc_nd_prepare(out_shape_hwc, in_shape_hwc,
+                                            indices, indices_shape, axis_chw);
+  if (rows <= 0) {
+    return rows < 0 ? -1
+                    : gather_hwc<out_t, in_t>(output, input, in_shape_hwc,
+                                              indices, axis_chw,
+                                              align_channels);
+  }
+  bool small = fits_int32(input.size()) &&
+               fits_int32(blocked_numel(out_shape_hwc, align_channels));
+  int lmul = gather_hwc_tune(in_shape_hwc, axis_chw, align_channels,
+                             sizeof(in_t)).lmul;
+  return with_rvv_lmul<out_t, in_t>(lmul, [&](auto copy) {
+    using Copy = decltype(copy);
+    return small ? gather_hwc_channel_nd_rvv<out_t, in_t, std::int32_t, Copy>(
+                       output, input, in_shape_hwc, indices, rows,
+                       align_channels)
+                 : gather_hwc_channel_nd_rvv<out_t, in_t, std::int64_t, Copy>(
+                       output, input, in_shape_hwc, indices, rows,
+                       align_channels);
+  });
+}
+
+int gather_hwc(std::vector<float> &output, const std::vector<float> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc<float, float>(output, input, in_shape_hwc, indices,
+                                  axis_chw, align_channels);
+}
+
+int gather_hwc(AlignedVector<float> &output, const AlignedVector<float> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc<float, float>(output, input, in_shape_hwc, indices,
+                                  axis_chw, align_channels);
+}
+
+int gather_hwc(std::vector<float> &output, std::vector<int> &out_shape_hwc,
+               const std::vector<float> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices,
+               const std::vector<int> &indices_shape, int axis_chw,
+               int align_channels) {
+  return gather_hwc<float, float>(output, out_shape_hwc, input, in_shape_hwc,
+                                  indices, indices_shape, axis_chw,
+                                  align_channels);
+}
+
+GATHER_HWC_INSTANTIATE(float, float)
+GATHER_HWC_INSTANTIATE(float16, float16)
+GATHER_HWC_INSTANTIATE(bfloat16, bfloat16)
+GATHER_HWC_INSTANTIATE(float, float16)
+GATHER_HWC_INSTANTIATE(float16, float)
+GATHER_HWC_INSTANTIATE(float, bfloat16)
+GATHER_HWC_INSTANTIATE(bfloat16, float)
+GATHER_HWC_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_HWC_INSTANTIATE(std::uint8_t, std::uint8_t)
+
+template <typename out_t, typename in_t>
+int gather_hwc_prefetch(std::vector<out_t> &output,
+                        const std::vector<in_t> &input,
+                        const std::vector<int> &in_shape_hwc,
+                        const std::vector<int> &indices, int axis_chw,
+                        int align_channels, int prefetch_distance) {
+  int rank = in_shape_hwc.size();
+  if (rank < 3 || rank > 5) {
+    std::cerr << "无效的输入形状：" << rank << std::endl;
+    return -1;
+  }
+  if (axis_chw < 0 || axis_chw >= rank) {
+    std::cerr << "无效的axis：" << axis_chw << std::endl;
+    return -1;
+  }
+  int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  if (axis_hwc == rank - 1) {
+    // C轴按像素跨步读取，访问模式规则，不做软件预取
+    return gather_hwc<out_t, in_t>(output, input, in_shape_hwc, indices,
+                                   axis_chw, align_channels);
+  }
+  bool small = gather_hwc_fits_int32(input.size(), in_shape_hwc, indices,
+                                     axis_chw, align_channels);
+  GatherTuneEntry tune = gather_hwc_tune(in_shape_hwc, axis_chw,
+                                         align_channels, sizeof(in_t));
+  if (prefetch_distance <= 0) {
+    // 未指定时先用调优缓存记录的距离，仍为0时由内核按切片大小选择
+    prefetch_distance = tune.prefetch_distance;
+  }
+  int lmul = tune.lmul;
+  return with_rvv_lmul<out_t, in_t>(lmul, [&](auto copy) {
+    using Copy = decltype(copy);
+    return small
+               ? gather_hwc_slices_prefetch_rvv<out_t, in_t, std::int32_t,
+                                                Copy>(
+                     output, input, in_shape_hwc, indices, axis_hwc,
+                     align_channels, prefetch_distance)
+               : gather_hwc_slices_prefetch_rvv<out_t, in_t, std::int64_t,
+                                                Copy>(
+                     output, input, in_shape_hwc, indices, axis_hwc,
+                     align_channels, prefetch_distance);
+  });
+}
+
+#define GATHER_HWC_PREFETCH_INSTANTIATE(out_t, in_t)                          \
+  template int gather_hwc_prefetch<out_t, in_t>(                               \
+      std::vector<out_t> &, const std::vector<in_t> &,                         \
+      const std::vector<int> &, const std::vector<int> &, int, int, int);
+
+GATHER_HWC_PREFETCH_INSTANTIATE(float, float)
+GATHER_HWC_PREFETCH_INSTANTIATE(float16, float16)
+GATHER_HWC_PREFETCH_INSTANTIATE(bfloat16, bfloat16)
+GATHER_HWC_PREFETCH_INSTANTIATE(float, float16)
+GATHER_HWC_PREFETCH_INSTANTIATE(float16, float)
+GATHER_HWC_PREFETCH_INSTANTIATE(float, bfloat16)
+GATHER_HWC_PREFETCH_INSTANTIATE(bfloat16, float)
+GATHER_HWC_PREFETCH_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_HWC_PREFETCH_INSTANTIATE(std::uint8_t, std::uint8_t)
+#undef GATHER_HWC_PREFETCH_INSTANTIATE
+} // namespace rvv
+
+namespace mem {
+namespace {
+// 展平索引的入口实现，OutVec/InVec为std::vector或AlignedVector
+template <typename out_t, typename in_t, typename OutVec, typename InVec>
+int gather_hwc_flat(OutVec &output, const InVec &input,
+                    const std::vector<int> &in_shape_hwc,
+                    const std::vector<int> &indices, int axis_chw,
+                    int align_channels) {
+  if (in_shape_hwc.size() < 3 || in_shape_hwc.size() > 5) {
+    std::cerr << "无效的输入形状：" << in_shape_hwc.size() << std::endl;
+    return -1;
+  }
+  bool small = gather_hwc_fits_int32(input.size(), in_shape_hwc, indices,
+                                     axis_chw, align_channels);
+  if (in_shape_hwc.size() == 4) {
+    return small ? gather_hwc_batch_mem<out_t, in_t, std::int32_t>(
+                       output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels)
+                 : gather_hwc_batch_mem<out_t, in_t, std::int64_t>(
+                       output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels);
+  } else if (in_shape_hwc.size() == 5) {
+    return small ? gather_hwc_batch5d_mem<out_t, in_t, std::int32_t>(
+                       output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels)
+                 : gather_hwc_batch5d_mem<out_t, in_t, std::int64_t>(
+                       output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels);
+  }
+  return small ? gather_hwc_3d_mem<out_t, in_t, std::int32_t>(
+                     output, input, in_shape_hwc, indices, axis_chw,
+                     align_channels)
+               : gather_hwc_3d_mem<out_t, in_t, std::int64_t>(
+                     output, input, in_shape_hwc, indices, axis_chw,
+                     align_channels);
+}
+} // namespace
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, const std::vector<in_t> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc_flat<out_t, in_t>(output, input, in_shape_hwc, indices,
+                                      axis_chw, align_channels);
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc(AlignedVector<out_t> &output,
+               const AlignedVector<in_t> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc_flat<out_t, in_t>(output, input, in_shape_hwc, indices,
+                                      axis_chw, align_channels);
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, std::vector<int> &out_shape_hwc,
+               const std::vector<in_t> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices,
+               const std::vector<int> &indices_shape, int axis_chw,
+               int align_channels) {
+  std::int64_t rows = gather_hwc_nd_prepare(out_shape_hwc, in_shape_hwc,
+                                            indices, indices_shape, axis_chw);
+  if (rows <= 0) {
+    return rows < 0 ? -1
+                    : gather_hwc<out_t, in_t>(output, input, in_shape_hwc,
+                                              indices, axis_chw,
+                                              align_channels);
+  }
+  if (fits_int32(input.size()) &&
+      fits_int32(blocked_numel(out_shape_hwc, align_channels))) {
+    return gather_hwc_channel_nd_mem<out_t, in_t, std::int32_t>(
+        output, input, in_shape_hwc, indices, rows, align_channels);
+  }
+  return gather_hwc_channel_nd_mem<out_t, in_t, std::int64_t>(
+      output, input, in_shape_hwc, indices, rows, align_channels);
+}
+
+int gather_hwc(std::vector<float> &output, const std::vector<float> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc<float, float>(output, input, in_shape_hwc, indices,
+                                  axis_chw, align_channels);
+}
+
+int gather_hwc(AlignedVector<float> &output, const AlignedVector<float> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices, int axis_chw,
+               int align_channels) {
+  return gather_hwc<float, float>(output, input, in_shape_hwc, indices,
+                                  axis_chw, align_channels);
+}
+
+int gather_hwc(std::vector<float> &output, std::vector<int> &out_shape_hwc,
+               const std::vector<float> &input,
+               const std::vector<int> &in_shape_hwc,
+               const std::vector<int> &indices,
+               const std::vector<int> &indices_shape, int axis_chw,
+               int align_channels) {
+  return gather_hwc<float, float>(output, out_shape_hwc, input, in_shape_hwc,
+                                  indices, indices_shape, axis_chw,
+                                  align_channels);
+}
+
+GATHER_HWC_INSTANTIATE(float, float)
+GATHER_HWC_INSTANTIATE(float16, float16)
+GATHER_HWC_INSTANTIATE(bfloat16, bfloat16)
+GATHER_HWC_INSTANTIATE(float, float16)
+GATHER_HWC_INSTANTIATE(float16, float)
+GATHER_HWC_INSTANTIATE(float, bfloat16)
+GATHER_HWC_INSTANTIATE(bfloat16, float)
+GATHER_HWC_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_HWC_INSTANTIATE(std::uint8_t, std::uint8_t)
 } // namespace mem
+
+#undef GATHER_HWC_INSTANTIATE
@@ -1,12 +1,69 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
+#include "aligned_buffer.h"
+#include "elem_type.h"
+
+// 软件预取距离（以源切片为单位）的自动选择：切片越小距离越大，
+// 使提前量约为4KB，上限16
+int gather_prefetch_distance(std::size_t slice_bytes);
+
 namespace rvv {
 int gather_hwc(std::vector<float>& output, const std::vector<float>& input,
                const std::vector<int>& in_shape_hwc,
                const std::vector<int>& indices, int axis_chw,
                int align_channels);
+
+// 多维索引（ONNX Gather语义），out_shape_hwc返回分块HWC顺序的输出形状
+int gather_hwc(std::vector<float>& output, std::vector<int>& out_shape_hwc,
+               const std::vector<float>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis_chw,
+               int align_channels);
+
+// 16位存储（float16/bfloat16）及融合精度转换：out_t与in_t相同时按位搬运，
+// 不同时在写出时转换，支持float与float16/bfloat16之间互转；
+// int8_t/uint8_t量化数据只支持同类型搬运，量化参数见gather_quant.h
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t>& output, const std::vector<in_t>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices, int axis_chw,
+               int align_channels);
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t>& output, std::vector<int>& out_shape_hwc,
+               const std::vector<in_t>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis_chw,
+               int align_channels);
+
+// 对齐缓冲区版本（见aligned_buffer.h），类型组合与上面相同（含float）
+int gather_hwc(AlignedVector<float>& output, const AlignedVector<float>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices, int axis_chw,
+               int align_channels);
+
+template <typename out_t, typename in_t>
+int gather_hwc(AlignedVector<out_t>& output, const AlignedVector<in_t>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices, int axis_chw,
+               int align_channels);
+
+// 带软件预取的gather_hwc：非C轴（N/D/H/W）每个索引对应一段位置不可预测的源切片，
+// 复制第i个切片时预取第i+prefetch_distance个切片的开头。
+// prefetch_distance<=0时先用调优缓存的记录（gather_tune.h），没有记录时
+// 按切片大小自动选择（gather_prefetch_distance）；
+// C轴与gather_hwc相同。类型组合与gather_hwc相同（含float）
+template <typename out_t, typename in_t>
+int gather_hwc_prefetch(std::vector<out_t>& output,
+                        const std::vector<in_t>& input,
+                        const std::vector<int>& in_shape_hwc,
+                        const std::vector<int>& indices, int axis_chw,
+                        int align_channels, int prefetch_distance = 0);
 }
 
 namespace mem {
@@ -14,4 +71,38 @@ int gather_hwc(std::vector<float>& output, const std::vector<float>& input,
                const std::vector<int>& in_shape_hwc,
                const std::vector<int>& indices, int axis_chw,
                int align_channels);
+
+// 多维索引（ONNX Gather语义），out_shape_hwc返回分块HWC顺序的输出形状
+int gather_hwc(std::vector<float>& output, std::vector<int>& out_shape_hwc,
+               const std::vector<float>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis_chw,
+               int align_channels);
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t>& output, const std::vector<in_t>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices, int axis_chw,
+               int align_channels);
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t>& output, std::vector<int>& out_shape_hwc,
+               const std::vector<in_t>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis_chw,
+               int align_channels);
+
+// 对齐缓冲区版本（见aligned_buffer.h），类型组合与上面相同（含float）
+int gather_hwc(AlignedVector<float>& output, const AlignedVector<float>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices, int axis_chw,
+               int align_channels);
+
+template <typename out_t, typename in_t>
+int gather_hwc(AlignedVector<out_t>& output, const AlignedVector<in_t>& input,
+               const std::vector<int>& in_shape_hwc,
+               const std::vector<int>& indices, int axis_chw,
+               int align_channels);
 }
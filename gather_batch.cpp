@@ -0,0 +1,230 @@
+#include "gather_batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <set>
+#include <thread>
+
+namespace {
+// 每个线程至少分到的搬运元素数，总量太小时不值得创建线程
+constexpr std::int64_t kMinWorkPerThread = 1 << 15;
+// 每个线程平均分到的任务数，任务越多负载越均衡、领取开销越大
+constexpr std::int64_t kTasksPerThread = 4;
+// 单个任务至少搬运的元素数
+constexpr std::int64_t kMinWorkPerTask = 1 << 12;
+
+int resolve_threads(int num_threads, std::int64_t work) {
+  if (num_threads <= 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  std::int64_t useful = std::max<std::int64_t>(work / kMinWorkPerThread, 1);
+  return static_cast<int>(
+      std::max<std::int64_t>(std::min<std::int64_t>(num_threads, useful), 1));
+}
+
+// 执行前的检查：计划与任务数一致、输入大小与计划一致、输出互不相同且不是输入，
+// 通过后分配全部输出
+template <typename out_t, typename in_t>
+int check_batch_jobs(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     const GatherBatchPlan& batch) {
+  if (jobs.size() != batch.plans.size()) {
+    std::cerr << "批量gather的任务数与计划不匹配：" << jobs.size()
+              << std::endl;
+    return -1;
+  }
+  std::set<const void*> inputs, outputs;
+  for (const auto& job : jobs) {
+    inputs.insert(job.input);
+  }
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    const auto& job = jobs[i];
+    if (static_cast<std::int64_t>(job.input->size()) !=
+        batch.plans[i].input_numel) {
+      std::cerr << "批量gather第" << i
+                << "项的输入元素数与计划不匹配：" << job.input->size()
+                << std::endl;
+      return -1;
+    }
+    if (!outputs.insert(job.output).second || inputs.count(job.output) != 0) {
+      std::cerr << "批量gather第" << i << "项的输出与其他项重叠" << std::endl;
+      return -1;
+    }
+  }
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    jobs[i].output->resize(batch.plans[i].output_numel);
+  }
+  return 0;
+}
+
+// num_threads个线程（含当前线程）按调度表顺序领取任务
+template <typename Fn>
+int run_batch_tasks(const GatherBatchPlan& batch, Fn fn) {
+  std::atomic<std::size_t> next{0};
+  std::atomic<int> status{0};
+  auto worker = [&]() {
+    for (std::size_t t = next++; t < batch.tasks.size(); t = next++) {
+      const GatherBatchTask& task = batch.tasks[t];
+      if (fn(task) != 0) {
+        status = -1;
+      }
+    }
+  };
+  int threads = std::min<std::size_t>(batch.num_threads, batch.tasks.size());
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& w : workers) {
+    w.join();
+  }
+  return status;
+}
+}  // namespace
+
+template <typename out_t, typename in_t>
+int prepare_gather_batch(GatherBatchPlan& batch,
+                         const std::vector<GatherJob<out_t, in_t>>& jobs,
+                         int num_threads) {
+  batch.plans.assign(jobs.size(), GatherPlan());
+  batch.tasks.clear();
+  std::int64_t total = 0;
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    const auto& job = jobs[i];
+    if (job.input == nullptr || job.output == nullptr ||
+        prepare_gather_hwc(batch.plans[i], job.in_shape_hwc, job.indices,
+                           job.axis_chw, job.align_channels) != 0) {
+      std::cerr << "批量gather第" << i << "项参数错误" << std::endl;
+      batch.plans.clear();
+      return -1;
+    }
+    total += batch.plans[i].output_numel;
+  }
+  batch.num_threads = resolve_threads(num_threads, total);
+
+  // 每项按重复次数（outer切片或输出像素）切成不小于目标大小的任务
+  std::int64_t target = std::max(
+      total / (batch.num_threads * kTasksPerThread), kMinWorkPerTask);
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    const GatherPlan& plan = batch.plans[i];
+    if (plan.repeat == 0 || plan.output_numel == 0) {
+      continue;
+    }
+    std::int64_t unit = std::max<std::int64_t>(plan.output_numel / plan.repeat,
+                                               1);
+    std::int64_t step = std::max<std::int64_t>(target / unit, 1);
+    for (std::int64_t begin = 0; begin < plan.repeat; begin += step) {
+      batch.tasks.push_back({static_cast<int>(i), begin,
+                             std::min(plan.repeat, begin + step)});
+    }
+  }
+  // 大任务先领取，最后剩下的小任务填补各线程的空闲
+  auto task_size = [&](const GatherBatchTask& t) {
+    const GatherPlan& plan = batch.plans[t.job];
+    return plan.output_numel / plan.repeat * (t.end - t.begin);
+  };
+  std::stable_sort(batch.tasks.begin(), batch.tasks.end(),
+                   [&](const GatherBatchTask& a, const GatherBatchTask& b) {
+                     return task_size(a) > task_size(b);
+                   });
+  return 0;
+}
+
+// 支持的(输出类型, 输入类型)组合，与gather_hwc相同
+#define GATHER_BATCH_INSTANTIATE(out_t, in_t)                                  \
+  template int gather_hwc_batch<out_t, in_t>(                                  \
+      const std::vector<GatherJob<out_t, in_t>>&, const GatherBatchPlan&);     \
+  template int gather_hwc_batch<out_t, in_t>(                                  \
+      const std::vector<GatherJob<out_t, in_t>>&, int);
+
+#define GATHER_BATCH_PREPARE_INSTANTIATE(out_t, in_t)                          \
+  template int prepare_gather_batch<out_t, in_t>(                              \
+      GatherBatchPlan&, const std::vector<GatherJob<out_t, in_t>>&, int);
+
+GATHER_BATCH_PREPARE_INSTANTIATE(float, float)
+GATHER_BATCH_PREPARE_INSTANTIATE(float16, float16)
+GATHER_BATCH_PREPARE_INSTANTIATE(bfloat16, bfloat16)
+GATHER_BATCH_PREPARE_INSTANTIATE(float, float16)
+GATHER_BATCH_PREPARE_INSTANTIATE(float16, float)
+GATHER_BATCH_PREPARE_INSTANTIATE(float, bfloat16)
+GATHER_BATCH_PREPARE_INSTANTIATE(bfloat16, float)
+GATHER_BATCH_PREPARE_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_BATCH_PREPARE_INSTANTIATE(std::uint8_t, std::uint8_t)
+
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     const GatherBatchPlan& batch) {
+  if (check_batch_jobs(jobs, batch) != 0) {
+    return -1;
+  }
+  return run_batch_tasks(batch, [&](const GatherBatchTask& task) {
+    const auto& job = jobs[task.job];
+    return gather_hwc_range<out_t, in_t>(job.output->data(),
+                                         job.input->data(),
+                                         batch.plans[task.job], task.begin,
+                                         task.end);
+  });
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     int num_threads) {
+  GatherBatchPlan batch;
+  if (prepare_gather_batch(batch, jobs, num_threads) != 0) {
+    return -1;
+  }
+  return gather_hwc_batch(jobs, batch);
+}
+
+GATHER_BATCH_INSTANTIATE(float, float)
+GATHER_BATCH_INSTANTIATE(float16, float16)
+GATHER_BATCH_INSTANTIATE(bfloat16, bfloat16)
+GATHER_BATCH_INSTANTIATE(float, float16)
+GATHER_BATCH_INSTANTIATE(float16, float)
+GATHER_BATCH_INSTANTIATE(float, bfloat16)
+GATHER_BATCH_INSTANTIATE(bfloat16, float)
+GATHER_BATCH_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_BATCH_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     const GatherBatchPlan& batch) {
+  if (check_batch_jobs(jobs, batch) != 0) {
+    return -1;
+  }
+  return run_batch_tasks(batch, [&](const GatherBatchTask& task) {
+    const auto& job = jobs[task.job];
+    return gather_hwc_range<out_t, in_t>(job.output->data(),
+                                         job.input->data(),
+                                         batch.plans[task.job], task.begin,
+                                         task.end);
+  });
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     int num_threads) {
+  GatherBatchPlan batch;
+  if (prepare_gather_batch(batch, jobs, num_threads) != 0) {
+    return -1;
+  }
+  return gather_hwc_batch(jobs, batch);
+}
+
+GATHER_BATCH_INSTANTIATE(float, float)
+GATHER_BATCH_INSTANTIATE(float16, float16)
+GATHER_BATCH_INSTANTIATE(bfloat16, bfloat16)
+GATHER_BATCH_INSTANTIATE(float, float16)
+GATHER_BATCH_INSTANTIATE(float16, float)
+GATHER_BATCH_INSTANTIATE(float, bfloat16)
+GATHER_BATCH_INSTANTIATE(bfloat16, float)
+GATHER_BATCH_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_BATCH_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace mem
+
+#undef GATHER_BATCH_INSTANTIATE
+#undef GATHER_BATCH_PREPARE_INSTANTIATE
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "elem_type.h"
+#include "gather_plan.h"
+
+// 批量gather的一项：对分块HWC张量input沿axis_chw按indices（展平）gather到
+// output，参数含义与gather_hwc相同。input/output由调用者持有，执行期间
+// 必须保持有效；不同项的output不能相同，也不能是任何一项的input
+template <typename out_t, typename in_t>
+struct GatherJob {
+  std::vector<out_t>* output;
+  const std::vector<in_t>* input;
+  std::vector<int> in_shape_hwc;
+  std::vector<int> indices;
+  int axis_chw;
+  int align_channels;
+};
+
+// 调度表中的一个任务：第job项计划的第[begin, end)次重复（见gather_hwc_range）
+struct GatherBatchTask {
+  int job;
+  std::int64_t begin;
+  std::int64_t end;
+};
+
+// 一批gather的预编译计划：每一项的GatherPlan（校验、axis映射和偏移已完成），
+// 以及把全部搬运切成大小相近的任务、按从大到小排列的调度表。
+// 形状、索引和线程数不变时跨帧复用，只需准备一次
+struct GatherBatchPlan {
+  std::vector<GatherPlan> plans;
+  std::vector<GatherBatchTask> tasks;
+  int num_threads = 1;
+};
+
+// 准备批量计划：逐项校验全部参数，任一项出错时报告项号并返回-1。
+// num_threads<=0时使用全部硬件线程，总数据量小时自动减少线程数
+template <typename out_t, typename in_t>
+int prepare_gather_batch(GatherBatchPlan& batch,
+                         const std::vector<GatherJob<out_t, in_t>>& jobs,
+                         int num_threads);
+
+// 按批量计划执行：先检查全部输入大小与输出是否重叠并分配全部输出，
+// 再由各线程按调度表动态领取任务（小张量不必排在大张量之后等待）。
+// 检查不通过时返回-1且不写任何输出。类型组合与gather_hwc相同（含float）
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     const GatherBatchPlan& batch);
+
+// 准备计划后立即执行
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     int num_threads);
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     const GatherBatchPlan& batch);
+
+template <typename out_t, typename in_t>
+int gather_hwc_batch(const std::vector<GatherJob<out_t, in_t>>& jobs,
+                     int num_threads);
+}  // namespace mem
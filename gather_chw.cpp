@@ -2,78 +2,339 @@
 
 #include <riscv_vector.h>
 
+#include <cstdint>
 #include <cstring>
+#include <iostream>
 #include <numeric>
 
+#include "gather_tune.h"
+#include "rvv_elem.h"
+#include "rvv_tune.h"
+#include "tensor_util.h"
+
+namespace {
+// ONNX Gather语义的输出形状：in[:axis] + indices.shape + in[axis+1:]
+// CHW布局下输出内存与展平索引的结果一致，只需给出形状
+int gather_chw_out_shape(std::vector<int>& out_shape,
+                         const std::vector<int>& in_shape,
+                         const std::vector<int>& indices,
+                         const std::vector<int>& indices_shape, int axis) {
+  if (axis < 0 || axis >= static_cast<int>(in_shape.size())) {
+    std::cerr << "无效的axis：" << axis << std::endl;
+    return -1;
+  }
+  if (shape_numel(indices_shape) != static_cast<std::int64_t>(indices.size())) {
+    std::cerr << "索引形状与索引数量不匹配：" << indices.size() << std::endl;
+    return -1;
+  }
+  out_shape.assign(in_shape.begin(), in_shape.begin() + axis);
+  out_shape.insert(out_shape.end(), indices_shape.begin(),
+                   indices_shape.end());
+  out_shape.insert(out_shape.end(), in_shape.begin() + axis + 1,
+                   in_shape.end());
+  return 0;
+}
+
+// block_size小于该值时（典型为最后一维上的gather，block_size == 1）改走整行的
+// 小块内核，避免每个输出元素一次vsetvl循环或一次memcpy
+constexpr std::size_t kSmallBlockSize = 4;
+
+// 一个outer切片内每个输出元素对应的输入元素位置（单位为元素）
+template <typename index_t>
+std::vector<index_t> small_block_sources(const std::vector<int>& indices,
+                                         int dim, std::size_t block_size) {
+  std::vector<index_t> src(indices.size() * block_size);
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    index_t idx = indices[i] >= 0 ? indices[i] : indices[i] + dim;
+    for (std::size_t b = 0; b < block_size; ++b) {
+      src[i * block_size + b] = idx * block_size + b;
+    }
+  }
+  return src;
+}
+
+// 标量小块内核：按预先算好的源位置表逐元素搬运（可做精度转换）
+template <typename out_t, typename in_t>
+void gather_small_block_scalar(out_t* out_ptr, const in_t* in_ptr,
+                               const std::vector<std::size_t>& src,
+                               std::size_t outer_count, std::size_t in_row) {
+  const std::size_t out_row = src.size();
+  for (std::size_t o = 0; o < outer_count; ++o) {
+    for (std::size_t j = 0; j < out_row; ++j) {
+      out_ptr[j] = elem_cast<out_t>(in_ptr[src[j]]);
+    }
+    in_ptr += in_row;
+    out_ptr += out_row;
+  }
+}
+
+// RVV小块内核：同类型搬运时把一整行索引换算成字节偏移表，每个outer切片用
+// vluxei32索引加载一次取vl个元素；类型转换组合或一行超出32位字节偏移时走标量
+template <typename out_t, typename in_t>
+void gather_small_block_rvv(out_t* out_ptr, const in_t* in_ptr,
+                            const std::vector<int>& indices, int dim,
+                            std::size_t block_size, std::size_t outer_count) {
+  using Gather = RvvGather<out_t, in_t>;
+  const std::size_t in_row = dim * block_size;
+  if (!Gather::supported || !fits_int32(in_row * sizeof(in_t))) {
+    gather_small_block_scalar(
+        out_ptr, in_ptr,
+        small_block_sources<std::size_t>(indices, dim, block_size),
+        outer_count, in_row);
+    return;
+  }
+  std::vector<std::uint32_t> offsets =
+      small_block_sources<std::uint32_t>(indices, dim, block_size);
+  for (std::uint32_t& off : offsets) {
+    off *= sizeof(in_t);
+  }
+  const std::size_t out_row = offsets.size();
+  for (std::size_t o = 0; o < outer_count; ++o) {
+    const std::uint32_t* off = offsets.data();
+    out_t* dst = out_ptr;
+    std::size_t n = out_row;
+    while (n > 0) {
+      std::size_t vl = Gather::setvl(n);
+      Gather::gather(dst, in_ptr, off, vl);
+      off += vl;
+      dst += vl;
+      n -= vl;
+    }
+    in_ptr += in_row;
+    out_ptr += out_row;
+  }
+}
+}  // namespace
+
+// 支持的(输出类型, 输入类型)组合：float、16位存储、8位量化数据和融合精度转换
+#define GATHER_CHW_INSTANTIATE(out_t, in_t)                                  \
+  template int gather_chw<out_t, in_t>(                                       \
+      std::vector<out_t>&, const std::vector<in_t>&, const std::vector<int>&, \
+      const std::vector<int>&, int);                                          \
+  template int gather_chw<out_t, in_t>(                                       \
+      AlignedVector<out_t>&, const AlignedVector<in_t>&,                      \
+      const std::vector<int>&, const std::vector<int>&, int);                 \
+  template int gather_chw<out_t, in_t>(                                       \
+      std::vector<out_t>&, std::vector<int>&, const std::vector<in_t>&,       \
+      const std::vector<int>&, const std::vector<int>&,                       \
+      const std::vector<int>&, int);
+
 namespace rvv {
-int gather_chw(std::vector<float>& output, const std::vector<float>& input,
-               const std::vector<int>& in_shape,
-               const std::vector<int>& indices, int axis) {
+namespace {
+// 展平索引的入口实现，OutVec/InVec为std::vector或AlignedVector
+template <typename out_t, typename in_t, typename OutVec, typename InVec>
+int gather_chw_flat(OutVec& output, const InVec& input,
+                    const std::vector<int>& in_shape,
+                    const std::vector<int>& indices, int axis) {
   size_t outer_count = std::accumulate(
-      in_shape.begin(), in_shape.begin() + axis, 1, std::multiplies<size_t>{});
+      in_shape.begin(), in_shape.begin() + axis, size_t{1},
+      std::multiplies<size_t>{});
   size_t indices_count = indices.size();
   size_t block_size =
-      std::accumulate(in_shape.begin() + axis + 1, in_shape.end(), 1,
+      std::accumulate(in_shape.begin() + axis + 1, in_shape.end(), size_t{1},
                       std::multiplies<size_t>{});
-  int output_size = input.size() * indices_count / in_shape[axis];
+  // 按64位计算输出大小，超过2^31个元素的张量不会溢出
+  size_t output_size = input.size() / in_shape[axis] * indices_count;
   output.resize(output_size);
   auto* in_ptr = input.data();
   auto* out_ptr = output.data();
+  if (block_size < kSmallBlockSize) {
+    gather_small_block_rvv(out_ptr, in_ptr, indices, in_shape[axis],
+                           block_size, outer_count);
+    return 0;
+  }
 
-  for (size_t o = 0; o < outer_count; ++o) {
-    for (size_t i = 0; i < indices_count; ++i) {
-      auto* o_ptr = out_ptr + i * block_size;
-      auto indices_ptr =
-          indices[i] >= 0 ? indices[i] : indices[i] + in_shape[axis];
-
-      size_t n = block_size;
-      auto input_start = in_ptr + (indices_ptr * block_size);
-      auto output_start = o_ptr;
-      while (n > 0) {
-        size_t vl = vsetvl_e32m8(n);
+  // 连续搬运block_size个元素，先查调优缓存（gather_chw的align_channels记为0，
+  // 见gather_tune.h），未命中时按LMUL表选择（见rvv_tune.h）
+  const size_t block_bytes = block_size * sizeof(in_t);
+  GatherTuneEntry tune;
+  gather_tune_find(tune, {static_cast<int>(in_shape.size()), axis, 0,
+                          rvv_size_class(block_bytes)});
+  int lmul = tune.lmul != 0 ? tune.lmul : rvv_lmul(kRvvContiguous, block_bytes);
+  return with_rvv_lmul<out_t, in_t>(lmul, [&](auto copy) {
+    using Copy = decltype(copy);
+    for (size_t o = 0; o < outer_count; ++o) {
+      for (size_t i = 0; i < indices_count; ++i) {
+        auto* o_ptr = out_ptr + i * block_size;
+        size_t indices_ptr =
+            indices[i] >= 0 ? indices[i] : indices[i] + in_shape[axis];
 
-        auto v_in = vle32_v_f32m8(input_start, vl);
-        vse32_v_f32m8(output_start, v_in, vl);
+        size_t n = block_size;
+        auto input_start = in_ptr + (indices_ptr * block_size);
+        auto output_start = o_ptr;
+        while (n > 0) {
+          size_t vl = Copy::setvl(n);
+          Copy::copy(output_start, input_start, vl);
 
-        // 更新指针和剩余数量
-        input_start += vl;
-        output_start += vl;
-        n -= vl;
+          // 更新指针和剩余数量
+          input_start += vl;
+          output_start += vl;
+          n -= vl;
+        }
       }
+      in_ptr += in_shape[axis] * block_size;
+      out_ptr += indices_count * block_size;
     }
-    in_ptr += in_shape[axis] * block_size;
-    out_ptr += indices_count * block_size;
+    return 0;
+  });
+}
+}  // namespace
+
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis) {
+  return gather_chw_flat<out_t, in_t>(output, input, in_shape, indices, axis);
+}
+
+template <typename out_t, typename in_t>
+int gather_chw(AlignedVector<out_t>& output, const AlignedVector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis) {
+  return gather_chw_flat<out_t, in_t>(output, input, in_shape, indices, axis);
+}
+
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, std::vector<int>& out_shape,
+               const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis) {
+  if (gather_chw_out_shape(out_shape, in_shape, indices, indices_shape, axis) !=
+      0) {
+    return -1;
   }
-  return 0;
+  return gather_chw<out_t, in_t>(output, input, in_shape, indices, axis);
 }
-}  // namespace rvv
 
-namespace mem {
 int gather_chw(std::vector<float>& output, const std::vector<float>& input,
                const std::vector<int>& in_shape,
                const std::vector<int>& indices, int axis) {
-  size_t outer_count = accumulate(in_shape.begin(), in_shape.begin() + axis, 1,
-                                  std::multiplies<size_t>{});
+  return gather_chw<float, float>(output, input, in_shape, indices, axis);
+}
+
+int gather_chw(std::vector<float>& output, std::vector<int>& out_shape,
+               const std::vector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis) {
+  return gather_chw<float, float>(output, out_shape, input, in_shape, indices,
+                                  indices_shape, axis);
+}
+
+int gather_chw(AlignedVector<float>& output, const AlignedVector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis) {
+  return gather_chw<float, float>(output, input, in_shape, indices, axis);
+}
+
+GATHER_CHW_INSTANTIATE(float, float)
+GATHER_CHW_INSTANTIATE(float16, float16)
+GATHER_CHW_INSTANTIATE(bfloat16, bfloat16)
+GATHER_CHW_INSTANTIATE(float, float16)
+GATHER_CHW_INSTANTIATE(float16, float)
+GATHER_CHW_INSTANTIATE(float, bfloat16)
+GATHER_CHW_INSTANTIATE(bfloat16, float)
+GATHER_CHW_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_CHW_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace rvv
+
+namespace mem {
+namespace {
+// 展平索引的入口实现，OutVec/InVec为std::vector或AlignedVector
+template <typename out_t, typename in_t, typename OutVec, typename InVec>
+int gather_chw_flat(OutVec& output, const InVec& input,
+                    const std::vector<int>& in_shape,
+                    const std::vector<int>& indices, int axis) {
+  size_t outer_count = std::accumulate(in_shape.begin(), in_shape.begin() + axis,
+                                       size_t{1}, std::multiplies<size_t>{});
   size_t indices_count = indices.size();
   size_t block_size =
-      std::accumulate(in_shape.begin() + axis + 1, in_shape.end(), 1,
+      std::accumulate(in_shape.begin() + axis + 1, in_shape.end(), size_t{1},
                       std::multiplies<size_t>{});
-  int output_size = input.size() * indices_count / in_shape[axis];
+  size_t output_size = input.size() / in_shape[axis] * indices_count;
   output.resize(output_size);
   auto* in_ptr = input.data();
   auto* out_ptr = output.data();
+  if (block_size < kSmallBlockSize) {
+    gather_small_block_scalar(
+        out_ptr, in_ptr,
+        small_block_sources<std::size_t>(indices, in_shape[axis], block_size),
+        outer_count, in_shape[axis] * block_size);
+    return 0;
+  }
 
   for (size_t o = 0; o < outer_count; ++o) {
     for (size_t i = 0; i < indices_count; ++i) {
       auto* o_ptr = out_ptr + i * block_size;
-      auto indices_ptr =
+      size_t indices_ptr =
           indices[i] >= 0 ? indices[i] : indices[i] + in_shape[axis];
-      memcpy(o_ptr, in_ptr + (indices_ptr * block_size),
-             block_size * sizeof(float));
+      copy_elems(o_ptr, in_ptr + (indices_ptr * block_size), block_size);
     }
     in_ptr += in_shape[axis] * block_size;
     out_ptr += indices_count * block_size;
   }
   return 0;
 }
-}  // namespace mem
\ No newline at end of file
+}  // namespace
+
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis) {
+  return gather_chw_flat<out_t, in_t>(output, input, in_shape, indices, axis);
+}
+
+template <typename out_t, typename in_t>
+int gather_chw(AlignedVector<out_t>& output, const AlignedVector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis) {
+  return gather_chw_flat<out_t, in_t>(output, input, in_shape, indices, axis);
+}
+
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, std::vector<int>& out_shape,
+               const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis) {
+  if (gather_chw_out_shape(out_shape, in_shape, indices, indices_shape, axis) !=
+      0) {
+    return -1;
+  }
+  return gather_chw<out_t, in_t>(output, input, in_shape, indices, axis);
+}
+
+int gather_chw(std::vector<float>& output, const std::vector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis) {
+  return gather_chw<float, float>(output, input, in_shape, indices, axis);
+}
+
+int gather_chw(std::vector<float>& output, std::vector<int>& out_shape,
+               const std::vector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis) {
+  return gather_chw<float, float>(output, out_shape, input, in_shape, indices,
+                                  indices_shape, axis);
+}
+
+int gather_chw(AlignedVector<float>& output, const AlignedVector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis) {
+  return gather_chw<float, float>(output, input, in_shape, indices, axis);
+}
+
+GATHER_CHW_INSTANTIATE(float, float)
+GATHER_CHW_INSTANTIATE(float16, float16)
+GATHER_CHW_INSTANTIATE(bfloat16, bfloat16)
+GATHER_CHW_INSTANTIATE(float, float16)
+GATHER_CHW_INSTANTIATE(float16, float)
+GATHER_CHW_INSTANTIATE(float, bfloat16)
+GATHER_CHW_INSTANTIATE(bfloat16, float)
+GATHER_CHW_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_CHW_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace mem
+
+#undef GATHER_CHW_INSTANTIATE
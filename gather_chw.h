@@ -2,8 +2,77 @@
 
 #include <vector>
 
+#include "aligned_buffer.h"
+#include "elem_type.h"
+
+namespace rvv {
+int gather_chw(std::vector<float>& output, const std::vector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis);
+
+// 多维索引（ONNX Gather语义），out_shape返回输出形状
+int gather_chw(std::vector<float>& output, std::vector<int>& out_shape,
+               const std::vector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis);
+
+// 16位存储（float16/bfloat16）、8位量化数据及融合精度转换，
+// 类型组合与gather_hwc相同
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis);
+
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, std::vector<int>& out_shape,
+               const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis);
+
+// 对齐缓冲区版本（见aligned_buffer.h），类型组合与上面相同（含float）
+int gather_chw(AlignedVector<float>& output, const AlignedVector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis);
+
+template <typename out_t, typename in_t>
+int gather_chw(AlignedVector<out_t>& output, const AlignedVector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis);
+}
+
 namespace mem {
 int gather_chw(std::vector<float>& output, const std::vector<float>& input,
                const std::vector<int>& in_shape,
                const std::vector<int>& indices, int axis);
+
+// 多维索引（ONNX Gather语义），out_shape返回输出形状
+int gather_chw(std::vector<float>& output, std::vector<int>& out_shape,
+               const std::vector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis);
+
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis);
+
+template <typename out_t, typename in_t>
+int gather_chw(std::vector<out_t>& output, std::vector<int>& out_shape,
+               const std::vector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices,
+               const std::vector<int>& indices_shape, int axis);
+
+// 对齐缓冲区版本（见aligned_buffer.h），类型组合与上面相同（含float）
+int gather_chw(AlignedVector<float>& output, const AlignedVector<float>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis);
+
+template <typename out_t, typename in_t>
+int gather_chw(AlignedVector<out_t>& output, const AlignedVector<in_t>& input,
+               const std::vector<int>& in_shape,
+               const std::vector<int>& indices, int axis);
 }
\ No newline at end of file
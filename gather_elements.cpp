@@ -0,0 +1,583 @@
+#include "gather_elements.h"
+
+#include <riscv_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "tensor_util.h"
+
+namespace {
+// 检查参数，返回axis在HWC形状中的位置，出错返回-1
+int gather_elements_hwc_prepare(const std::vector<int> &in_shape_hwc,
+                                const std::vector<int> &indices,
+                                const std::vector<int> &indices_shape_hwc,
+                                int axis_chw, int align_channels) {
+  int rank = in_shape_hwc.size();
+  if (rank < 3 || rank > 5 ||
+      indices_shape_hwc.size() != in_shape_hwc.size()) {
+    std::cerr << "无效的输入形状或索引形状：" << rank << ", "
+              << indices_shape_hwc.size() << std::endl;
+    return -1;
+  }
+  if (axis_chw < 0 || axis_chw >= rank) {
+    std::cerr << "无效的axis_chw：" << axis_chw << std::endl;
+    return -1;
+  }
+  int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  for (int i = 0; i < rank; ++i) {
+    if (i != axis_hwc && indices_shape_hwc[i] != in_shape_hwc[i]) {
+      std::cerr << "索引形状第" << i << "维与输入不一致："
+                << indices_shape_hwc[i] << std::endl;
+      return -1;
+    }
+  }
+  if (blocked_numel(indices_shape_hwc, align_channels) !=
+      static_cast<std::int64_t>(indices.size())) {
+    std::cerr << "索引形状与索引数量不匹配：" << indices.size() << std::endl;
+    return -1;
+  }
+  return axis_hwc;
+}
+
+// 非通道轴：输入视为[outer][D][inner]，输出和索引视为[outer][Q][inner]，
+// outer包含通道块，inner = axis之后的非通道维 x align_channels
+struct ElementsView {
+  std::int64_t outer, D, Q, inner;
+};
+
+ElementsView elements_view(const std::vector<int> &in_shape_hwc,
+                           const std::vector<int> &indices_shape_hwc,
+                           int axis_hwc, int align_channels) {
+  int rank = in_shape_hwc.size();
+  ElementsView v;
+  v.outer = padded_channels(in_shape_hwc[rank - 1], align_channels) /
+            align_channels;
+  for (int i = 0; i < axis_hwc; ++i) {
+    v.outer *= in_shape_hwc[i];
+  }
+  v.D = in_shape_hwc[axis_hwc];
+  v.Q = indices_shape_hwc[axis_hwc];
+  v.inner = align_channels;
+  for (int i = axis_hwc + 1; i < rank - 1; ++i) {
+    v.inner *= in_shape_hwc[i];
+  }
+  return v;
+}
+
+// 非通道维的像素数
+std::int64_t spatial_numel(const std::vector<int> &shape_hwc) {
+  std::int64_t numel = 1;
+  for (std::size_t i = 0; i + 1 < shape_hwc.size(); ++i) {
+    numel *= shape_hwc[i];
+  }
+  return numel;
+}
+
+// vluxei32的字节偏移是32位的，一次索引加载覆盖的输入范围超过4GiB时走标量路径
+bool fits_ei32(std::int64_t numel) {
+  return numel * static_cast<std::int64_t>(sizeof(float)) <=
+         std::numeric_limits<std::uint32_t>::max();
+}
+
+template <typename index_t>
+int gather_elements_axis_rvv(std::vector<float> &output,
+                             const std::vector<float> &input,
+                             const std::vector<int> &indices,
+                             const ElementsView &view) {
+  const index_t outer = view.outer;
+  const index_t Q = view.Q;
+  const index_t inner = view.inner;
+  const int32_t D = view.D;
+  const uint32_t row_bytes = inner * sizeof(float);
+  output.resize(outer * Q * inner, 0.0f);
+
+  for (index_t o = 0; o < outer; ++o) {
+    const float *src = input.data() + o * D * inner;
+    for (index_t q = 0; q < Q; ++q) {
+      index_t off = (o * Q + q) * inner;
+      index_t e = 0;
+      while (e < inner) {
+        std::size_t vl = vsetvl_e32m4(inner - e);
+        auto vi = vle32_v_i32m4(indices.data() + off + e, vl);
+        // 负索引加上D，再按无符号比较一次完成越界检查
+        auto neg = vmslt_vx_i32m4_b8(vi, 0, vl);
+        vi = vadd_vx_i32m4_m(neg, vi, vi, D, vl);
+        auto vu = vreinterpret_v_i32m4_u32m4(vi);
+        long bad = vfirst_m_b8(vmsgeu_vx_u32m4_b8(vu, D, vl), vl);
+        if (bad >= 0) {
+          std::cerr << "索引越界：" << indices[off + e + bad] << std::endl;
+          return -1;
+        }
+        // 字节偏移 = idx * inner * 4 + (e + lane) * 4
+        auto lane = vadd_vx_u32m4(vid_v_u32m4(vl), e, vl);
+        auto boff = vmul_vx_u32m4(vu, row_bytes, vl);
+        boff = vadd_vv_u32m4(boff, vsll_vx_u32m4(lane, 2, vl), vl);
+        auto v = vluxei32_v_f32m4(src, boff, vl);
+        vse32_v_f32m4(output.data() + off + e, v, vl);
+        e += vl;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int gather_elements_axis_mem(std::vector<float> &output,
+                             const std::vector<float> &input,
+                             const std::vector<int> &indices,
+                             const ElementsView &view) {
+  const index_t outer = view.outer;
+  const index_t Q = view.Q;
+  const index_t inner = view.inner;
+  const index_t D = view.D;
+  output.resize(outer * Q * inner, 0.0f);
+
+  for (index_t o = 0; o < outer; ++o) {
+    const float *src = input.data() + o * D * inner;
+    for (index_t q = 0; q < Q; ++q) {
+      index_t off = (o * Q + q) * inner;
+      for (index_t e = 0; e < inner; ++e) {
+        index_t idx = indices[off + e];
+        idx = idx >= 0 ? idx : idx + D;
+        if (idx < 0 || idx >= D) {
+          std::cerr << "索引越界：" << indices[off + e] << std::endl;
+          return -1;
+        }
+        output[off + e] = src[idx * inner + e];
+      }
+    }
+  }
+  return 0;
+}
+
+// 通道轴：输入[in_cb][P][A]，输出和索引[out_cb][P][A]，
+// 通道c位于第c/A个块的第c%A个位置
+template <typename index_t>
+int gather_elements_channel_rvv(std::vector<float> &output,
+                                const std::vector<float> &input,
+                                const std::vector<int> &in_shape_hwc,
+                                const std::vector<int> &indices,
+                                const std::vector<int> &indices_shape_hwc,
+                                int align_channels) {
+  const int rank = in_shape_hwc.size();
+  const int32_t C = in_shape_hwc[rank - 1];
+  const index_t out_C = indices_shape_hwc[rank - 1];
+  const index_t A = align_channels;
+  const index_t P = spatial_numel(in_shape_hwc);
+  const index_t out_cb = (out_C + A - 1) / A;
+  const index_t block = P * A;
+  const uint32_t block_bytes = block * sizeof(float);
+  output.resize(out_cb * block, 0.0f);
+
+  for (index_t cb = 0; cb < out_cb; ++cb) {
+    index_t off = cb * block;
+    index_t e = 0;
+    while (e < block) {
+      std::size_t vl = vsetvl_e32m4(block - e);
+      auto vi = vle32_v_i32m4(indices.data() + off + e, vl);
+      auto neg = vmslt_vx_i32m4_b8(vi, 0, vl);
+      vi = vadd_vx_i32m4_m(neg, vi, vi, C, vl);
+      auto vu = vreinterpret_v_i32m4_u32m4(vi);
+      long bad = vfirst_m_b8(vmsgeu_vx_u32m4_b8(vu, C, vl), vl);
+      if (bad >= 0) {
+        std::cerr << "索引越界：" << indices[off + e + bad] << std::endl;
+        return -1;
+      }
+      // 字节偏移 = (c / A) * P * A * 4 + (p * A + c % A) * 4，
+      // 其中p * A = (e + lane) - (e + lane) % A
+      auto lane = vadd_vx_u32m4(vid_v_u32m4(vl), e, vl);
+      auto pix = vsub_vv_u32m4(lane, vremu_vx_u32m4(lane, A, vl), vl);
+      auto elem = vadd_vv_u32m4(pix, vremu_vx_u32m4(vu, A, vl), vl);
+      auto boff = vmul_vx_u32m4(vdivu_vx_u32m4(vu, A, vl), block_bytes, vl);
+      boff = vadd_vv_u32m4(boff, vsll_vx_u32m4(elem, 2, vl), vl);
+      auto v = vluxei32_v_f32m4(input.data(), boff, vl);
+      vse32_v_f32m4(output.data() + off + e, v, vl);
+      e += vl;
+    }
+  }
+
+  // 最后一个块的补零通道按跨步写0
+  for (index_t j = out_C - (out_cb - 1) * A; j < A; ++j) {
+    float *dst = output.data() + (out_cb - 1) * block + j;
+    index_t n = P;
+    while (n > 0) {
+      std::size_t vl = vsetvl_e32m4(n);
+      vsse32_v_f32m4(dst, A * sizeof(float), vfmv_v_f_f32m4(0.0f, vl), vl);
+      dst += vl * A;
+      n -= vl;
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int gather_elements_channel_mem(std::vector<float> &output,
+                                const std::vector<float> &input,
+                                const std::vector<int> &in_shape_hwc,
+                                const std::vector<int> &indices,
+                                const std::vector<int> &indices_shape_hwc,
+                                int align_channels) {
+  const int rank = in_shape_hwc.size();
+  const index_t C = in_shape_hwc[rank - 1];
+  const index_t out_C = indices_shape_hwc[rank - 1];
+  const index_t A = align_channels;
+  const index_t P = spatial_numel(in_shape_hwc);
+  const index_t out_cb = (out_C + A - 1) / A;
+  output.resize(out_cb * P * A, 0.0f);
+
+  for (index_t cb = 0; cb < out_cb; ++cb) {
+    index_t valid = cb == out_cb - 1 ? out_C - cb * A : A;
+    for (index_t p = 0; p < P; ++p) {
+      index_t off = (cb * P + p) * A;
+      for (index_t j = 0; j < valid; ++j) {
+        index_t c = indices[off + j];
+        c = c >= 0 ? c : c + C;
+        if (c < 0 || c >= C) {
+          std::cerr << "索引越界：" << indices[off + j] << std::endl;
+          return -1;
+        }
+        output[off + j] = input[(c / A * P + p) * A + c % A];
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int gather_elements_hwc_mem_impl(std::vector<float> &output,
+                                 const std::vector<float> &input,
+                                 const std::vector<int> &in_shape_hwc,
+                                 const std::vector<int> &indices,
+                                 const std::vector<int> &indices_shape_hwc,
+                                 int axis_hwc, int align_channels) {
+  if (axis_hwc == static_cast<int>(in_shape_hwc.size()) - 1) {
+    return gather_elements_channel_mem<index_t>(
+        output, input, in_shape_hwc, indices, indices_shape_hwc,
+        align_channels);
+  }
+  return gather_elements_axis_mem<index_t>(
+      output, input, indices,
+      elements_view(in_shape_hwc, indices_shape_hwc, axis_hwc,
+                    align_channels));
+}
+
+// ScatterElements：与gather_elements同样的寻址，方向相反，直接原地写data。
+// 索引已在scatter_elements_hwc_prepare中检查并换成非负数
+template <typename index_t>
+int scatter_elements_axis_rvv(std::vector<float> &data,
+                              const std::vector<int> &indices,
+                              const std::vector<float> &updates,
+                              const ElementsView &view) {
+  const index_t outer = view.outer;
+  const index_t Q = view.Q;
+  const index_t inner = view.inner;
+  const index_t D = view.D;
+  const uint32_t row_bytes = inner * sizeof(float);
+
+  for (index_t o = 0; o < outer; ++o) {
+    float *dst = data.data() + o * D * inner;
+    for (index_t q = 0; q < Q; ++q) {
+      index_t off = (o * Q + q) * inner;
+      index_t e = 0;
+      while (e < inner) {
+        std::size_t vl = vsetvl_e32m4(inner - e);
+        auto vu = vle32_v_u32m4(
+            reinterpret_cast<const uint32_t *>(indices.data()) + off + e, vl);
+        // 同一条带内各lane的e不同，不会写到同一位置，可用无序索引存储
+        auto lane = vadd_vx_u32m4(vid_v_u32m4(vl), e, vl);
+        auto boff = vmul_vx_u32m4(vu, row_bytes, vl);
+        boff = vadd_vv_u32m4(boff, vsll_vx_u32m4(lane, 2, vl), vl);
+        auto v = vle32_v_f32m4(updates.data() + off + e, vl);
+        vsuxei32_v_f32m4(dst, boff, v, vl);
+        e += vl;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int scatter_elements_axis_mem(std::vector<float> &data,
+                              const std::vector<int> &indices,
+                              const std::vector<float> &updates,
+                              const ElementsView &view) {
+  const index_t outer = view.outer;
+  const index_t Q = view.Q;
+  const index_t inner = view.inner;
+  const index_t D = view.D;
+
+  for (index_t o = 0; o < outer; ++o) {
+    float *dst = data.data() + o * D * inner;
+    for (index_t q = 0; q < Q; ++q) {
+      index_t off = (o * Q + q) * inner;
+      for (index_t e = 0; e < inner; ++e) {
+        index_t idx = indices[off + e];
+        dst[idx * inner + e] = updates[off + e];
+      }
+    }
+  }
+  return 0;
+}
+
+// 通道轴的补零通道不参与写入（补零索引为0，写入会覆盖第0个通道），
+// 最后一个块用掩码跳过；同一像素内的重复通道用有序索引存储保证后写覆盖先写
+template <typename index_t>
+int scatter_elements_channel_rvv(std::vector<float> &data,
+                                 const std::vector<int> &data_shape_hwc,
+                                 const std::vector<int> &indices,
+                                 const std::vector<int> &indices_shape_hwc,
+                                 const std::vector<float> &updates,
+                                 int align_channels) {
+  const int rank = data_shape_hwc.size();
+  const index_t upd_C = indices_shape_hwc[rank - 1];
+  const index_t A = align_channels;
+  const index_t P = spatial_numel(data_shape_hwc);
+  const index_t upd_cb = (upd_C + A - 1) / A;
+  const index_t block = P * A;
+  const uint32_t block_bytes = block * sizeof(float);
+
+  for (index_t cb = 0; cb < upd_cb; ++cb) {
+    const uint32_t valid = cb == upd_cb - 1 ? upd_C - cb * A : A;
+    index_t off = cb * block;
+    index_t e = 0;
+    while (e < block) {
+      std::size_t vl = vsetvl_e32m4(block - e);
+      auto lane = vadd_vx_u32m4(vid_v_u32m4(vl), e, vl);
+      auto slot = vremu_vx_u32m4(lane, A, vl);
+      auto active = vmsltu_vx_u32m4_b8(slot, valid, vl);
+      auto vu = vle32_v_u32m4(
+          reinterpret_cast<const uint32_t *>(indices.data()) + off + e, vl);
+      auto pix = vsub_vv_u32m4(lane, slot, vl);
+      auto elem = vadd_vv_u32m4(pix, vremu_vx_u32m4(vu, A, vl), vl);
+      auto boff = vmul_vx_u32m4(vdivu_vx_u32m4(vu, A, vl), block_bytes, vl);
+      boff = vadd_vv_u32m4(boff, vsll_vx_u32m4(elem, 2, vl), vl);
+      auto v = vle32_v_f32m4(updates.data() + off + e, vl);
+      vsoxei32_v_f32m4_m(active, data.data(), boff, v, vl);
+      e += vl;
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int scatter_elements_channel_mem(std::vector<float> &data,
+                                 const std::vector<int> &data_shape_hwc,
+                                 const std::vector<int> &indices,
+                                 const std::vector<int> &indices_shape_hwc,
+                                 const std::vector<float> &updates,
+                                 int align_channels) {
+  const int rank = data_shape_hwc.size();
+  const index_t upd_C = indices_shape_hwc[rank - 1];
+  const index_t A = align_channels;
+  const index_t P = spatial_numel(data_shape_hwc);
+  const index_t upd_cb = (upd_C + A - 1) / A;
+
+  for (index_t cb = 0; cb < upd_cb; ++cb) {
+    index_t valid = cb == upd_cb - 1 ? upd_C - cb * A : A;
+    for (index_t p = 0; p < P; ++p) {
+      index_t off = (cb * P + p) * A;
+      for (index_t j = 0; j < valid; ++j) {
+        index_t c = indices[off + j];
+        data[(c / A * P + p) * A + c % A] = updates[off + j];
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int scatter_elements_hwc_mem_impl(std::vector<float> &data,
+                                  const std::vector<int> &data_shape_hwc,
+                                  const std::vector<int> &indices,
+                                  const std::vector<int> &indices_shape_hwc,
+                                  const std::vector<float> &updates,
+                                  int axis_hwc, int align_channels) {
+  if (axis_hwc == static_cast<int>(data_shape_hwc.size()) - 1) {
+    return scatter_elements_channel_mem<index_t>(
+        data, data_shape_hwc, indices, indices_shape_hwc, updates,
+        align_channels);
+  }
+  return scatter_elements_axis_mem<index_t>(
+      data, indices, updates,
+      elements_view(data_shape_hwc, indices_shape_hwc, axis_hwc,
+                    align_channels));
+}
+
+// scatter额外检查data和updates的大小，并在写data之前一次检查全部索引、
+// 把负索引换成非负数存入normalized（与scatter_nd_hwc相同，越界时data不变）。
+// 通道轴的补零通道不写入，其索引原样保留。返回axis在HWC形状中的位置
+int scatter_elements_hwc_prepare(std::vector<int> &normalized,
+                                 const std::vector<float> &data,
+                                 const std::vector<int> &data_shape_hwc,
+                                 const std::vector<int> &indices,
+                                 const std::vector<int> &indices_shape_hwc,
+                                 const std::vector<float> &updates,
+                                 int axis_chw, int align_channels) {
+  int axis_hwc = gather_elements_hwc_prepare(
+      data_shape_hwc, indices, indices_shape_hwc, axis_chw, align_channels);
+  if (axis_hwc < 0) {
+    return -1;
+  }
+  if (blocked_numel(data_shape_hwc, align_channels) !=
+          static_cast<std::int64_t>(data.size()) ||
+      updates.size() != indices.size()) {
+    std::cerr << "data或updates大小与形状不匹配：" << data.size() << ", "
+              << updates.size() << std::endl;
+    return -1;
+  }
+  const int rank = data_shape_hwc.size();
+  const bool channel = axis_hwc == rank - 1;
+  const std::int64_t D = data_shape_hwc[axis_hwc];
+  const std::int64_t A = align_channels;
+  const std::int64_t upd_C = indices_shape_hwc[rank - 1];
+  const std::int64_t block = spatial_numel(indices_shape_hwc) * A;
+  normalized = indices;
+  for (std::int64_t i = 0; i < static_cast<std::int64_t>(normalized.size());
+       ++i) {
+    if (channel && i / block * A + i % A >= upd_C) {
+      continue;
+    }
+    std::int64_t idx = normalized[i] >= 0 ? normalized[i] : normalized[i] + D;
+    if (idx < 0 || idx >= D) {
+      std::cerr << "索引越界：" << indices[i] << std::endl;
+      return -1;
+    }
+    normalized[i] = idx;
+  }
+  return axis_hwc;
+}
+} // namespace
+
+namespace rvv {
+int gather_elements_hwc(std::vector<float> &output,
+                        const std::vector<float> &input,
+                        const std::vector<int> &in_shape_hwc,
+                        const std::vector<int> &indices,
+                        const std::vector<int> &indices_shape_hwc,
+                        int axis_chw, int align_channels) {
+  int axis_hwc = gather_elements_hwc_prepare(
+      in_shape_hwc, indices, indices_shape_hwc, axis_chw, align_channels);
+  if (axis_hwc < 0) {
+    return -1;
+  }
+  bool use_int32 = fits_int32(input.size()) && fits_int32(indices.size());
+  if (axis_hwc == static_cast<int>(in_shape_hwc.size()) - 1) {
+    if (fits_ei32(input.size())) {
+      return use_int32 ? gather_elements_channel_rvv<std::int32_t>(
+                             output, input, in_shape_hwc, indices,
+                             indices_shape_hwc, align_channels)
+                       : gather_elements_channel_rvv<std::int64_t>(
+                             output, input, in_shape_hwc, indices,
+                             indices_shape_hwc, align_channels);
+    }
+  } else {
+    ElementsView view = elements_view(in_shape_hwc, indices_shape_hwc,
+                                      axis_hwc, align_channels);
+    if (fits_ei32(view.D * view.inner)) {
+      return use_int32 ? gather_elements_axis_rvv<std::int32_t>(
+                             output, input, indices, view)
+                       : gather_elements_axis_rvv<std::int64_t>(
+                             output, input, indices, view);
+    }
+  }
+  return use_int32
+             ? gather_elements_hwc_mem_impl<std::int32_t>(
+                   output, input, in_shape_hwc, indices, indices_shape_hwc,
+                   axis_hwc, align_channels)
+             : gather_elements_hwc_mem_impl<std::int64_t>(
+                   output, input, in_shape_hwc, indices, indices_shape_hwc,
+                   axis_hwc, align_channels);
+}
+
+int scatter_elements_hwc(std::vector<float> &data,
+                         const std::vector<int> &data_shape_hwc,
+                         const std::vector<int> &indices,
+                         const std::vector<int> &indices_shape_hwc,
+                         const std::vector<float> &updates, int axis_chw,
+                         int align_channels) {
+  std::vector<int> normalized;
+  int axis_hwc = scatter_elements_hwc_prepare(
+      normalized, data, data_shape_hwc, indices, indices_shape_hwc, updates,
+      axis_chw, align_channels);
+  if (axis_hwc < 0) {
+    return -1;
+  }
+  bool use_int32 = fits_int32(data.size()) && fits_int32(indices.size());
+  if (axis_hwc == static_cast<int>(data_shape_hwc.size()) - 1) {
+    if (fits_ei32(data.size())) {
+      return use_int32 ? scatter_elements_channel_rvv<std::int32_t>(
+                             data, data_shape_hwc, normalized,
+                             indices_shape_hwc, updates, align_channels)
+                       : scatter_elements_channel_rvv<std::int64_t>(
+                             data, data_shape_hwc, normalized,
+                             indices_shape_hwc, updates, align_channels);
+    }
+  } else {
+    ElementsView view = elements_view(data_shape_hwc, indices_shape_hwc,
+                                      axis_hwc, align_channels);
+    if (fits_ei32(view.D * view.inner)) {
+      return use_int32 ? scatter_elements_axis_rvv<std::int32_t>(
+                             data, normalized, updates, view)
+                       : scatter_elements_axis_rvv<std::int64_t>(
+                             data, normalized, updates, view);
+    }
+  }
+  return use_int32
+             ? scatter_elements_hwc_mem_impl<std::int32_t>(
+                   data, data_shape_hwc, normalized, indices_shape_hwc,
+                   updates, axis_hwc, align_channels)
+             : scatter_elements_hwc_mem_impl<std::int64_t>(
+                   data, data_shape_hwc, normalized, indices_shape_hwc,
+                   updates, axis_hwc, align_channels);
+}
+} // namespace rvv
+
+namespace mem {
+int gather_elements_hwc(std::vector<float> &output,
+                        const std::vector<float> &input,
+                        const std::vector<int> &in_shape_hwc,
+                        const std::vector<int> &indices,
+                        const std::vector<int> &indices_shape_hwc,
+                        int axis_chw, int align_channels) {
+  int axis_hwc = gather_elements_hwc_prepare(
+      in_shape_hwc, indices, indices_shape_hwc, axis_chw, align_channels);
+  if (axis_hwc < 0) {
+    return -1;
+  }
+  if (fits_int32(input.size()) && fits_int32(indices.size())) {
+    return gather_elements_hwc_mem_impl<std::int32_t>(
+        output, input, in_shape_hwc, indices, indices_shape_hwc, axis_hwc,
+        align_channels);
+  }
+  return gather_elements_hwc_mem_impl<std::int64_t>(
+      output, input, in_shape_hwc, indices, indices_shape_hwc, axis_hwc,
+      align_channels);
+}
+
+int scatter_elements_hwc(std::vector<float> &data,
+                         const std::vector<int> &data_shape_hwc,
+                         const std::vector<int> &indices,
+                         const std::vector<int> &indices_shape_hwc,
+                         const std::vector<float> &updates, int axis_chw,
+                         int align_channels) {
+  std::vector<int> normalized;
+  int axis_hwc = scatter_elements_hwc_prepare(
+      normalized, data, data_shape_hwc, indices, indices_shape_hwc, updates,
+      axis_chw, align_channels);
+  if (axis_hwc < 0) {
+    return -1;
+  }
+  if (fits_int32(data.size()) && fits_int32(indices.size())) {
+    return scatter_elements_hwc_mem_impl<std::int32_t>(
+        data, data_shape_hwc, normalized, indices_shape_hwc, updates,
+        axis_hwc, align_channels);
+  }
+  return scatter_elements_hwc_mem_impl<std::int64_t>(
+      data, data_shape_hwc, normalized, indices_shape_hwc, updates, axis_hwc,
+      align_channels);
+}
+} // namespace mem
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+// GatherElements（take_along_axis）在分块HWC布局上的实现，支持3~5维
+// axis_chw按CHW编号（3维CHW，4维NCHW，5维NCDHW）。
+// indices与输出同形状（indices_shape_hwc，HWC顺序），并且和数据一样按
+// align_channels分块存储，补零通道的索引必须为0；除axis外各维须与输入相同。
+// 输出形状即indices_shape_hwc，补零通道输出0。
+// scatter_elements_hwc是对应的ScatterElements（reduction=none），原地更新data，
+// updates与indices同形状同布局；重复索引时按元素顺序后写覆盖先写
+namespace rvv {
+int gather_elements_hwc(std::vector<float> &output,
+                        const std::vector<float> &input,
+                        const std::vector<int> &in_shape_hwc,
+                        const std::vector<int> &indices,
+                        const std::vector<int> &indices_shape_hwc,
+                        int axis_chw, int align_channels);
+
+int scatter_elements_hwc(std::vector<float> &data,
+                         const std::vector<int> &data_shape_hwc,
+                         const std::vector<int> &indices,
+                         const std::vector<int> &indices_shape_hwc,
+                         const std::vector<float> &updates, int axis_chw,
+                         int align_channels);
+}
+
+namespace mem {
+int gather_elements_hwc(std::vector<float> &output,
+                        const std::vector<float> &input,
+                        const std::vector<int> &in_shape_hwc,
+                        const std::vector<int> &indices,
+                        const std::vector<int> &indices_shape_hwc,
+                        int axis_chw, int align_channels);
+
+int scatter_elements_hwc(std::vector<float> &data,
+                         const std::vector<int> &data_shape_hwc,
+                         const std::vector<int> &indices,
+                         const std::vector<int> &indices_shape_hwc,
+                         const std::vector<float> &updates, int axis_chw,
+                         int align_channels);
+}
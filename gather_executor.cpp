@@ -0,0 +1,210 @@
+#include "gather_executor.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+std::future<int> ready_future(int value) {
+  std::promise<int> promise;
+  promise.set_value(value);
+  return promise.get_future();
+}
+}  // namespace
+
+GatherExecutor::GatherExecutor(int num_threads, int max_pending)
+    : max_pending_(max_pending > 0 ? max_pending : 0) {
+  if (num_threads <= 0) {
+    num_threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    queues_.emplace_back(new WorkerQueue());
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(&GatherExecutor::worker_loop, this, i);
+  }
+}
+
+GatherExecutor::~GatherExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  // 工作线程执行完队列中剩余的tile后退出
+  for (auto& w : workers_) {
+    w.join();
+  }
+}
+
+std::future<int> GatherExecutor::submit(std::function<int()> task) {
+  std::vector<std::function<int()>> tiles;
+  tiles.push_back(std::move(task));
+  return enqueue(std::move(tiles));
+}
+
+void GatherExecutor::wait_idle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  slot_cv_.wait(lock, [&] { return pending_ == 0; });
+}
+
+std::future<int>
+GatherExecutor::enqueue(std::vector<std::function<int()>> tiles) {
+  auto request = std::make_shared<Request>();
+  std::future<int> future = request->promise.get_future();
+  if (tiles.empty()) {
+    request->promise.set_value(0);
+    return future;
+  }
+  request->remaining = tiles.size();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    slot_cv_.wait(lock,
+                  [&] { return max_pending_ == 0 || pending_ < max_pending_; });
+    ++pending_;
+    // 整个请求放入同一个队列，其他线程空闲时再来窃取
+    WorkerQueue& queue = *queues_[next_queue_++ % queues_.size()];
+    {
+      std::lock_guard<std::mutex> queue_lock(queue.mutex);
+      for (auto& run : tiles) {
+        queue.tiles.push_back({std::move(run), request});
+      }
+    }
+    queued_tiles_ += tiles.size();
+  }
+  work_cv_.notify_all();
+  return future;
+}
+
+bool GatherExecutor::pop_local(std::size_t id, Tile& tile) {
+  WorkerQueue& queue = *queues_[id];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tiles.empty()) {
+      return false;
+    }
+    tile = std::move(queue.tiles.back());
+    queue.tiles.pop_back();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  --queued_tiles_;
+  return true;
+}
+
+bool GatherExecutor::steal(std::size_t id, Tile& tile) {
+  // 从其他线程队列的头部取，与队列主人从尾部取的tile错开
+  for (std::size_t k = 1; k < queues_.size(); ++k) {
+    WorkerQueue& queue = *queues_[(id + k) % queues_.size()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tiles.empty()) {
+        continue;
+      }
+      tile = std::move(queue.tiles.front());
+      queue.tiles.pop_front();
+    }
+    ++tiles_stolen_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    --queued_tiles_;
+    return true;
+  }
+  return false;
+}
+
+void GatherExecutor::run_tile(Tile& tile) {
+  int ret;
+  try {
+    ret = tile.run();
+  } catch (const std::exception& e) {
+    std::cerr << "执行器任务异常：" << e.what() << std::endl;
+    ret = -1;
+  }
+  ++tiles_executed_;
+  Request& request = *tile.request;
+  if (ret != 0) {
+    // 只记录第一个失败tile的返回值，后完成的失败不覆盖
+    int ok = 0;
+    request.status.compare_exchange_strong(ok, ret);
+  }
+  if (--request.remaining == 0) {
+    request.promise.set_value(request.status);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --pending_;
+    }
+    slot_cv_.notify_all();
+  }
+}
+
+void GatherExecutor::worker_loop(std::size_t id) {
+  for (;;) {
+    Tile tile;
+    if (pop_local(id, tile) || steal(id, tile)) {
+      run_tile(tile);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_cv_.wait(lock, [&] { return stop_ || queued_tiles_ > 0; });
+    if (stop_ && queued_tiles_ == 0) {
+      return;
+    }
+  }
+}
+
+template <typename out_t, typename in_t>
+std::future<int>
+GatherExecutor::submit_gather_hwc(const GatherJob<out_t, in_t>& job,
+                                  bool is_rvv) {
+  if (job.input == nullptr || job.output == nullptr) {
+    std::cerr << "gather请求的输入或输出为空" << std::endl;
+    return ready_future(-1);
+  }
+  // 按执行器的线程数切分tile，计划由全部tile共享
+  auto batch = std::make_shared<GatherBatchPlan>();
+  if (prepare_gather_batch(*batch, std::vector<GatherJob<out_t, in_t>>{job},
+                           num_threads()) != 0) {
+    return ready_future(-1);
+  }
+  const GatherPlan& plan = batch->plans[0];
+  if (static_cast<std::int64_t>(job.input->size()) != plan.input_numel) {
+    std::cerr << "输入元素数与gather计划不匹配：" << job.input->size()
+              << std::endl;
+    return ready_future(-1);
+  }
+  if (static_cast<const void*>(job.output) ==
+      static_cast<const void*>(job.input)) {
+    std::cerr << "gather请求的输出与输入相同" << std::endl;
+    return ready_future(-1);
+  }
+  job.output->resize(plan.output_numel);
+  out_t* out = job.output->data();
+  const in_t* in = job.input->data();
+  std::vector<std::function<int()>> tiles;
+  for (const GatherBatchTask& task : batch->tasks) {
+    tiles.push_back([batch, out, in, task, is_rvv]() {
+      const GatherPlan& p = batch->plans[0];
+      return is_rvv ? rvv::gather_hwc_range<out_t, in_t>(out, in, p,
+                                                         task.begin, task.end)
+                    : mem::gather_hwc_range<out_t, in_t>(out, in, p,
+                                                         task.begin, task.end);
+    });
+  }
+  return enqueue(std::move(tiles));
+}
+
+// 支持的(输出类型, 输入类型)组合，与gather_hwc相同
+#define GATHER_EXECUTOR_INSTANTIATE(out_t, in_t)                               \
+  template std::future<int> GatherExecutor::submit_gather_hwc<out_t, in_t>(    \
+      const GatherJob<out_t, in_t>&, bool);
+
+GATHER_EXECUTOR_INSTANTIATE(float, float)
+GATHER_EXECUTOR_INSTANTIATE(float16, float16)
+GATHER_EXECUTOR_INSTANTIATE(bfloat16, bfloat16)
+GATHER_EXECUTOR_INSTANTIATE(float, float16)
+GATHER_EXECUTOR_INSTANTIATE(float16, float)
+GATHER_EXECUTOR_INSTANTIATE(float, bfloat16)
+GATHER_EXECUTOR_INSTANTIATE(bfloat16, float)
+GATHER_EXECUTOR_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_EXECUTOR_INSTANTIATE(std::uint8_t, std::uint8_t)
+
+#undef GATHER_EXECUTOR_INSTANTIATE
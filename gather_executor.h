@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gather_batch.h"
+
+// 多个流水线阶段从不同线程并发提交gather/convert请求时共用的任务执行器。
+// 每个请求切成若干tile（gather按GatherBatchPlan的调度表切分），放入某个
+// 工作线程的队列；空闲的工作线程从其他线程的队列头部窃取tile，大请求
+// 自动分散到全部线程上。每个请求返回std::future<int>，全部tile完成后
+// 给出结果：全部tile返回0时为0，否则为第一个返回非0的tile的返回值
+// （tile抛出异常时记为-1）。未完成的请求数达到max_pending时提交会阻塞，
+// 对上游形成背压；不要在tile内部再提交请求
+//   GatherExecutor executor(4, 16);
+//   std::future<int> done = executor.submit_gather_hwc(job);
+//   ...
+//   if (done.get() != 0) { ... }
+class GatherExecutor {
+ public:
+  // num_threads<=0时使用全部硬件线程，max_pending<=0时不限制
+  GatherExecutor(int num_threads, int max_pending);
+  ~GatherExecutor();
+  GatherExecutor(const GatherExecutor&) = delete;
+  GatherExecutor& operator=(const GatherExecutor&) = delete;
+
+  // 提交一个gather_hwc请求，参数检查在提交线程上完成并分配好output，
+  // 出错时返回已就绪的-1。job中的input/output在future就绪前必须保持有效
+  template <typename out_t, typename in_t>
+  std::future<int> submit_gather_hwc(const GatherJob<out_t, in_t>& job,
+                                     bool is_rvv = true);
+
+  // 提交一个不切分的任务（如convert_*），任务的返回值原样作为future的结果
+  std::future<int> submit(std::function<int()> task);
+
+  // 等待已提交的全部请求完成
+  void wait_idle();
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+  // 累计执行的tile数与其中被其他线程窃取执行的tile数
+  std::size_t tiles_executed() const { return tiles_executed_; }
+  std::size_t tiles_stolen() const { return tiles_stolen_; }
+
+ private:
+  struct Request {
+    std::promise<int> promise;
+    std::atomic<std::size_t> remaining{0};
+    std::atomic<int> status{0};
+  };
+  struct Tile {
+    std::function<int()> run;
+    std::shared_ptr<Request> request;
+  };
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Tile> tiles;
+  };
+
+  std::future<int> enqueue(std::vector<std::function<int()>> tiles);
+  bool pop_local(std::size_t id, Tile& tile);
+  bool steal(std::size_t id, Tile& tile);
+  void run_tile(Tile& tile);
+  void worker_loop(std::size_t id);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::size_t next_queue_ = 0;
+
+  // 唤醒空闲线程、背压和wait_idle共用
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable slot_cv_;
+  std::size_t queued_tiles_ = 0;
+  std::size_t pending_ = 0;
+  std::size_t max_pending_ = 0;
+  bool stop_ = false;
+
+  std::atomic<std::size_t> tiles_executed_{0};
+  std::atomic<std::size_t> tiles_stolen_{0};
+};
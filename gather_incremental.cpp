@@ -0,0 +1,213 @@
+#include "gather_incremental.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "rvv_elem.h"
+#include "tensor_util.h"
+
+namespace {
+template <typename out_t, typename in_t>
+void copy_run(out_t* dst, const in_t* src, std::int64_t len, bool is_rvv) {
+  if (!is_rvv) {
+    copy_elems(dst, src, len);
+    return;
+  }
+  using Copy = RvvCopy<out_t, in_t>;
+  std::size_t n = len;
+  while (n > 0) {
+    std::size_t vl = Copy::setvl(n);
+    Copy::copy(dst, src, vl);
+    src += vl;
+    dst += vl;
+    n -= vl;
+  }
+}
+
+// 把[begin, end)个单位标记为脏，返回新标记的单位数
+std::int64_t mark_units(std::vector<std::uint8_t>& dirty, std::int64_t begin,
+                        std::int64_t end) {
+  std::int64_t marked = 0;
+  for (std::int64_t u = begin; u < end; ++u) {
+    marked += dirty[u] == 0;
+    dirty[u] = 1;
+  }
+  return marked;
+}
+}  // namespace
+
+template <typename out_t, typename in_t>
+int IncrementalGather<out_t, in_t>::prepare(
+    const std::vector<int>& in_shape_hwc, const std::vector<int>& indices,
+    int axis_chw, int align_channels) {
+  GatherPlan plan;
+  if (prepare_gather_hwc(plan, in_shape_hwc, indices, axis_chw,
+                         align_channels) != 0) {
+    return -1;
+  }
+  plan_ = std::move(plan);
+  in_shape_hwc_ = in_shape_hwc;
+  int rank = in_shape_hwc.size();
+  in_pixels_ = 1;
+  for (int d = 0; d < rank - 1; ++d) {
+    in_pixels_ *= in_shape_hwc[d];
+  }
+  num_blocks_ =
+      padded_channels(in_shape_hwc[rank - 1], align_channels) / align_channels;
+  dirty_.assign(num_blocks_ * in_pixels_, 0);
+  num_dirty_ = 0;
+  full_ = true;
+  last_updated_ = 0;
+  return 0;
+}
+
+template <typename out_t, typename in_t>
+int IncrementalGather<out_t, in_t>::mark_dirty(int axis_chw, int begin,
+                                               int end) {
+  int rank = in_shape_hwc_.size();
+  if (rank == 0) {
+    std::cerr << "增量gather尚未准备" << std::endl;
+    return -1;
+  }
+  if (axis_chw < 0 || axis_chw >= rank) {
+    std::cerr << "无效的axis：" << axis_chw << std::endl;
+    return -1;
+  }
+  int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  int dim = in_shape_hwc_[axis_hwc];
+  if (begin < 0 || begin > end || end > dim) {
+    std::cerr << "无效的脏区域：" << begin << "," << end << std::endl;
+    return -1;
+  }
+  if (begin == end) {
+    return 0;
+  }
+  if (axis_hwc == rank - 1) {
+    // 通道所在的整个通道块
+    std::int64_t A = plan_.align_channels;
+    num_dirty_ += mark_units(dirty_, begin / A * in_pixels_,
+                             (end + A - 1) / A * in_pixels_);
+    return 0;
+  }
+  // 每个通道块内，axis之前的维为outer，之后的空间维为连续的pitch个像素
+  std::int64_t outer = 1, pitch = 1;
+  for (int d = 0; d < axis_hwc; ++d) {
+    outer *= in_shape_hwc_[d];
+  }
+  for (int d = axis_hwc + 1; d < rank - 1; ++d) {
+    pitch *= in_shape_hwc_[d];
+  }
+  for (std::int64_t cb = 0; cb < num_blocks_; ++cb) {
+    for (std::int64_t o = 0; o < outer; ++o) {
+      std::int64_t base = cb * in_pixels_ + o * dim * pitch;
+      num_dirty_ +=
+          mark_units(dirty_, base + begin * pitch, base + end * pitch);
+    }
+  }
+  return 0;
+}
+
+template <typename out_t, typename in_t>
+void IncrementalGather<out_t, in_t>::mark_all_dirty() {
+  std::fill(dirty_.begin(), dirty_.end(), 1);
+  num_dirty_ = dirty_.size();
+}
+
+template <typename out_t, typename in_t>
+double IncrementalGather<out_t, in_t>::dirty_fraction() const {
+  return dirty_.empty() ? 0.0 : static_cast<double>(num_dirty_) / dirty_.size();
+}
+
+template <typename out_t, typename in_t>
+int IncrementalGather<out_t, in_t>::update(const std::vector<in_t>& input,
+                                           bool is_rvv) {
+  if (in_shape_hwc_.empty()) {
+    std::cerr << "增量gather尚未准备" << std::endl;
+    return -1;
+  }
+  if (static_cast<std::int64_t>(input.size()) != plan_.input_numel) {
+    std::cerr << "输入元素数与gather计划不匹配：" << input.size() << std::endl;
+    return -1;
+  }
+  if (full_ || num_dirty_ == static_cast<std::int64_t>(dirty_.size())) {
+    int ret = is_rvv ? rvv::gather_hwc<out_t, in_t>(output_, input, plan_)
+                     : mem::gather_hwc<out_t, in_t>(output_, input, plan_);
+    if (ret != 0) {
+      return -1;
+    }
+    last_updated_ = plan_.output_numel;
+  } else {
+    last_updated_ = 0;
+    if (num_dirty_ > 0) {
+      if (plan_.channel_axis) {
+        update_channels(input.data(), is_rvv);
+      } else {
+        update_slices(input.data(), is_rvv);
+      }
+    }
+  }
+  std::fill(dirty_.begin(), dirty_.end(), 0);
+  num_dirty_ = 0;
+  full_ = false;
+  return 0;
+}
+
+// 非C轴：每段拷贝的源都是整数个单位，只拷贝其中连续的脏单位
+template <typename out_t, typename in_t>
+void IncrementalGather<out_t, in_t>::update_slices(const in_t* in,
+                                                   bool is_rvv) {
+  std::int64_t A = plan_.align_channels;
+  out_t* out = output_.data();
+  for (std::int64_t o = 0; o < plan_.repeat; ++o) {
+    for (const GatherRun& run : plan_.runs) {
+      std::int64_t src = o * plan_.in_stride + run.src;
+      std::int64_t dst = o * plan_.out_stride + run.dst;
+      const std::uint8_t* marks = dirty_.data() + src / A;
+      std::int64_t units = run.len / A;
+      for (std::int64_t u = 0; u < units;) {
+        if (!marks[u]) {
+          ++u;
+          continue;
+        }
+        std::int64_t v = u;
+        while (v < units && marks[v]) {
+          ++v;
+        }
+        copy_run(out + dst + u * A, in + src + u * A, (v - u) * A, is_rvv);
+        last_updated_ += (v - u) * A;
+        u = v;
+      }
+    }
+  }
+}
+
+// C轴：每个输出像素的每段通道只读一个单位，该单位脏时才拷贝
+template <typename out_t, typename in_t>
+void IncrementalGather<out_t, in_t>::update_channels(const in_t* in,
+                                                     bool is_rvv) {
+  std::int64_t A = plan_.align_channels;
+  out_t* out = output_.data();
+  for (const GatherRun& run : plan_.runs) {
+    std::int64_t block = run.src / (in_pixels_ * A);
+    const std::uint8_t* marks = dirty_.data() + block * in_pixels_;
+    for (std::int64_t p = 0; p < plan_.repeat; ++p) {
+      std::int64_t px = plan_.pixel_src.empty() ? p : plan_.pixel_src[p];
+      if (marks[px]) {
+        copy_run(out + run.dst + p * A, in + run.src + px * A, run.len,
+                 is_rvv);
+        last_updated_ += run.len;
+      }
+    }
+  }
+}
+
+template class IncrementalGather<float, float>;
+template class IncrementalGather<float16, float16>;
+template class IncrementalGather<bfloat16, bfloat16>;
+template class IncrementalGather<float, float16>;
+template class IncrementalGather<float16, float>;
+template class IncrementalGather<float, bfloat16>;
+template class IncrementalGather<bfloat16, float>;
+template class IncrementalGather<std::int8_t, std::int8_t>;
+template class IncrementalGather<std::uint8_t, std::uint8_t>;
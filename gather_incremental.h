@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "elem_type.h"
+#include "gather_plan.h"
+
+// 增量gather：帧间输入只有部分区域变化（若干通道块、某个H条带等）时，
+// 保留上一次的输出，只重写源数据落在脏区域内的输出。脏区域以
+// (通道块, 像素)为单位记录，每个单位是输入中align_channels个连续元素，
+// 标记表只有输入的1/align_channels大小
+//   IncrementalGather<float, float> inc;
+//   inc.prepare({40, 40, 64}, {0, 5, 17}, 0, 16);
+//   inc.update(input);        // 第一次全量执行
+//   ...                       // 改写input的第10~19行
+//   inc.mark_dirty(1, 10, 20);
+//   inc.update(input);        // 只更新受影响的输出
+// 类型组合与gather_hwc相同（含float）
+template <typename out_t, typename in_t>
+class IncrementalGather {
+ public:
+  // 参数含义与gather_hwc（展平索引）相同，参数错误时返回-1。
+  // 准备后的第一次update全量执行
+  int prepare(const std::vector<int>& in_shape_hwc,
+              const std::vector<int>& indices, int axis_chw,
+              int align_channels);
+
+  // 标记输入沿axis_chw第[begin, end)个位置（其余维全部）已改变，
+  // C轴按这些通道所在的整个通道块标记。范围无效时返回-1
+  int mark_dirty(int axis_chw, int begin, int end);
+  void mark_all_dirty();
+
+  // 按标记更新输出并清除标记。input的元素数必须与准备时的形状一致，
+  // 且除标记的区域外与上一次update时相同
+  int update(const std::vector<in_t>& input, bool is_rvv = true);
+
+  const std::vector<out_t>& output() const { return output_; }
+  const std::vector<int>& out_shape_hwc() const {
+    return plan_.out_shape_hwc;
+  }
+  // 当前标记为脏的输入比例，以及上一次update写入的输出元素数
+  double dirty_fraction() const;
+  std::int64_t last_updated() const { return last_updated_; }
+
+ private:
+  void update_slices(const in_t* in, bool is_rvv);
+  void update_channels(const in_t* in, bool is_rvv);
+
+  GatherPlan plan_;
+  std::vector<int> in_shape_hwc_;
+  std::int64_t in_pixels_ = 0;
+  std::int64_t num_blocks_ = 0;
+  std::vector<std::uint8_t> dirty_;  // [cb][像素]
+  std::int64_t num_dirty_ = 0;
+  bool full_ = true;
+  std::int64_t last_updated_ = 0;
+  std::vector<out_t> output_;
+};
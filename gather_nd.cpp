@@ -0,0 +1,326 @@
+#include "gather_nd.h"
+
+#include <riscv_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "tensor_util.h"
+
+namespace {
+// 检查参数并计算输出形状，返回元组长度k，出错返回-1
+int gather_nd_hwc_prepare(std::vector<int> &out_shape_hwc,
+                          const std::vector<int> &in_shape_hwc,
+                          const std::vector<int> &indices,
+                          const std::vector<int> &indices_shape) {
+  int rank = in_shape_hwc.size();
+  if (rank < 3 || rank > 5 || indices_shape.empty()) {
+    std::cerr << "无效的输入形状或索引形状：" << rank << ", "
+              << indices_shape.size() << std::endl;
+    return -1;
+  }
+  int k = indices_shape.back();
+  if (k < 1 || k > rank - 1) {
+    std::cerr << "无效的坐标元组长度：" << k << std::endl;
+    return -1;
+  }
+  if (shape_numel(indices_shape) != static_cast<std::int64_t>(indices.size())) {
+    std::cerr << "索引形状与索引数量不匹配：" << indices.size() << std::endl;
+    return -1;
+  }
+  out_shape_hwc.assign(indices_shape.begin(), indices_shape.end() - 1);
+  out_shape_hwc.insert(out_shape_hwc.end(), in_shape_hwc.begin() + k,
+                       in_shape_hwc.end());
+  return k;
+}
+
+// 把每个坐标元组换算为输入中第0个通道块里的切片下标（以切片为单位），
+// 负坐标和越界检查只在这里做一次
+template <typename index_t>
+int gather_nd_hwc_slices(std::vector<index_t> &slices,
+                         const std::vector<int> &in_shape_hwc,
+                         const std::vector<int> &indices, int k) {
+  const index_t num_tuples = indices.size() / k;
+  slices.resize(num_tuples);
+  for (index_t t = 0; t < num_tuples; ++t) {
+    index_t slice = 0;
+    for (int j = 0; j < k; ++j) {
+      index_t dim = in_shape_hwc[j];
+      index_t idx = indices[t * k + j];
+      idx = idx >= 0 ? idx : idx + dim;
+      if (idx < 0 || idx >= dim) {
+        std::cerr << "索引越界：" << indices[t * k + j] << std::endl;
+        return -1;
+      }
+      slice = slice * dim + idx;
+    }
+    slices[t] = slice;
+  }
+  return 0;
+}
+
+template <typename index_t>
+int gather_nd_hwc_rvv(std::vector<float> &output,
+                      const std::vector<float> &input,
+                      const std::vector<int> &in_shape_hwc,
+                      const std::vector<int> &indices, int k,
+                      int align_channels) {
+  const int rank = in_shape_hwc.size();
+  const index_t C = in_shape_hwc[rank - 1];
+  const index_t num_c_blocks = (C + align_channels - 1) / align_channels;
+  // 每个通道块内被索引的切片数
+  index_t in_slices = 1;
+  for (int j = 0; j < k; ++j) {
+    in_slices *= in_shape_hwc[j];
+  }
+  // 每个切片连续的元素数
+  index_t slice_size = align_channels;
+  for (int j = k; j < rank - 1; ++j) {
+    slice_size *= in_shape_hwc[j];
+  }
+
+  std::vector<index_t> slices;
+  if (gather_nd_hwc_slices(slices, in_shape_hwc, indices, k) != 0) {
+    return -1;
+  }
+  const index_t num_tuples = slices.size();
+  output.resize(num_c_blocks * num_tuples * slice_size, 0.0f);
+
+  for (index_t cb = 0; cb < num_c_blocks; ++cb) {
+    for (index_t t = 0; t < num_tuples; ++t) {
+      index_t in_off = (cb * in_slices + slices[t]) * slice_size;
+      index_t out_off = (cb * num_tuples + t) * slice_size;
+      std::size_t n = slice_size;
+      while (n > 0) {
+        std::size_t vl = vsetvl_e32m8(n);
+        auto v = vle32_v_f32m8(input.data() + in_off, vl);
+        vse32_v_f32m8(output.data() + out_off, v, vl);
+        in_off += vl;
+        out_off += vl;
+        n -= vl;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int gather_nd_hwc_mem(std::vector<float> &output,
+                      const std::vector<float> &input,
+                      const std::vector<int> &in_shape_hwc,
+                      const std::vector<int> &indices, int k,
+                      int align_channels) {
+  const int rank = in_shape_hwc.size();
+  const index_t C = in_shape_hwc[rank - 1];
+  const index_t num_c_blocks = (C + align_channels - 1) / align_channels;
+  index_t in_slices = 1;
+  for (int j = 0; j < k; ++j) {
+    in_slices *= in_shape_hwc[j];
+  }
+  index_t slice_size = align_channels;
+  for (int j = k; j < rank - 1; ++j) {
+    slice_size *= in_shape_hwc[j];
+  }
+
+  std::vector<index_t> slices;
+  if (gather_nd_hwc_slices(slices, in_shape_hwc, indices, k) != 0) {
+    return -1;
+  }
+  const index_t num_tuples = slices.size();
+  output.resize(num_c_blocks * num_tuples * slice_size, 0.0f);
+
+  for (index_t cb = 0; cb < num_c_blocks; ++cb) {
+    for (index_t t = 0; t < num_tuples; ++t) {
+      index_t in_off = (cb * in_slices + slices[t]) * slice_size;
+      index_t out_off = (cb * num_tuples + t) * slice_size;
+      std::memcpy(output.data() + out_off, input.data() + in_off,
+                  slice_size * sizeof(float));
+    }
+  }
+  return 0;
+}
+
+// ScatterND：与gather_nd_hwc同样的切片寻址，把updates的切片原地写回data，
+// 元组按顺序写入，重复元组后写覆盖先写
+template <typename index_t>
+int scatter_nd_hwc_rvv(std::vector<float> &data,
+                       const std::vector<int> &data_shape_hwc,
+                       const std::vector<int> &indices, int k,
+                       const std::vector<float> &updates,
+                       int align_channels) {
+  const int rank = data_shape_hwc.size();
+  const index_t C = data_shape_hwc[rank - 1];
+  const index_t num_c_blocks = (C + align_channels - 1) / align_channels;
+  index_t data_slices = 1;
+  for (int j = 0; j < k; ++j) {
+    data_slices *= data_shape_hwc[j];
+  }
+  index_t slice_size = align_channels;
+  for (int j = k; j < rank - 1; ++j) {
+    slice_size *= data_shape_hwc[j];
+  }
+
+  std::vector<index_t> slices;
+  if (gather_nd_hwc_slices(slices, data_shape_hwc, indices, k) != 0) {
+    return -1;
+  }
+  const index_t num_tuples = slices.size();
+
+  for (index_t cb = 0; cb < num_c_blocks; ++cb) {
+    for (index_t t = 0; t < num_tuples; ++t) {
+      index_t data_off = (cb * data_slices + slices[t]) * slice_size;
+      index_t upd_off = (cb * num_tuples + t) * slice_size;
+      std::size_t n = slice_size;
+      while (n > 0) {
+        std::size_t vl = vsetvl_e32m8(n);
+        auto v = vle32_v_f32m8(updates.data() + upd_off, vl);
+        vse32_v_f32m8(data.data() + data_off, v, vl);
+        data_off += vl;
+        upd_off += vl;
+        n -= vl;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename index_t>
+int scatter_nd_hwc_mem(std::vector<float> &data,
+                       const std::vector<int> &data_shape_hwc,
+                       const std::vector<int> &indices, int k,
+                       const std::vector<float> &updates,
+                       int align_channels) {
+  const int rank = data_shape_hwc.size();
+  const index_t C = data_shape_hwc[rank - 1];
+  const index_t num_c_blocks = (C + align_channels - 1) / align_channels;
+  index_t data_slices = 1;
+  for (int j = 0; j < k; ++j) {
+    data_slices *= data_shape_hwc[j];
+  }
+  index_t slice_size = align_channels;
+  for (int j = k; j < rank - 1; ++j) {
+    slice_size *= data_shape_hwc[j];
+  }
+
+  std::vector<index_t> slices;
+  if (gather_nd_hwc_slices(slices, data_shape_hwc, indices, k) != 0) {
+    return -1;
+  }
+  const index_t num_tuples = slices.size();
+
+  for (index_t cb = 0; cb < num_c_blocks; ++cb) {
+    for (index_t t = 0; t < num_tuples; ++t) {
+      index_t data_off = (cb * data_slices + slices[t]) * slice_size;
+      index_t upd_off = (cb * num_tuples + t) * slice_size;
+      std::memcpy(data.data() + data_off, updates.data() + upd_off,
+                  slice_size * sizeof(float));
+    }
+  }
+  return 0;
+}
+
+// 检查data和updates的大小，返回元组长度k，出错返回-1
+int scatter_nd_hwc_prepare(const std::vector<float> &data,
+                           const std::vector<int> &data_shape_hwc,
+                           const std::vector<int> &indices,
+                           const std::vector<int> &indices_shape,
+                           const std::vector<float> &updates,
+                           int align_channels) {
+  std::vector<int> updates_shape_hwc;
+  int k = gather_nd_hwc_prepare(updates_shape_hwc, data_shape_hwc, indices,
+                                indices_shape);
+  if (k < 0) {
+    return -1;
+  }
+  if (blocked_numel(data_shape_hwc, align_channels) !=
+          static_cast<std::int64_t>(data.size()) ||
+      blocked_numel(updates_shape_hwc, align_channels) !=
+          static_cast<std::int64_t>(updates.size())) {
+    std::cerr << "data或updates大小与形状不匹配：" << data.size() << ", "
+              << updates.size() << std::endl;
+    return -1;
+  }
+  return k;
+}
+} // namespace
+
+namespace rvv {
+int gather_nd_hwc(std::vector<float> &output, std::vector<int> &out_shape_hwc,
+                  const std::vector<float> &input,
+                  const std::vector<int> &in_shape_hwc,
+                  const std::vector<int> &indices,
+                  const std::vector<int> &indices_shape, int align_channels) {
+  int k = gather_nd_hwc_prepare(out_shape_hwc, in_shape_hwc, indices,
+                                indices_shape);
+  if (k < 0) {
+    return -1;
+  }
+  if (fits_int32(input.size()) &&
+      fits_int32(blocked_numel(out_shape_hwc, align_channels))) {
+    return gather_nd_hwc_rvv<std::int32_t>(output, input, in_shape_hwc,
+                                           indices, k, align_channels);
+  }
+  return gather_nd_hwc_rvv<std::int64_t>(output, input, in_shape_hwc, indices,
+                                         k, align_channels);
+}
+
+int scatter_nd_hwc(std::vector<float> &data,
+                   const std::vector<int> &data_shape_hwc,
+                   const std::vector<int> &indices,
+                   const std::vector<int> &indices_shape,
+                   const std::vector<float> &updates, int align_channels) {
+  int k = scatter_nd_hwc_prepare(data, data_shape_hwc, indices, indices_shape,
+                                 updates, align_channels);
+  if (k < 0) {
+    return -1;
+  }
+  if (fits_int32(data.size()) && fits_int32(updates.size())) {
+    return scatter_nd_hwc_rvv<std::int32_t>(data, data_shape_hwc, indices, k,
+                                           updates, align_channels);
+  }
+  return scatter_nd_hwc_rvv<std::int64_t>(data, data_shape_hwc, indices, k,
+                                         updates, align_channels);
+}
+} // namespace rvv
+
+namespace mem {
+int gather_nd_hwc(std::vector<float> &output, std::vector<int> &out_shape_hwc,
+                  const std::vector<float> &input,
+                  const std::vector<int> &in_shape_hwc,
+                  const std::vector<int> &indices,
+                  const std::vector<int> &indices_shape, int align_channels) {
+  int k = gather_nd_hwc_prepare(out_shape_hwc, in_shape_hwc, indices,
+                                indices_shape);
+  if (k < 0) {
+    return -1;
+  }
+  if (fits_int32(input.size()) &&
+      fits_int32(blocked_numel(out_shape_hwc, align_channels))) {
+    return gather_nd_hwc_mem<std::int32_t>(output, input, in_shape_hwc,
+                                           indices, k, align_channels);
+  }
+  return gather_nd_hwc_mem<std::int64_t>(output, input, in_shape_hwc, indices,
+                                         k, align_channels);
+}
+
+int scatter_nd_hwc(std::vector<float> &data,
+                   const std::vector<int> &data_shape_hwc,
+                   const std::vector<int> &indices,
+                   const std::vector<int> &indices_shape,
+                   const std::vector<float> &updates, int align_channels) {
+  int k = scatter_nd_hwc_prepare(data, data_shape_hwc, indices, indices_shape,
+                                 updates, align_channels);
+  if (k < 0) {
+    return -1;
+  }
+  if (fits_int32(data.size()) && fits_int32(updates.size())) {
+    return scatter_nd_hwc_mem<std::int32_t>(data, data_shape_hwc, indices, k,
+                                           updates, align_channels);
+  }
+  return scatter_nd_hwc_mem<std::int64_t>(data, data_shape_hwc, indices, k,
+                                         updates, align_channels);
+}
+} // namespace mem
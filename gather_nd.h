@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+// GatherND（batch_dims=0）在分块HWC布局上的实现
+// indices形状为[..., k]，最后一维是按HWC顺序的前k个非通道维的坐标元组
+// （如3维的(h, w)，5维的(n, d, h)），k不超过rank-1，通道维不能被索引。
+// 输出形状为indices.shape[:-1] + in_shape_hwc[k:]，同样按align_channels分块存储，
+// 每个元组直接拷贝连续的in_shape_hwc[k:rank-1] x align_channels个元素。
+// scatter_nd_hwc是对应的ScatterND（reduction=none），原地更新data，
+// updates形状为indices.shape[:-1] + data_shape_hwc[k:]并同样分块存储，
+// 可用于沿N/D写回KV-cache式的切片；重复元组时后写覆盖先写
+namespace rvv {
+int gather_nd_hwc(std::vector<float> &output, std::vector<int> &out_shape_hwc,
+                  const std::vector<float> &input,
+                  const std::vector<int> &in_shape_hwc,
+                  const std::vector<int> &indices,
+                  const std::vector<int> &indices_shape, int align_channels);
+
+int scatter_nd_hwc(std::vector<float> &data,
+                   const std::vector<int> &data_shape_hwc,
+                   const std::vector<int> &indices,
+                   const std::vector<int> &indices_shape,
+                   const std::vector<float> &updates, int align_channels);
+}
+
+namespace mem {
+int gather_nd_hwc(std::vector<float> &output, std::vector<int> &out_shape_hwc,
+                  const std::vector<float> &input,
+                  const std::vector<int> &in_shape_hwc,
+                  const std::vector<int> &indices,
+                  const std::vector<int> &indices_shape, int align_channels);
+
+int scatter_nd_hwc(std::vector<float> &data,
+                   const std::vector<int> &data_shape_hwc,
+                   const std::vector<int> &indices,
+                   const std::vector<int> &indices_shape,
+                   const std::vector<float> &updates, int align_channels);
+}
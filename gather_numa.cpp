@@ -0,0 +1,429 @@
+#include "gather_numa.h"
+
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "gather_plan.h"
+#include "tensor_util.h"
+
+namespace {
+// 支持的最大节点号（节点掩码为一个64位字）
+constexpr int kMaxNumaNodes = 64;
+// linux/mempolicy.h中的取值，rt-smart等没有该头文件的系统上不会用到
+constexpr int kMpolBind = 2;
+constexpr int kMpolInterleave = 3;
+constexpr unsigned kMpolMfMove = 1 << 1;
+
+// 解析"0-3,8-11"形式的CPU列表
+std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item.empty()) {
+      continue;
+    }
+    std::size_t dash = item.find('-');
+    int first = std::stoi(item.substr(0, dash));
+    int last = dash == std::string::npos ? first
+                                         : std::stoi(item.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// 把[begin, end)字节的页迁到nodes上，mode为kMpolBind或kMpolInterleave
+int mbind_range(char* begin, char* end, int mode,
+                const std::vector<int>& nodes) {
+#if defined(__linux__) && defined(SYS_mbind)
+  std::uintptr_t page = sysconf(_SC_PAGESIZE);
+  std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(begin) + page - 1) /
+                         page * page;
+  std::uintptr_t last =
+      (reinterpret_cast<std::uintptr_t>(end) + page - 1) / page * page;
+  if (last <= first) {
+    return 0;
+  }
+  unsigned long mask = 0;
+  for (int node : nodes) {
+    if (node < 0 || node >= kMaxNumaNodes) {
+      return -1;
+    }
+    mask |= 1UL << node;
+  }
+  long ret = syscall(SYS_mbind, first, last - first, mode, &mask,
+                     kMaxNumaNodes + 1, kMpolMfMove);
+  return ret == 0 ? 0 : -1;
+#else
+  (void)begin;
+  (void)end;
+  (void)mode;
+  (void)nodes;
+  return -1;
+#endif
+}
+
+// 在每个节点上启动threads_per_node个绑定到该节点的线程，
+// 第k个节点处理[bounds[k], bounds[k + 1])，节点内再均分给各线程
+template <typename Fn>
+int run_on_nodes(const NumaTopology& topo, int threads_per_node,
+                 const std::vector<std::int64_t>& bounds, Fn fn) {
+  std::atomic<int> status{0};
+  std::vector<std::thread> workers;
+  for (std::size_t k = 0; k < topo.node_cpus.size(); ++k) {
+    std::int64_t begin = bounds[k], count = bounds[k + 1] - bounds[k];
+    for (int t = 0; t < threads_per_node; ++t) {
+      std::int64_t b = begin + count * t / threads_per_node;
+      std::int64_t e = begin + count * (t + 1) / threads_per_node;
+      if (b == e) {
+        continue;
+      }
+      workers.emplace_back([&, k, b, e]() {
+        numa_bind_thread(topo, k);
+        if (fn(b, e) != 0) {
+          status = -1;
+        }
+      });
+    }
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  return status;
+}
+
+template <bool kRvv, typename out_t, typename in_t>
+int gather_numa_impl(Tensor<out_t>& output, const Tensor<in_t>& input,
+                     const std::vector<int>& indices, int axis,
+                     const NumaTopology& topo, int threads_per_node) {
+  if (input.layout() != kLayoutBlocked || !input.is_contiguous()) {
+    std::cerr << "NUMA gather只支持连续的分块排布张量" << std::endl;
+    return -1;
+  }
+  if (topo.node_cpus.empty() || threads_per_node <= 0) {
+    std::cerr << "无效的NUMA拓扑或线程数：" << threads_per_node << std::endl;
+    return -1;
+  }
+  if (axis < 0 || axis >= input.rank()) {
+    std::cerr << "无效的axis：" << axis << std::endl;
+    return -1;
+  }
+  // output与input共享存储时reset会换新的缓冲区，src保持输入不被覆盖
+  Tensor<in_t> src = input.contiguous();
+  int A = src.align_channels();
+  GatherPlan plan;
+  if (prepare_gather_hwc(plan, src.shape_hwc(), indices, axis, A) != 0) {
+    return -1;
+  }
+  std::vector<int> out_shape = src.shape();
+  out_shape[axis] = indices.size();
+  // reset沿用缓冲区时会清空内容，按缓冲区地址和大小判断是否需要重新放置：
+  // 同一块存储、大小不变时页面仍在上次放置的节点上
+  const out_t* previous = output.data();
+  std::size_t previous_size = previous != nullptr ? output.storage().size() : 0;
+  AlignedVector<out_t>& buffer = output.reset(out_shape, kLayoutBlocked, A);
+  buffer.resize(plan.output_numel);
+  if (buffer.data() != previous || buffer.size() != previous_size) {
+    numa_place(output, topo, kNumaChannelBlocks, A);
+  }
+
+  // 非C轴的重复按通道块优先排列，每块plan.repeat / num_blocks次
+  int nodes = topo.node_cpus.size();
+  int num_blocks =
+      padded_channels(src.shape()[src.channel_axis()], A) / A;
+  std::vector<std::int64_t> bounds(nodes + 1);
+  if (!plan.channel_axis && num_blocks > 0 &&
+      plan.repeat % num_blocks == 0) {
+    std::int64_t unit = plan.repeat / num_blocks;
+    std::vector<int> split = numa_channel_block_split(num_blocks, nodes);
+    for (int k = 0; k <= nodes; ++k) {
+      bounds[k] = split[k] * unit;
+    }
+  } else {
+    for (int k = 0; k <= nodes; ++k) {
+      bounds[k] = plan.repeat * k / nodes;
+    }
+  }
+  out_t* out = buffer.data();
+  const in_t* in = src.storage().data();
+  return run_on_nodes(
+      topo, threads_per_node, bounds, [&](std::int64_t b, std::int64_t e) {
+        return kRvv ? rvv::gather_hwc_range<out_t, in_t>(out, in, plan, b, e)
+                    : mem::gather_hwc_range<out_t, in_t>(out, in, plan, b, e);
+      });
+}
+}  // namespace
+
+int numa_topology(NumaTopology& topo, int simulated_nodes) {
+  topo.node_ids.clear();
+  topo.node_cpus.clear();
+  topo.simulated = false;
+  for (int node = 0; node < kMaxNumaNodes; ++node) {
+    std::ifstream file("/sys/devices/system/node/node" +
+                       std::to_string(node) + "/cpulist");
+    std::string list;
+    if (!file || !std::getline(file, list)) {
+      continue;
+    }
+    std::vector<int> cpus = parse_cpu_list(list);
+    // 只有内存没有CPU的节点不参与划分
+    if (!cpus.empty()) {
+      topo.node_ids.push_back(node);
+      topo.node_cpus.push_back(cpus);
+    }
+  }
+  if (topo.node_cpus.empty()) {
+    int n = std::max<int>(std::thread::hardware_concurrency(), 1);
+    std::vector<int> cpus(n);
+    for (int i = 0; i < n; ++i) {
+      cpus[i] = i;
+    }
+    topo.node_ids = {0};
+    topo.node_cpus = {cpus};
+  }
+  if (simulated_nodes <= 0) {
+    return 0;
+  }
+  // 把全部CPU按编号顺序均分，CPU不够时多个模拟节点共用
+  std::vector<int> all;
+  for (const auto& cpus : topo.node_cpus) {
+    all.insert(all.end(), cpus.begin(), cpus.end());
+  }
+  topo.node_ids.clear();
+  topo.node_cpus.assign(simulated_nodes, {});
+  for (int k = 0; k < simulated_nodes; ++k) {
+    std::size_t begin = all.size() * k / simulated_nodes;
+    std::size_t end = all.size() * (k + 1) / simulated_nodes;
+    if (begin == end) {
+      topo.node_cpus[k].push_back(all[k % all.size()]);
+    } else {
+      topo.node_cpus[k].assign(all.begin() + begin, all.begin() + end);
+    }
+    topo.node_ids.push_back(k);
+  }
+  topo.simulated = true;
+  return 0;
+}
+
+int numa_bind_thread(const NumaTopology& topo, int node) {
+  if (node < 0 || node >= static_cast<int>(topo.node_cpus.size())) {
+    return -1;
+  }
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : topo.node_cpus[node]) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+#else
+  return -1;
+#endif
+}
+
+std::vector<int> numa_channel_block_split(int num_blocks, int nodes) {
+  std::vector<int> split(nodes + 1);
+  for (int k = 0; k <= nodes; ++k) {
+    split[k] = static_cast<std::int64_t>(num_blocks) * k / nodes;
+  }
+  return split;
+}
+
+template <typename T>
+int numa_place(Tensor<T>& tensor, const NumaTopology& topo,
+               NumaPlacement placement, int align_channels) {
+  if (!tensor.is_contiguous()) {
+    std::cerr << "只有连续的张量能按NUMA节点放置" << std::endl;
+    return -1;
+  }
+  int nodes = topo.node_cpus.size();
+  if (topo.simulated || nodes < 2 || tensor.data() == nullptr) {
+    return -1;
+  }
+  char* base = reinterpret_cast<char*>(tensor.data());
+  std::int64_t bytes =
+      (tensor.storage().data() + tensor.storage().size() - tensor.data()) *
+      sizeof(T);
+  if (placement == kNumaFirstTouch) {
+    return 0;
+  }
+  if (placement == kNumaInterleave) {
+    return mbind_range(base, base + bytes, kMpolInterleave, topo.node_ids);
+  }
+  int c_axis = tensor.channel_axis();
+  if (c_axis < 0) {
+    // 没有C维时整体均分
+    int ret = 0;
+    for (int k = 0; k < nodes; ++k) {
+      ret |= mbind_range(base + bytes * k / nodes,
+                         base + bytes * (k + 1) / nodes, kMpolBind,
+                         {topo.node_ids[k]});
+    }
+    return ret;
+  }
+  const std::vector<int>& shape = tensor.shape();
+  int C = shape[c_axis];
+  int A = tensor.layout() == kLayoutBlocked ? tensor.align_channels()
+                                            : std::max(align_channels, 1);
+  int num_blocks = padded_channels(C, A) / A;
+  std::vector<int> split = numa_channel_block_split(num_blocks, nodes);
+  std::int64_t elem = sizeof(T);
+  int ret = 0;
+  if (tensor.layout() == kLayoutBlocked) {
+    // [cb][其余维][A]，每个通道块连续
+    std::int64_t block_bytes = tensor.block_stride() * elem;
+    for (int k = 0; k < nodes; ++k) {
+      ret |= mbind_range(base + split[k] * block_bytes,
+                         base + split[k + 1] * block_bytes, kMpolBind,
+                         {topo.node_ids[k]});
+    }
+    return ret;
+  }
+  // 平面排布：每个outer切片内第k个节点的通道平面连续
+  std::int64_t outer = 1, plane = 1;
+  for (int d = 0; d < c_axis; ++d) {
+    outer *= shape[d];
+  }
+  for (int d = c_axis + 1; d < tensor.rank(); ++d) {
+    plane *= shape[d];
+  }
+  for (std::int64_t o = 0; o < outer; ++o) {
+    char* slice = base + o * C * plane * elem;
+    for (int k = 0; k < nodes; ++k) {
+      std::int64_t c0 = std::min<std::int64_t>(split[k] * A, C);
+      std::int64_t c1 = std::min<std::int64_t>(split[k + 1] * A, C);
+      ret |= mbind_range(slice + c0 * plane * elem, slice + c1 * plane * elem,
+                         kMpolBind, {topo.node_ids[k]});
+    }
+  }
+  return ret;
+}
+
+template <typename T>
+Tensor<T> to_blocked_numa(const Tensor<T>& input, int align_channels,
+                          const NumaTopology& topo, int threads_per_node) {
+  if (input.layout() == kLayoutBlocked) {
+    return to_blocked(input, align_channels);
+  }
+  if (topo.node_cpus.empty() || threads_per_node <= 0) {
+    throw std::invalid_argument("无效的NUMA拓扑或线程数");
+  }
+  Tensor<T> src = input.contiguous();
+  // 构造时检查维数和align_channels
+  Tensor<T> result(src.shape(), kLayoutBlocked, align_channels);
+  numa_place(result, topo, kNumaChannelBlocks, align_channels);
+
+  const std::vector<int>& shape = src.shape();
+  int c_axis = src.channel_axis();
+  std::int64_t N = 1, S = 1;
+  for (int d = 0; d < c_axis; ++d) {
+    N *= shape[d];
+  }
+  for (int d = c_axis + 1; d < src.rank(); ++d) {
+    S *= shape[d];
+  }
+  std::int64_t C = shape[c_axis];
+  std::int64_t A = align_channels;
+  int num_blocks = padded_channels(C, align_channels) / align_channels;
+  std::vector<int> split =
+      numa_channel_block_split(num_blocks, topo.node_cpus.size());
+  std::vector<std::int64_t> bounds(split.begin(), split.end());
+  const T* in = src.storage().data();
+  T* out = result.data();
+  run_on_nodes(topo, threads_per_node, bounds,
+               [&](std::int64_t b0, std::int64_t b1) {
+                 // 按输出顺序写第[b0, b1)个通道块，补齐通道保持为0
+                 for (std::int64_t b = b0; b < b1; ++b) {
+                   std::int64_t lanes = std::min(A, C - b * A);
+                   T* dst = out + b * N * S * A;
+                   for (std::int64_t n = 0; n < N; ++n) {
+                     const T* plane = in + (n * C + b * A) * S;
+                     for (std::int64_t s = 0; s < S; ++s, dst += A) {
+                       for (std::int64_t lane = 0; lane < lanes; ++lane) {
+                         dst[lane] = plane[lane * S + s];
+                       }
+                     }
+                   }
+                 }
+                 return 0;
+               });
+  return result;
+}
+
+#define GATHER_NUMA_TENSOR_INSTANTIATE(T)                                      \
+  template int numa_place<T>(Tensor<T>&, const NumaTopology&,                  \
+                             NumaPlacement, int);                              \
+  template Tensor<T> to_blocked_numa<T>(const Tensor<T>&, int,                 \
+                                        const NumaTopology&, int);
+
+GATHER_NUMA_TENSOR_INSTANTIATE(float)
+GATHER_NUMA_TENSOR_INSTANTIATE(float16)
+GATHER_NUMA_TENSOR_INSTANTIATE(bfloat16)
+GATHER_NUMA_TENSOR_INSTANTIATE(std::int8_t)
+GATHER_NUMA_TENSOR_INSTANTIATE(std::uint8_t)
+
+// 支持的(输出类型, 输入类型)组合，与gather_hwc相同
+#define GATHER_NUMA_INSTANTIATE(out_t, in_t)                                   \
+  template int gather_numa<out_t, in_t>(Tensor<out_t>&,                        \
+                                        const Tensor<in_t>&,                   \
+                                        const std::vector<int>&, int,          \
+                                        const NumaTopology&, int);
+
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_numa(Tensor<out_t>& output, const Tensor<in_t>& input,
+                const std::vector<int>& indices, int axis,
+                const NumaTopology& topo, int threads_per_node) {
+  return gather_numa_impl<true>(output, input, indices, axis, topo,
+                                threads_per_node);
+}
+
+GATHER_NUMA_INSTANTIATE(float, float)
+GATHER_NUMA_INSTANTIATE(float16, float16)
+GATHER_NUMA_INSTANTIATE(bfloat16, bfloat16)
+GATHER_NUMA_INSTANTIATE(float, float16)
+GATHER_NUMA_INSTANTIATE(float16, float)
+GATHER_NUMA_INSTANTIATE(float, bfloat16)
+GATHER_NUMA_INSTANTIATE(bfloat16, float)
+GATHER_NUMA_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_NUMA_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_numa(Tensor<out_t>& output, const Tensor<in_t>& input,
+                const std::vector<int>& indices, int axis,
+                const NumaTopology& topo, int threads_per_node) {
+  return gather_numa_impl<false>(output, input, indices, axis, topo,
+                                 threads_per_node);
+}
+
+GATHER_NUMA_INSTANTIATE(float, float)
+GATHER_NUMA_INSTANTIATE(float16, float16)
+GATHER_NUMA_INSTANTIATE(bfloat16, bfloat16)
+GATHER_NUMA_INSTANTIATE(float, float16)
+GATHER_NUMA_INSTANTIATE(float16, float)
+GATHER_NUMA_INSTANTIATE(float, bfloat16)
+GATHER_NUMA_INSTANTIATE(bfloat16, float)
+GATHER_NUMA_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_NUMA_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace mem
+
+#undef GATHER_NUMA_TENSOR_INSTANTIATE
+#undef GATHER_NUMA_INSTANTIATE
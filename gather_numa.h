@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "tensor.h"
+
+// 多路服务器（x86预处理机）上按NUMA节点划分的gather/convert。分块HWC张量的
+// 通道块[cb][其余维][A]各自连续，沿非C轴gather时输出的第cb块只读输入的第cb块，
+// 按通道块把数据放到各节点、再由绑定在该节点上的线程处理本节点的通道块，
+// 读写都不跨节点。K230等单节点系统上退化为按通道块划分的多线程执行
+
+// 各节点的内核节点号和CPU编号。simulated为true时是把在线CPU均分得到的
+// 模拟节点（类似numactl --cpunodebind），只绑定线程，不迁移内存
+struct NumaTopology {
+  std::vector<int> node_ids;
+  std::vector<std::vector<int>> node_cpus;
+  bool simulated = false;
+};
+
+// 读取/sys/devices/system/node下的拓扑，读不到时为一个包含全部CPU的节点。
+// simulated_nodes>0时忽略实际拓扑，模拟这么多个节点
+int numa_topology(NumaTopology& topo, int simulated_nodes);
+
+// 把当前线程绑定到node的CPU上，不支持时返回-1
+int numa_bind_thread(const NumaTopology& topo, int node);
+
+// 把num_blocks个通道块均分给nodes个节点，
+// 第k个节点为[split[k], split[k + 1])
+std::vector<int> numa_channel_block_split(int num_blocks, int nodes);
+
+enum NumaPlacement {
+  kNumaFirstTouch = 0,     // 不迁移，保留首次写入时所在的节点
+  kNumaChannelBlocks = 1,  // 第k段通道块迁到节点k
+  kNumaInterleave = 2      // 按页在各节点间交错
+};
+
+// 按placement迁移张量存储的页（mbind + MPOL_MF_MOVE），张量必须is_contiguous。
+// 平面排布的每个outer切片内按align_channels个通道平面为一块划分，
+// 与之后to_blocked_numa(align_channels)各节点读取的平面一致。
+// 模拟节点、单节点或系统不支持mbind时不迁移并返回-1，张量数据不受影响
+template <typename T>
+int numa_place(Tensor<T>& tensor, const NumaTopology& topo,
+               NumaPlacement placement, int align_channels = 64);
+
+// 按节点划分的gather：输入必须是分块排布，非C轴按通道块划分，
+// C轴（输出通道块读任意输入通道块）按输出像素均分。每个节点threads_per_node个
+// 线程并绑定到该节点的CPU。输出存储重新分配时按通道块放置到各节点，
+// 跨帧复用输出时不再迁移。参数错误时返回-1。类型组合与gather_hwc相同
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_numa(Tensor<out_t>& output, const Tensor<in_t>& input,
+                const std::vector<int>& indices, int axis,
+                const NumaTopology& topo, int threads_per_node);
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_numa(Tensor<out_t>& output, const Tensor<in_t>& input,
+                const std::vector<int>& indices, int axis,
+                const NumaTopology& topo, int threads_per_node);
+}  // namespace mem
+
+// 平面排布转为分块排布（与to_blocked结果相同），每个节点只写本节点的通道块、
+// 只读对应的通道平面；输出按通道块放置到各节点。
+// 参数无效时抛出std::invalid_argument
+template <typename T>
+Tensor<T> to_blocked_numa(const Tensor<T>& input, int align_channels,
+                          const NumaTopology& topo, int threads_per_node);
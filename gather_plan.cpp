@@ -0,0 +1,418 @@
+#include "gather_plan.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "rvv_elem.h"
+#include "tensor_util.h"
+
+namespace {
+// C轴上短于该长度的通道段逐通道做跨像素的strided搬运，否则逐像素连续搬运
+constexpr std::int64_t kMinLaneRun = 4;
+
+// 追加一段拷贝，与上一段首尾相接时合并；block非0时合并后的段不能跨越
+// block边界（C轴的通道段要逐像素以align_channels为步长重复）
+void append_run(std::vector<GatherRun> &runs, std::int64_t src,
+                std::int64_t dst, std::int64_t len, std::int64_t block) {
+  if (!runs.empty()) {
+    GatherRun &last = runs.back();
+    bool contiguous = last.src + last.len == src && last.dst + last.len == dst;
+    bool in_block = block == 0 || (last.src % block + last.len + len <= block &&
+                                   last.dst % block + last.len + len <= block);
+    if (contiguous && in_block) {
+      last.len += len;
+      return;
+    }
+  }
+  runs.push_back({src, dst, len});
+}
+
+template <typename out_t, typename in_t>
+void copy_run_rvv(out_t *dst, const in_t *src, std::int64_t len) {
+  using Copy = RvvCopy<out_t, in_t>;
+  std::size_t n = len;
+  while (n > 0) {
+    std::size_t vl = Copy::setvl(n);
+    Copy::copy(dst, src, vl);
+    src += vl;
+    dst += vl;
+    n -= vl;
+  }
+}
+
+template <typename out_t, typename in_t>
+void copy_lane_rvv(out_t *dst, const in_t *src, std::int64_t stride,
+                   std::int64_t count) {
+  using Copy = RvvCopy<out_t, in_t>;
+  std::size_t n = count;
+  while (n > 0) {
+    std::size_t vl = Copy::setvl(n);
+    Copy::copy_strided(dst, src, stride, vl);
+    src += vl * stride;
+    dst += vl * stride;
+    n -= vl;
+  }
+}
+
+// 第[begin, end)个输出像素的补齐通道置0，跨帧复用output时这些位置可能残留旧数据
+template <typename out_t>
+void zero_pad_runs(out_t *out, const GatherPlan &plan, std::int64_t begin,
+                   std::int64_t end) {
+  for (const GatherRun &run : plan.pad_runs) {
+    for (std::int64_t p = begin; p < end; ++p) {
+      out_t *dst = out + run.dst + p * plan.align_channels;
+      std::fill(dst, dst + run.len, out_t());
+    }
+  }
+}
+
+template <typename out_t, typename in_t>
+int check_plan_input(std::vector<out_t> &output, const std::vector<in_t> &input,
+                     const GatherPlan &plan) {
+  if (static_cast<std::int64_t>(input.size()) != plan.input_numel) {
+    std::cerr << "输入元素数与gather计划不匹配：" << input.size() << std::endl;
+    return -1;
+  }
+  output.resize(plan.output_numel);
+  return 0;
+}
+
+int check_plan_range(const GatherPlan &plan, std::int64_t begin,
+                     std::int64_t end) {
+  if (begin < 0 || begin > end || end > plan.repeat) {
+    std::cerr << "无效的执行范围：" << begin << "," << end << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+// 各轴（分块HWC顺序，C在最后）的索引映射，为空表示该轴不做gather
+using AxisMaps = std::vector<std::vector<std::int64_t>>;
+
+// 按各轴映射生成计划，out_shape_hwc为映射后的形状，映射中的索引已检查过
+void build_gather_plan(GatherPlan &p, const std::vector<int> &in_shape_hwc,
+                       const std::vector<int> &out_shape_hwc,
+                       const AxisMaps &maps, int align_channels) {
+  int rank = in_shape_hwc.size();
+  std::int64_t A = align_channels;
+  p.out_shape_hwc = out_shape_hwc;
+  p.input_numel = blocked_numel(in_shape_hwc, align_channels);
+  p.output_numel = blocked_numel(out_shape_hwc, align_channels);
+  p.align_channels = align_channels;
+  p.channel_axis = !maps[rank - 1].empty();
+  if (p.output_numel == 0) {
+    return;
+  }
+
+  // 空间维（不含C）在一个通道块内的步长，单位为像素
+  std::vector<std::int64_t> in_pitch(rank - 1), out_pitch(rank - 1);
+  std::int64_t in_pixels = 1, out_pixels = 1;
+  for (int d = rank - 2; d >= 0; --d) {
+    in_pitch[d] = in_pixels;
+    out_pitch[d] = out_pixels;
+    in_pixels *= in_shape_hwc[d];
+    out_pixels *= out_shape_hwc[d];
+  }
+  int first = rank - 1, last = -1;
+  for (int d = rank - 2; d >= 0; --d) {
+    if (!maps[d].empty()) {
+      first = d;
+      last = std::max(last, d);
+    }
+  }
+
+  if (p.channel_axis) {
+    const std::vector<std::int64_t> &cmap = maps[rank - 1];
+    std::int64_t out_c = out_shape_hwc[rank - 1];
+    for (std::int64_t i = 0; i < out_c; ++i) {
+      append_run(p.runs, cmap[i] / A * in_pixels * A + cmap[i] % A,
+                 i / A * out_pixels * A + i % A, 1, A);
+    }
+    std::int64_t padded = padded_channels(out_c, align_channels);
+    if (padded > out_c) {
+      p.pad_runs.push_back(
+          {0, out_c / A * out_pixels * A + out_c % A, padded - out_c});
+    }
+    p.repeat = out_pixels;
+    p.in_stride = A;
+    p.out_stride = A;
+    if (last >= 0) {
+      // 空间维也有gather时记录每个输出像素对应的输入像素
+      p.pixel_src.resize(out_pixels);
+      for (std::int64_t q = 0; q < out_pixels; ++q) {
+        std::int64_t src = 0;
+        for (int d = 0; d < rank - 1; ++d) {
+          std::int64_t o = q / out_pitch[d] % out_shape_hwc[d];
+          src += (maps[d].empty() ? o : maps[d][o]) * in_pitch[d];
+        }
+        p.pixel_src[q] = src;
+      }
+    }
+    return;
+  }
+
+  if (last < 0) {
+    p.repeat = 1;
+    p.in_stride = p.input_numel;
+    p.out_stride = p.output_numel;
+    p.runs.push_back({0, 0, p.input_numel});
+    return;
+  }
+  // 非C轴：通道块和first之前的维为outer（切片），last之后的维整段连续拷贝
+  p.repeat = padded_channels(in_shape_hwc[rank - 1], align_channels) / A;
+  for (int d = 0; d < first; ++d) {
+    p.repeat *= in_shape_hwc[d];
+  }
+  p.in_stride = in_pitch[first] * in_shape_hwc[first] * A;
+  p.out_stride = out_pitch[first] * out_shape_hwc[first] * A;
+  std::int64_t inner = in_pitch[last] * A;
+  std::int64_t count =
+      out_pitch[first] * out_shape_hwc[first] / out_pitch[last];
+  for (std::int64_t q = 0; q < count; ++q) {
+    std::int64_t src = 0, dst = 0;
+    for (int d = first; d <= last; ++d) {
+      std::int64_t o = q / (out_pitch[d] / out_pitch[last]) % out_shape_hwc[d];
+      src += (maps[d].empty() ? o : maps[d][o]) * in_pitch[d] * A;
+      dst += o * out_pitch[d] * A;
+    }
+    append_run(p.runs, src, dst, inner, 0);
+  }
+  if (p.runs.size() == 1 && p.runs[0].src == 0 &&
+      p.runs[0].len == p.in_stride && p.runs[0].len == p.out_stride) {
+    // 每个切片都是整段拷贝，合并成一次拷贝
+    p.runs[0].len *= p.repeat;
+    p.repeat = 1;
+  }
+}
+} // namespace
+
+int prepare_gather_chain(GatherPlan &plan,
+                         const std::vector<int> &in_shape_hwc,
+                         const std::vector<GatherOp> &ops,
+                         int align_channels) {
+  int rank = in_shape_hwc.size();
+  if (rank < 3 || rank > 5) {
+    std::cerr << "无效的输入形状：" << rank << std::endl;
+    return -1;
+  }
+  if (align_channels <= 0) {
+    std::cerr << "无效的align_channels：" << align_channels << std::endl;
+    return -1;
+  }
+  // 同一轴上的多次gather合并为indices_prev[indices]，只保留最终映射
+  AxisMaps maps(rank);
+  std::vector<int> out_shape_hwc = in_shape_hwc;
+  for (const GatherOp &op : ops) {
+    if (op.axis_chw < 0 || op.axis_chw >= rank) {
+      std::cerr << "无效的axis：" << op.axis_chw << std::endl;
+      return -1;
+    }
+    int axis_hwc = chw_axis_to_hwc(op.axis_chw, rank);
+    std::int64_t dim = out_shape_hwc[axis_hwc];
+    std::vector<std::int64_t> composed(op.indices.size());
+    for (std::size_t i = 0; i < op.indices.size(); ++i) {
+      std::int64_t idx = op.indices[i] >= 0 ? op.indices[i]
+                                            : op.indices[i] + dim;
+      if (idx < 0 || idx >= dim) {
+        std::cerr << "索引越界：" << op.indices[i] << std::endl;
+        return -1;
+      }
+      composed[i] = maps[axis_hwc].empty() ? idx : maps[axis_hwc][idx];
+    }
+    maps[axis_hwc] = std::move(composed);
+    out_shape_hwc[axis_hwc] = op.indices.size();
+  }
+  // 合并后恰好是恒等映射的轴（如先裁剪再原样取回）不再gather
+  for (int d = 0; d < rank; ++d) {
+    bool identity = out_shape_hwc[d] == in_shape_hwc[d];
+    for (std::size_t i = 0; identity && i < maps[d].size(); ++i) {
+      identity = maps[d][i] == static_cast<std::int64_t>(i);
+    }
+    if (identity) {
+      maps[d].clear();
+    }
+  }
+
+  GatherPlan p;
+  build_gather_plan(p, in_shape_hwc, out_shape_hwc, maps, align_channels);
+  plan = std::move(p);
+  return 0;
+}
+
+int prepare_gather_hwc(GatherPlan &plan, const std::vector<int> &in_shape_hwc,
+                       const std::vector<int> &indices, int axis_chw,
+                       int align_channels) {
+  return prepare_gather_chain(plan, in_shape_hwc, {GatherOp{axis_chw, indices}},
+                              align_channels);
+}
+
+// 16位存储、8位量化数据和融合精度转换支持的(输出类型, 输入类型)组合
+#define GATHER_PLAN_INSTANTIATE(out_t, in_t)                                  \
+  template int gather_hwc<out_t, in_t>(                                       \
+      std::vector<out_t> &, const std::vector<in_t> &, const GatherPlan &);   \
+  template int gather_hwc_range<out_t, in_t>(                                 \
+      out_t *, const in_t *, const GatherPlan &, std::int64_t, std::int64_t); \
+  template int gather_hwc_chain<out_t, in_t>(                                 \
+      std::vector<out_t> &, std::vector<int> &, const std::vector<in_t> &,    \
+      const std::vector<int> &, const std::vector<GatherOp> &, int);
+
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_hwc_range(out_t *out, const in_t *in, const GatherPlan &plan,
+                     std::int64_t begin, std::int64_t end) {
+  if (check_plan_range(plan, begin, end) != 0) {
+    return -1;
+  }
+  if (plan.channel_axis && !plan.pixel_src.empty()) {
+    std::int64_t A = plan.align_channels;
+    for (std::int64_t p = begin; p < end; ++p) {
+      const in_t *src = in + plan.pixel_src[p] * A;
+      out_t *dst = out + p * A;
+      for (const GatherRun &run : plan.runs) {
+        if (run.len < kMinLaneRun) {
+          for (std::int64_t c = 0; c < run.len; ++c) {
+            dst[run.dst + c] = elem_cast<out_t>(src[run.src + c]);
+          }
+        } else {
+          copy_run_rvv(dst + run.dst, src + run.src, run.len);
+        }
+      }
+    }
+    zero_pad_runs(out, plan, begin, end);
+    return 0;
+  }
+  if (plan.channel_axis) {
+    std::int64_t A = plan.align_channels;
+    for (const GatherRun &run : plan.runs) {
+      if (run.len < kMinLaneRun) {
+        for (std::int64_t c = 0; c < run.len; ++c) {
+          copy_lane_rvv(out + run.dst + c + begin * A,
+                        in + run.src + c + begin * A, A, end - begin);
+        }
+      } else {
+        for (std::int64_t p = begin; p < end; ++p) {
+          copy_run_rvv(out + run.dst + p * A, in + run.src + p * A, run.len);
+        }
+      }
+    }
+    zero_pad_runs(out, plan, begin, end);
+    return 0;
+  }
+  for (std::int64_t o = begin; o < end; ++o) {
+    const in_t *in_slice = in + o * plan.in_stride;
+    out_t *out_slice = out + o * plan.out_stride;
+    for (const GatherRun &run : plan.runs) {
+      copy_run_rvv(out_slice + run.dst, in_slice + run.src, run.len);
+    }
+  }
+  return 0;
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, const std::vector<in_t> &input,
+               const GatherPlan &plan) {
+  if (check_plan_input(output, input, plan) != 0) {
+    return -1;
+  }
+  return gather_hwc_range<out_t, in_t>(output.data(), input.data(), plan, 0,
+                                       plan.repeat);
+}
+
+
+template <typename out_t, typename in_t>
+int gather_hwc_chain(std::vector<out_t> &output,
+                     std::vector<int> &out_shape_hwc,
+                     const std::vector<in_t> &input,
+                     const std::vector<int> &in_shape_hwc,
+                     const std::vector<GatherOp> &ops, int align_channels) {
+  GatherPlan plan;
+  if (prepare_gather_chain(plan, in_shape_hwc, ops, align_channels) != 0 ||
+      gather_hwc<out_t, in_t>(output, input, plan) != 0) {
+    return -1;
+  }
+  out_shape_hwc = plan.out_shape_hwc;
+  return 0;
+}
+
+GATHER_PLAN_INSTANTIATE(float, float)
+GATHER_PLAN_INSTANTIATE(float16, float16)
+GATHER_PLAN_INSTANTIATE(bfloat16, bfloat16)
+GATHER_PLAN_INSTANTIATE(float, float16)
+GATHER_PLAN_INSTANTIATE(float16, float)
+GATHER_PLAN_INSTANTIATE(float, bfloat16)
+GATHER_PLAN_INSTANTIATE(bfloat16, float)
+GATHER_PLAN_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_PLAN_INSTANTIATE(std::uint8_t, std::uint8_t)
+} // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_hwc_range(out_t *out, const in_t *in, const GatherPlan &plan,
+                     std::int64_t begin, std::int64_t end) {
+  if (check_plan_range(plan, begin, end) != 0) {
+    return -1;
+  }
+  if (plan.channel_axis) {
+    std::int64_t A = plan.align_channels;
+    for (const GatherRun &run : plan.runs) {
+      for (std::int64_t c = 0; c < run.len; ++c) {
+        const in_t *src = in + run.src + c;
+        out_t *dst = out + run.dst + c;
+        for (std::int64_t p = begin; p < end; ++p) {
+          std::int64_t px = plan.pixel_src.empty() ? p : plan.pixel_src[p];
+          dst[p * A] = elem_cast<out_t>(src[px * A]);
+        }
+      }
+    }
+    zero_pad_runs(out, plan, begin, end);
+    return 0;
+  }
+  for (std::int64_t o = begin; o < end; ++o) {
+    const in_t *in_slice = in + o * plan.in_stride;
+    out_t *out_slice = out + o * plan.out_stride;
+    for (const GatherRun &run : plan.runs) {
+      copy_elems(out_slice + run.dst, in_slice + run.src, run.len);
+    }
+  }
+  return 0;
+}
+
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, const std::vector<in_t> &input,
+               const GatherPlan &plan) {
+  if (check_plan_input(output, input, plan) != 0) {
+    return -1;
+  }
+  return gather_hwc_range<out_t, in_t>(output.data(), input.data(), plan, 0,
+                                       plan.repeat);
+}
+
+
+template <typename out_t, typename in_t>
+int gather_hwc_chain(std::vector<out_t> &output,
+                     std::vector<int> &out_shape_hwc,
+                     const std::vector<in_t> &input,
+                     const std::vector<int> &in_shape_hwc,
+                     const std::vector<GatherOp> &ops, int align_channels) {
+  GatherPlan plan;
+  if (prepare_gather_chain(plan, in_shape_hwc, ops, align_channels) != 0 ||
+      gather_hwc<out_t, in_t>(output, input, plan) != 0) {
+    return -1;
+  }
+  out_shape_hwc = plan.out_shape_hwc;
+  return 0;
+}
+
+GATHER_PLAN_INSTANTIATE(float, float)
+GATHER_PLAN_INSTANTIATE(float16, float16)
+GATHER_PLAN_INSTANTIATE(bfloat16, bfloat16)
+GATHER_PLAN_INSTANTIATE(float, float16)
+GATHER_PLAN_INSTANTIATE(float16, float)
+GATHER_PLAN_INSTANTIATE(float, bfloat16)
+GATHER_PLAN_INSTANTIATE(bfloat16, float)
+GATHER_PLAN_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_PLAN_INSTANTIATE(std::uint8_t, std::uint8_t)
+} // namespace mem
+
+#undef GATHER_PLAN_INSTANTIATE
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "elem_type.h"
+
+// 一段连续拷贝：从输入偏移src拷贝len个元素到输出偏移dst（单位为元素）
+struct GatherRun {
+  std::int64_t src;
+  std::int64_t dst;
+  std::int64_t len;
+};
+
+// gather_hwc的预编译计划，形状、axis、索引和align_channels不变时只需准备一次。
+// axis映射、负索引处理、越界检查和全部偏移都在准备时完成，相邻的连续段会合并，
+// 执行时只做数据搬运。准备后不应再修改
+//   非C轴：runs描述一个outer切片内的拷贝，按in_stride/out_stride重复repeat次
+//   C轴：runs描述通道段，按输出像素重复repeat次，像素间步长为align_channels；
+//        pixel_src非空时为每个输出像素对应的输入像素（空间维也有gather），
+//        pad_runs为输出中需要置0的补齐通道
+struct GatherPlan {
+  std::vector<int> out_shape_hwc;
+  std::int64_t input_numel = 0;
+  std::int64_t output_numel = 0;
+  int align_channels = 0;
+  bool channel_axis = false;
+  std::int64_t repeat = 0;
+  std::int64_t in_stride = 0;
+  std::int64_t out_stride = 0;
+  std::vector<GatherRun> runs;
+  std::vector<GatherRun> pad_runs;
+  std::vector<std::int64_t> pixel_src;
+};
+
+// gather链中的一步：沿axis_chw按indices（展平）gather
+struct GatherOp {
+  int axis_chw;
+  std::vector<int> indices;
+};
+
+// 准备计划，参数含义与gather_hwc（展平索引）相同，参数错误时返回-1
+int prepare_gather_hwc(GatherPlan &plan, const std::vector<int> &in_shape_hwc,
+                       const std::vector<int> &indices, int axis_chw,
+                       int align_channels);
+
+// 把对同一张量依次进行的多次gather合并为一个计划：同一轴上的索引合并为
+// indices_prev[indices]，不同轴在一次多轴搬运中完成，不写任何中间张量。
+// 每一步的索引按上一步之后的形状检查
+int prepare_gather_chain(GatherPlan &plan,
+                         const std::vector<int> &in_shape_hwc,
+                         const std::vector<GatherOp> &ops,
+                         int align_channels);
+
+// 按计划执行gather，input的元素数必须与准备时的形状一致；
+// output按plan.output_numel分配，跨帧复用同一个output时不会重新分配内存。
+// 类型组合与gather_hwc相同
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, const std::vector<in_t> &input,
+               const GatherPlan &plan);
+
+// 只执行计划的第[begin, end)次重复（非C轴为outer切片，C轴为输出像素），
+// 不同范围写入的输出互不重叠，可以分给多个线程。output必须已按
+// plan.output_numel分配，input的元素数必须为plan.input_numel
+template <typename out_t, typename in_t>
+int gather_hwc_range(out_t *output, const in_t *input, const GatherPlan &plan,
+                     std::int64_t begin, std::int64_t end);
+
+// 一次性执行gather链（准备计划后立即执行），out_shape_hwc返回最终形状
+template <typename out_t, typename in_t>
+int gather_hwc_chain(std::vector<out_t> &output,
+                     std::vector<int> &out_shape_hwc,
+                     const std::vector<in_t> &input,
+                     const std::vector<int> &in_shape_hwc,
+                     const std::vector<GatherOp> &ops, int align_channels);
+}
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_hwc(std::vector<out_t> &output, const std::vector<in_t> &input,
+               const GatherPlan &plan);
+
+template <typename out_t, typename in_t>
+int gather_hwc_range(out_t *output, const in_t *input, const GatherPlan &plan,
+                     std::int64_t begin, std::int64_t end);
+
+template <typename out_t, typename in_t>
+int gather_hwc_chain(std::vector<out_t> &output,
+                     std::vector<int> &out_shape_hwc,
+                     const std::vector<in_t> &input,
+                     const std::vector<int> &in_shape_hwc,
+                     const std::vector<GatherOp> &ops, int align_channels);
+}
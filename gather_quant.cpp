@@ -0,0 +1,182 @@
+#include "gather_quant.h"
+
+#include <iostream>
+#include <utility>
+
+#include "gather.h"
+#include "gather_chw.h"
+#include "tensor_util.h"
+
+namespace {
+// 检查量化参数，quant_axis为量化轴在shape中的位置
+int check_quant_params(const QuantParams& params,
+                       const std::vector<int>& shape, int quant_axis) {
+  if (params.scales.empty()) {
+    std::cerr << "量化参数scales为空" << std::endl;
+    return -1;
+  }
+  if (!params.zero_points.empty() &&
+      params.zero_points.size() != params.scales.size()) {
+    std::cerr << "zero_points与scales长度不一致：" << params.zero_points.size()
+              << std::endl;
+    return -1;
+  }
+  if (params.scales.size() == 1) {
+    return 0;
+  }
+  if (quant_axis < 0 || quant_axis >= static_cast<int>(shape.size()) ||
+      params.scales.size() != static_cast<std::size_t>(shape[quant_axis])) {
+    std::cerr << "逐通道量化参数与量化轴不匹配：axis " << params.axis
+              << ", scales " << params.scales.size() << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+// 输出的量化参数：沿逐通道量化的轴gather时按indices取对应通道的参数，
+// dim为该轴大小；否则与输入相同
+int gather_quant_params(QuantParams& out_params, const QuantParams& in_params,
+                        const std::vector<int>& indices, bool along_quant_axis,
+                        int dim) {
+  if (in_params.scales.size() == 1 || !along_quant_axis) {
+    out_params = in_params;
+    return 0;
+  }
+  out_params.axis = in_params.axis;
+  out_params.scales.resize(indices.size());
+  out_params.zero_points.resize(
+      in_params.zero_points.empty() ? 0 : indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    if (indices[i] < -dim || indices[i] >= dim) {
+      std::cerr << "索引越界：" << indices[i] << std::endl;
+      return -1;
+    }
+    int idx = indices[i] >= 0 ? indices[i] : indices[i] + dim;
+    out_params.scales[i] = in_params.scales[idx];
+    if (!in_params.zero_points.empty()) {
+      out_params.zero_points[i] = in_params.zero_points[idx];
+    }
+  }
+  return 0;
+}
+
+// 分块HWC布局下检查参数并得到输出的量化参数，数据gather成功后再写回
+int gather_hwc_quant_params(QuantParams& out_params,
+                            const QuantParams& in_params,
+                            const std::vector<int>& in_shape_hwc,
+                            const std::vector<int>& indices, int axis_chw) {
+  int rank = in_shape_hwc.size();
+  int quant_axis = chw_axis_to_hwc(in_params.axis, rank);
+  if (check_quant_params(in_params, in_shape_hwc, quant_axis) != 0) {
+    return -1;
+  }
+  if (in_params.scales.size() != 1 && quant_axis != rank - 1) {
+    std::cerr << "分块HWC布局只支持沿C逐通道量化：axis " << in_params.axis
+              << std::endl;
+    return -1;
+  }
+  return gather_quant_params(out_params, in_params, indices,
+                             axis_chw == in_params.axis, in_shape_hwc.back());
+}
+
+int gather_chw_quant_params(QuantParams& out_params,
+                            const QuantParams& in_params,
+                            const std::vector<int>& in_shape,
+                            const std::vector<int>& indices, int axis) {
+  if (check_quant_params(in_params, in_shape, in_params.axis) != 0) {
+    return -1;
+  }
+  if (axis < 0 || axis >= static_cast<int>(in_shape.size())) {
+    std::cerr << "无效的axis：" << axis << std::endl;
+    return -1;
+  }
+  return gather_quant_params(out_params, in_params, indices,
+                             axis == in_params.axis, in_shape[axis]);
+}
+}  // namespace
+
+#define GATHER_QUANT_INSTANTIATE(T)                                           \
+  template int gather_hwc_quant<T>(                                           \
+      std::vector<T>&, QuantParams&, const std::vector<T>&,                   \
+      const QuantParams&, const std::vector<int>&, const std::vector<int>&,   \
+      int, int);                                                              \
+  template int gather_chw_quant<T>(                                           \
+      std::vector<T>&, QuantParams&, const std::vector<T>&,                   \
+      const QuantParams&, const std::vector<int>&, const std::vector<int>&,   \
+      int);
+
+namespace rvv {
+template <typename T>
+int gather_hwc_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape_hwc,
+                     const std::vector<int>& indices, int axis_chw,
+                     int align_channels) {
+  QuantParams params;
+  if (gather_hwc_quant_params(params, in_params, in_shape_hwc, indices,
+                              axis_chw) != 0 ||
+      gather_hwc<T, T>(output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels) != 0) {
+    return -1;
+  }
+  out_params = std::move(params);
+  return 0;
+}
+
+template <typename T>
+int gather_chw_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape,
+                     const std::vector<int>& indices, int axis) {
+  QuantParams params;
+  if (gather_chw_quant_params(params, in_params, in_shape, indices, axis) !=
+          0 ||
+      gather_chw<T, T>(output, input, in_shape, indices, axis) != 0) {
+    return -1;
+  }
+  out_params = std::move(params);
+  return 0;
+}
+
+GATHER_QUANT_INSTANTIATE(std::int8_t)
+GATHER_QUANT_INSTANTIATE(std::uint8_t)
+}  // namespace rvv
+
+namespace mem {
+template <typename T>
+int gather_hwc_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape_hwc,
+                     const std::vector<int>& indices, int axis_chw,
+                     int align_channels) {
+  QuantParams params;
+  if (gather_hwc_quant_params(params, in_params, in_shape_hwc, indices,
+                              axis_chw) != 0 ||
+      gather_hwc<T, T>(output, input, in_shape_hwc, indices, axis_chw,
+                       align_channels) != 0) {
+    return -1;
+  }
+  out_params = std::move(params);
+  return 0;
+}
+
+template <typename T>
+int gather_chw_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape,
+                     const std::vector<int>& indices, int axis) {
+  QuantParams params;
+  if (gather_chw_quant_params(params, in_params, in_shape, indices, axis) !=
+          0 ||
+      gather_chw<T, T>(output, input, in_shape, indices, axis) != 0) {
+    return -1;
+  }
+  out_params = std::move(params);
+  return 0;
+}
+
+GATHER_QUANT_INSTANTIATE(std::int8_t)
+GATHER_QUANT_INSTANTIATE(std::uint8_t)
+}  // namespace mem
+
+#undef GATHER_QUANT_INSTANTIATE
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// int8_t/uint8_t量化张量的量化参数，随数据一起传递，实际值为
+// (q - zero_point) * scale。scales只有1个元素时按张量量化；否则沿axis
+// （CHW编号）逐通道量化，长度等于该维大小。zero_points为空表示全为0，
+// 否则与scales等长
+struct QuantParams {
+  std::vector<float> scales;
+  std::vector<int> zero_points;
+  int axis = 0;
+};
+
+// 量化张量的gather：数据按位搬运，不反量化。逐通道量化且沿量化轴gather时
+// 输出的scales/zero_points按indices同步gather，其它情况与输入参数相同。
+// 分块HWC布局只支持沿C逐通道量化（axis为C的CHW编号），
+// 布局转换（convert_*<int8_t, int8_t>等）不改变量化参数
+namespace rvv {
+template <typename T>
+int gather_hwc_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape_hwc,
+                     const std::vector<int>& indices, int axis_chw,
+                     int align_channels);
+
+template <typename T>
+int gather_chw_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape,
+                     const std::vector<int>& indices, int axis);
+}
+
+namespace mem {
+template <typename T>
+int gather_hwc_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape_hwc,
+                     const std::vector<int>& indices, int axis_chw,
+                     int align_channels);
+
+template <typename T>
+int gather_chw_quant(std::vector<T>& output, QuantParams& out_params,
+                     const std::vector<T>& input, const QuantParams& in_params,
+                     const std::vector<int>& in_shape,
+                     const std::vector<int>& indices, int axis);
+}
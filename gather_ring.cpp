@@ -0,0 +1,164 @@
+#include "gather_ring.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "gather.h"
+#include "tensor_util.h"
+
+template <typename T>
+FrameRing<T>::FrameRing(const std::vector<int>& frame_shape_hwc, int capacity,
+                        int align_channels)
+    : frame_shape_hwc_(frame_shape_hwc), capacity_(capacity),
+      align_channels_(align_channels) {
+  if (frame_shape_hwc.size() != 4) {
+    throw std::invalid_argument("帧形状必须为{N, H, W, C}");
+  }
+  for (int d : frame_shape_hwc) {
+    if (d <= 0) {
+      throw std::invalid_argument("帧形状的各维必须为正");
+    }
+  }
+  if (capacity <= 0 || align_channels <= 0) {
+    throw std::invalid_argument("窗口容量和align_channels必须为正");
+  }
+  num_blocks_ = padded_channels(frame_shape_hwc[3], align_channels) /
+                align_channels;
+  frame_block_numel_ = blocked_numel(frame_shape_hwc, align_channels) /
+                       num_blocks_;
+  data_.resize(static_cast<std::size_t>(frame_block_numel_) * num_blocks_ *
+               capacity_);
+}
+
+template <typename T>
+int FrameRing<T>::push(const std::vector<T>& frame) {
+  return push_frame(frame.data(), frame.size());
+}
+
+template <typename T>
+int FrameRing<T>::push(const AlignedVector<T>& frame) {
+  return push_frame(frame.data(), frame.size());
+}
+
+template <typename T>
+int FrameRing<T>::push_frame(const T* frame, std::size_t size) {
+  if (static_cast<std::int64_t>(size) != frame_block_numel_ * num_blocks_) {
+    std::cerr << "帧的元素数与窗口不匹配：" << size << std::endl;
+    return -1;
+  }
+  // 每个通道块写入该块内head_槽的位置，其余槽不动
+  for (int cb = 0; cb < num_blocks_; ++cb) {
+    copy_elems(data_.data() +
+                   (static_cast<std::int64_t>(cb) * capacity_ + head_) *
+                       frame_block_numel_,
+               frame + cb * frame_block_numel_, frame_block_numel_);
+  }
+  head_ = (head_ + 1) % capacity_;
+  if (size_ < capacity_) {
+    ++size_;
+  }
+  ++frames_pushed_;
+  return 0;
+}
+
+template <typename T>
+void FrameRing<T>::clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+template <typename T>
+int FrameRing<T>::slot(int index) const {
+  int i = index >= 0 ? index : index + size_;
+  if (i < 0 || i >= size_) {
+    return -1;
+  }
+  // 最旧一帧在head_ - size_处
+  return (head_ - size_ + i + capacity_) % capacity_;
+}
+
+template <typename T>
+std::vector<int> FrameRing<T>::storage_shape_hwc() const {
+  return {capacity_, frame_shape_hwc_[0], frame_shape_hwc_[1],
+          frame_shape_hwc_[2], frame_shape_hwc_[3]};
+}
+
+template class FrameRing<float>;
+template class FrameRing<float16>;
+template class FrameRing<bfloat16>;
+template class FrameRing<std::int8_t>;
+template class FrameRing<std::uint8_t>;
+
+namespace {
+// 把相对窗口的索引换算成槽号
+template <typename T>
+int ring_slots(std::vector<int>& slots, const FrameRing<T>& ring,
+               const std::vector<int>& indices) {
+  slots.resize(indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    slots[i] = ring.slot(indices[i]);
+    if (slots[i] < 0) {
+      std::cerr << "索引越界：" << indices[i] << "（窗口内" << ring.size()
+                << "帧）" << std::endl;
+      return -1;
+    }
+  }
+  return 0;
+}
+}  // namespace
+
+// 支持的(输出类型, 输入类型)组合，与gather_hwc相同
+#define GATHER_RING_INSTANTIATE(out_t, in_t)                                   \
+  template int gather_ring<out_t, in_t>(AlignedVector<out_t>&,                 \
+                                        const FrameRing<in_t>&,                \
+                                        const std::vector<int>&);
+
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_ring(AlignedVector<out_t>& output, const FrameRing<in_t>& ring,
+                const std::vector<int>& indices) {
+  std::vector<int> slots;
+  if (ring_slots(slots, ring, indices) != 0) {
+    return -1;
+  }
+  return gather_hwc<out_t, in_t>(output, ring.storage(),
+                                 ring.storage_shape_hwc(), slots, 0,
+                                 ring.align_channels());
+}
+
+GATHER_RING_INSTANTIATE(float, float)
+GATHER_RING_INSTANTIATE(float16, float16)
+GATHER_RING_INSTANTIATE(bfloat16, bfloat16)
+GATHER_RING_INSTANTIATE(float, float16)
+GATHER_RING_INSTANTIATE(float16, float)
+GATHER_RING_INSTANTIATE(float, bfloat16)
+GATHER_RING_INSTANTIATE(bfloat16, float)
+GATHER_RING_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_RING_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_ring(AlignedVector<out_t>& output, const FrameRing<in_t>& ring,
+                const std::vector<int>& indices) {
+  std::vector<int> slots;
+  if (ring_slots(slots, ring, indices) != 0) {
+    return -1;
+  }
+  return gather_hwc<out_t, in_t>(output, ring.storage(),
+                                 ring.storage_shape_hwc(), slots, 0,
+                                 ring.align_channels());
+}
+
+GATHER_RING_INSTANTIATE(float, float)
+GATHER_RING_INSTANTIATE(float16, float16)
+GATHER_RING_INSTANTIATE(bfloat16, bfloat16)
+GATHER_RING_INSTANTIATE(float, float16)
+GATHER_RING_INSTANTIATE(float16, float)
+GATHER_RING_INSTANTIATE(float, bfloat16)
+GATHER_RING_INSTANTIATE(bfloat16, float)
+GATHER_RING_INSTANTIATE(std::int8_t, std::int8_t)
+GATHER_RING_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace mem
+
+#undef GATHER_RING_INSTANTIATE
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "elem_type.h"
+
+// 时序滑动窗口：最近capacity帧按环形缓冲保存，存储本身就是L维为capacity的
+// 5D分块LNHWC张量[cb][slot][N][H][W][A]，新帧直接写入最旧帧所在的槽，
+// 不移动窗口中的其他帧。每帧为4D分块NHWC张量[cb][N][H][W][A]
+// （如convert_nchw_to_nhwc_4d的输出），frame_shape_hwc为{N, H, W, C}
+//   FrameRing<float> ring({1, 40, 40, 64}, 8, 16);
+//   ring.push(frame);
+//   rvv::gather_ring(output, ring, {-1, -3, -5});  // 最新、前2帧、前4帧
+template <typename T>
+class FrameRing {
+ public:
+  // capacity<=0、align_channels<=0或形状不是4维时抛出std::invalid_argument
+  FrameRing(const std::vector<int>& frame_shape_hwc, int capacity,
+            int align_channels);
+
+  // 追加一帧，窗口已满时覆盖最旧的一帧；帧大小不符时返回-1
+  int push(const std::vector<T>& frame);
+  int push(const AlignedVector<T>& frame);
+
+  // 清空窗口（不释放存储）
+  void clear();
+
+  // 窗口内第index帧所在的槽：0为最旧，size()-1为最新，负数从最新一帧倒数
+  // （-1为最新）。越界时返回-1
+  int slot(int index) const;
+
+  int size() const { return size_; }
+  int capacity() const { return capacity_; }
+  int align_channels() const { return align_channels_; }
+  std::int64_t frames_pushed() const { return frames_pushed_; }
+  const std::vector<int>& frame_shape_hwc() const { return frame_shape_hwc_; }
+  // 存储的形状{capacity, N, H, W, C}，槽按物理顺序排列
+  std::vector<int> storage_shape_hwc() const;
+  const AlignedVector<T>& storage() const { return data_; }
+
+ private:
+  int push_frame(const T* frame, std::size_t size);
+
+  std::vector<int> frame_shape_hwc_;
+  int capacity_;
+  int align_channels_;
+  std::int64_t frame_block_numel_;  // 一帧中一个通道块的元素数N*H*W*A
+  int num_blocks_;
+  int head_ = 0;  // 下一帧写入的槽
+  int size_ = 0;
+  std::int64_t frames_pushed_ = 0;
+  AlignedVector<T> data_;
+};
+
+// 沿L维从窗口中取帧：indices相对窗口（含义同FrameRing::slot），换算成槽号
+// 后直接在环形存储上gather，输出与先按时间顺序拼出L=size()的5D张量再沿
+// axis_lcnhw=0做gather_hwc相同，不拷贝整个窗口。其他轴先用本函数取出
+// 需要的帧再gather。索引越界时返回-1。类型组合与gather_hwc相同（含float）
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather_ring(AlignedVector<out_t>& output, const FrameRing<in_t>& ring,
+                const std::vector<int>& indices);
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather_ring(AlignedVector<out_t>& output, const FrameRing<in_t>& ring,
+                const std::vector<int>& indices);
+}  // namespace mem
@@ -0,0 +1,386 @@
+#include "gather_tune.h"
+
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "gather.h"
+#include "gather_chw.h"
+#include "rvv_tune.h"
+#include "tensor_util.h"
+
+namespace {
+constexpr int kLmuls[] = {1, 2, 4, 8};
+constexpr int kPrefetchDistances[] = {1, 2, 4, 8, 16};
+constexpr int kSweepAligns[] = {16, 32, 64};
+// 扫描时各长度档的单次搬运字节数（各档的上限，与rvv_tune.cpp一致）
+constexpr std::size_t kSweepBytes[kRvvSizeClasses] = {64, 256, 1024, 4096,
+                                                      16384};
+// 扫描形状的外层维按输入约64K个元素（256KB）设置
+constexpr int kSweepElems = 64 * 1024;
+// 被gather的轴长度和索引数
+constexpr int kSweepDim = 16;
+
+using TuneTable = std::map<GatherTuneKey, GatherTuneEntry>;
+// CPU签名 -> 该CPU的记录
+using TuneCache = std::map<std::string, TuneTable>;
+
+std::string read_cpu_signature() {
+  std::ifstream in("/proc/cpuinfo");
+  std::string line, uarch, isa, model;
+  while (std::getline(in, line)) {
+    std::size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    std::string name = line.substr(0, colon);
+    std::string value = line.substr(colon + 1);
+    name.erase(name.find_last_not_of(" \t") + 1);
+    value.erase(0, value.find_first_not_of(" \t"));
+    if (name == "uarch" && uarch.empty()) {
+      uarch = value;
+    } else if (name == "isa" && isa.empty()) {
+      isa = value;
+    } else if (name == "model name" && model.empty()) {
+      model = value;
+    }
+  }
+  std::string sig = uarch;
+  if (!isa.empty()) {
+    sig += sig.empty() ? isa : "," + isa;
+  }
+  if (sig.empty()) {
+    sig = model.empty() ? "unknown" : model;
+  }
+  sig += ",vlen=" + std::to_string(rvv_vlenb() * 8);
+  for (char& ch : sig) {
+    if (std::isspace(static_cast<unsigned char>(ch))) {
+      ch = '_';
+    }
+  }
+  return sig;
+}
+
+int load_cache(TuneCache& cache, const char* path) {
+  std::ifstream in(path);
+  if (!in) {
+    std::cerr << "无法打开调优缓存：" << path << std::endl;
+    return -1;
+  }
+  std::string line;
+  int line_no = 0;
+  while (std::getline(in, line)) {
+    ++line_no;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string cpu;
+    GatherTuneKey key;
+    GatherTuneEntry entry;
+    if (!(fields >> cpu >> key.rank >> key.axis_chw >> key.align_channels >>
+          key.size_class >> entry.lmul >> entry.prefetch_distance) ||
+        key.size_class < 0 || key.size_class >= kRvvSizeClasses ||
+        (entry.lmul != 0 && entry.lmul != 1 && entry.lmul != 2 &&
+         entry.lmul != 4 && entry.lmul != 8) ||
+        entry.prefetch_distance < 0) {
+      std::cerr << "无效的调优缓存：" << path << ":" << line_no << std::endl;
+      return -1;
+    }
+    cache[cpu][key] = entry;
+  }
+  return 0;
+}
+
+// 只通过gather_tune_load/gather_tune_set写入，入口查询不会读文件
+TuneCache& tune_cache() {
+  static TuneCache cache;
+  return cache;
+}
+
+// 当前CPU的记录，在缓存改动时解析一次，入口查询不再按签名查找；
+// 没有当前CPU的记录时为空，入口直接走默认规则
+const TuneTable* g_current_table = nullptr;
+
+void resolve_current_table() {
+  TuneCache& cache = tune_cache();
+  auto cpu = cache.find(gather_tune_cpu_signature());
+  g_current_table =
+      cpu == cache.end() || cpu->second.empty() ? nullptr : &cpu->second;
+}
+
+template <typename Fn>
+float time_ms(Fn fn, int repeat) {
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    fn();
+  }
+  gettimeofday(&end, NULL);
+  return ((end.tv_sec - start.tv_sec) * 1000000.0 +
+          (end.tv_usec - start.tv_usec)) /
+         1000.0 / repeat;
+}
+
+// 扫描中的一个形状：key为该形状在入口处查询的键
+struct SweepCase {
+  GatherTuneKey key;
+  bool chw;
+  std::vector<int> in_shape;
+  std::vector<int> indices;
+};
+
+std::vector<int> sweep_indices(int count, int dim) {
+  std::vector<int> indices(count);
+  for (int i = 0; i < count; ++i) {
+    // 固定的伪随机排列，保证每次调优的访问模式相同
+    indices[i] = (i * 7 + 3) % dim;
+  }
+  return indices;
+}
+
+// 合成分块HWC形状，使单次搬运落在长度档c：C轴为c档字节数对应的像素数，
+// W轴为一个像素（只有align_channels所在的档），其余轴为轴之后的切片。
+// 该组合得不到目标档时返回false
+bool hwc_sweep_case(SweepCase& sc, int rank, int axis_chw, int align,
+                    int c) {
+  const int elems = kSweepBytes[c] / sizeof(float);
+  const int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  std::vector<int> shape(rank, 1);
+  if (axis_hwc == rank - 1) {
+    shape[rank - 2] = elems;
+    shape[rank - 1] = 2 * align;
+    sc.indices = sweep_indices(align, 2 * align);
+  } else if (axis_hwc == rank - 2) {
+    if (rvv_size_class(align * sizeof(float)) != c) {
+      return false;
+    }
+    shape[rank - 2] = kSweepDim * 4;
+    shape[rank - 1] = align;
+    if (rank > 3) {
+      shape[rank - 3] = kSweepDim * 4;
+    }
+    sc.indices = sweep_indices(kSweepDim * 4, kSweepDim * 4);
+  } else {
+    if (elems % align != 0) {
+      return false;
+    }
+    shape[axis_hwc] = kSweepDim;
+    shape[rank - 1] = align;
+    if (axis_hwc + 1 < rank - 1) {
+      shape[rank - 2] = elems / align;
+    }
+    if (axis_hwc > 0) {
+      shape[0] = std::max(1, kSweepElems / (kSweepDim * elems));
+    }
+    sc.indices = sweep_indices(kSweepDim, kSweepDim);
+  }
+  sc.key = {rank, axis_chw, align, c};
+  sc.chw = false;
+  sc.in_shape = shape;
+  return true;
+}
+
+// CHW形状：被gather的轴之后的块为c档字节数，最后一维gather走小块内核，不参与
+bool chw_sweep_case(SweepCase& sc, int rank, int axis, int c) {
+  if (axis == rank - 1) {
+    return false;
+  }
+  const int elems = kSweepBytes[c] / sizeof(float);
+  std::vector<int> shape(rank, 1);
+  shape[axis] = kSweepDim;
+  shape[rank - 1] = elems;
+  if (axis > 0) {
+    shape[0] = std::max(1, kSweepElems / (kSweepDim * elems));
+  }
+  sc.key = {rank, axis, 0, c};
+  sc.chw = true;
+  sc.in_shape = shape;
+  sc.indices = sweep_indices(kSweepDim, kSweepDim);
+  return true;
+}
+
+std::vector<SweepCase> sweep_cases() {
+  std::vector<SweepCase> cases;
+  SweepCase sc;
+  for (int rank = 3; rank <= 5; ++rank) {
+    for (int axis = 0; axis < rank; ++axis) {
+      for (int align : kSweepAligns) {
+        for (int c = 0; c < kRvvSizeClasses; ++c) {
+          if (hwc_sweep_case(sc, rank, axis, align, c)) {
+            cases.push_back(sc);
+          }
+        }
+      }
+    }
+  }
+  for (int rank = 3; rank <= 4; ++rank) {
+    for (int axis = 0; axis < rank; ++axis) {
+      for (int c = 0; c < kRvvSizeClasses; ++c) {
+        if (chw_sweep_case(sc, rank, axis, c)) {
+          cases.push_back(sc);
+        }
+      }
+    }
+  }
+  return cases;
+}
+}  // namespace
+
+bool operator<(const GatherTuneKey& a, const GatherTuneKey& b) {
+  if (a.rank != b.rank) {
+    return a.rank < b.rank;
+  }
+  if (a.axis_chw != b.axis_chw) {
+    return a.axis_chw < b.axis_chw;
+  }
+  if (a.align_channels != b.align_channels) {
+    return a.align_channels < b.align_channels;
+  }
+  return a.size_class < b.size_class;
+}
+
+const std::string& gather_tune_cpu_signature() {
+  static const std::string sig = read_cpu_signature();
+  return sig;
+}
+
+const char* gather_tune_default_path() {
+  const char* path = std::getenv("GATHER_TUNE_CACHE");
+  return path != NULL && path[0] != '\0' ? path : "gather_tune.txt";
+}
+
+bool gather_tune_find(GatherTuneEntry& entry, const GatherTuneKey& key) {
+  if (g_current_table == nullptr) {
+    return false;
+  }
+  auto it = g_current_table->find(key);
+  if (it == g_current_table->end()) {
+    return false;
+  }
+  entry = it->second;
+  return true;
+}
+
+void gather_tune_set(const GatherTuneKey& key, const GatherTuneEntry& entry) {
+  TuneTable& table = tune_cache()[gather_tune_cpu_signature()];
+  if (entry.lmul == 0 && entry.prefetch_distance == 0) {
+    table.erase(key);
+  } else {
+    table[key] = entry;
+  }
+  resolve_current_table();
+}
+
+void gather_tune_clear() {
+  tune_cache().clear();
+  g_current_table = nullptr;
+}
+
+int gather_tune_load(const char* path) {
+  // 先读入临时表，格式错误时不改动现有缓存
+  TuneCache loaded;
+  if (load_cache(loaded, path) != 0) {
+    return -1;
+  }
+  TuneCache& cache = tune_cache();
+  for (const auto& cpu : loaded) {
+    for (const auto& kv : cpu.second) {
+      cache[cpu.first][kv.first] = kv.second;
+    }
+  }
+  resolve_current_table();
+  return 0;
+}
+
+int gather_tune_save(const char* path) {
+  FILE* fp = fopen(path, "w");
+  if (fp == NULL) {
+    std::cerr << "无法写入调优缓存：" << path << std::endl;
+    return -1;
+  }
+  fprintf(fp, "# cpu rank axis_chw align_channels size_class lmul "
+              "prefetch_distance\n");
+  for (const auto& cpu : tune_cache()) {
+    for (const auto& kv : cpu.second) {
+      fprintf(fp, "%s %d %d %d %d %d %d\n", cpu.first.c_str(), kv.first.rank,
+              kv.first.axis_chw, kv.first.align_channels, kv.first.size_class,
+              kv.second.lmul, kv.second.prefetch_distance);
+    }
+  }
+  return fclose(fp) == 0 ? 0 : -1;
+}
+
+int gather_tune_all(const char* path, int repeat, bool verbose) {
+  int count = 0;
+  for (const SweepCase& sc : sweep_cases()) {
+    const GatherTuneKey& key = sc.key;
+    std::vector<float> input(sc.chw ? shape_numel(sc.in_shape)
+                                    : blocked_numel(sc.in_shape,
+                                                    key.align_channels));
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<float>(i % 1024);
+    }
+    std::vector<float> output;
+    auto run = [&] {
+      if (sc.chw) {
+        rvv::gather_chw(output, input, sc.in_shape, sc.indices,
+                        key.axis_chw);
+      } else {
+        rvv::gather_hwc(output, input, sc.in_shape, sc.indices, key.axis_chw,
+                        key.align_channels);
+      }
+    };
+    // 先预热一轮，使输入进入缓存、输出分配好
+    run();
+
+    GatherTuneEntry best;
+    float best_time = -1.0f;
+    for (int lmul : kLmuls) {
+      gather_tune_set(key, {lmul, 0});
+      float t = time_ms(run, repeat);
+      if (best_time < 0 || t < best_time) {
+        best_time = t;
+        best.lmul = lmul;
+      }
+    }
+
+    // 非C轴的切片位置由索引决定，再测预取距离（入口从缓存读取）
+    bool prefetch = !sc.chw && chw_axis_to_hwc(key.axis_chw, key.rank) <
+                                   key.rank - 1;
+    if (prefetch) {
+      float best_prefetch = -1.0f;
+      for (int distance : kPrefetchDistances) {
+        gather_tune_set(key, {best.lmul, distance});
+        float t = time_ms(
+            [&] {
+              rvv::gather_hwc_prefetch(output, input, sc.in_shape, sc.indices,
+                                       key.axis_chw, key.align_channels);
+            },
+            repeat);
+        if (best_prefetch < 0 || t < best_prefetch) {
+          best_prefetch = t;
+          best.prefetch_distance = distance;
+        }
+      }
+    }
+    gather_tune_set(key, best);
+    ++count;
+    if (verbose) {
+      printf("gather tune %s rank%d,axis_%d,channel_%2d,%6zu B,m%d,"
+             "prefetch %2d,%7.3f ms\n",
+             sc.chw ? "chw" : "hwc", key.rank, key.axis_chw,
+             key.align_channels, kSweepBytes[key.size_class], best.lmul,
+             best.prefetch_distance, best_time);
+    }
+  }
+  return gather_tune_save(path) == 0 ? count : -1;
+}
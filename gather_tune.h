@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+
+// 持久化的调优缓存：按(CPU签名, rank, axis, align_channels, 长度档)记录
+// 调优结果，进程启动后不必重新调优。rvv::gather_hwc、gather_hwc_prefetch和
+// rvv::gather_chw在入口处查询：命中时用记录的LMUL和预取距离，未命中时按
+// rvv_lmul和gather_prefetch_distance选择（与原行为一致）。
+// 长度档与rvv_tune.h相同，按单次搬运的字节数计算（C轴为跨步搬运的像素数）；
+// gather_chw的align_channels记为0。
+// 缓存初始为空，只通过gather_tune_load显式加载（如启动时加载
+// gather_tune_default_path()），入口查询不会读文件或/proc/cpuinfo。
+// 与LMUL表一样是进程内全局的，加载、设置和调优应在启动多线程gather之前完成
+struct GatherTuneKey {
+  int rank;
+  int axis_chw;
+  int align_channels;
+  int size_class;
+};
+
+bool operator<(const GatherTuneKey& a, const GatherTuneKey& b);
+
+// 为0的字段表示未调优，按默认规则选择
+struct GatherTuneEntry {
+  int lmul = 0;
+  int prefetch_distance = 0;
+};
+
+// CPU签名：/proc/cpuinfo中的uarch/isa（x86上为model name）加上运行时的VLEN，
+// 空白替换为'_'；读不到cpuinfo时为"unknown"。换板或换VLEN后旧记录不会被误用
+const std::string& gather_tune_cpu_signature();
+
+// 缓存文件路径：环境变量GATHER_TUNE_CACHE，
+// 未设置时为当前目录下的gather_tune.txt
+const char* gather_tune_default_path();
+
+// 查询当前CPU下的记录（加载或设置时已解析出当前CPU的表），未命中时返回false
+bool gather_tune_find(GatherTuneEntry& entry, const GatherTuneKey& key);
+
+// 设置当前CPU下的一条记录，字段都为0时删除该记录
+void gather_tune_set(const GatherTuneKey& key, const GatherTuneEntry& entry);
+
+// 清空缓存（包括其他CPU的记录）
+void gather_tune_clear();
+
+// 从文件加载并合并到缓存（同键覆盖），其他CPU的记录也保留，
+// 以便保存后多块板共用同一个文件。打不开或格式错误时返回-1
+int gather_tune_load(const char* path);
+
+// 把缓存中全部CPU的记录写入文件，失败时返回-1
+int gather_tune_save(const char* path);
+
+// 离线调优：对合成形状扫描（rank 3~5的每个axis、align_channels为16/32/64、
+// 每个长度档；以及gather_chw），实测每个键下m1/m2/m4/m8和非C轴的预取距离
+// 1/2/4/8/16，把最快的组合写入缓存并保存到path。repeat为每次测量的重复次数，
+// verbose时打印每个键的结果。返回写入的记录数，保存失败时返回-1
+int gather_tune_all(const char* path, int repeat = 20, bool verbose = false);
@@ -0,0 +1,303 @@
+#include "gather_view.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "gather_plan.h"
+#include "rvv_elem.h"
+#include "tensor_util.h"
+
+namespace {
+// 偏移表[begin, end)中源偏移连续的段，dst为相对begin的位置
+std::vector<GatherRun> table_runs(const std::vector<std::int64_t> &table,
+                                  std::int64_t begin, std::int64_t end) {
+  std::vector<GatherRun> runs;
+  for (std::int64_t i = begin; i < end; ++i) {
+    if (!runs.empty() && runs.back().src + runs.back().len == table[i]) {
+      ++runs.back().len;
+    } else {
+      runs.push_back({table[i], i - begin, 1});
+    }
+  }
+  return runs;
+}
+
+struct RvvRunCopy {
+  template <typename T>
+  void operator()(T *dst, const T *src, std::int64_t len) const {
+    using Copy = RvvCopy<T, T>;
+    std::size_t n = len;
+    while (n > 0) {
+      std::size_t vl = Copy::setvl(n);
+      Copy::copy(dst, src, vl);
+      src += vl;
+      dst += vl;
+      n -= vl;
+    }
+  }
+};
+
+struct MemRunCopy {
+  template <typename T>
+  void operator()(T *dst, const T *src, std::int64_t len) const {
+    copy_elems(dst, src, len);
+  }
+};
+
+// read_view的公共部分：外层各维逐行求出行基址，最内层按连续段搬运，
+// 单个元素的段直接赋值
+template <typename T, typename RunCopy>
+int read_view_impl(std::vector<T> &output, const GatherView<T> &view,
+                   const std::vector<int> &out_order, int block_axis,
+                   int align_channels, RunCopy copy_run) {
+  int rank = view.shape.size();
+  std::vector<int> seen(rank, 0);
+  for (int d : out_order) {
+    if (d < 0 || d >= rank || seen[d]++) {
+      std::cerr << "无效的输出维顺序：" << d << std::endl;
+      return -1;
+    }
+  }
+  if (rank == 0 || static_cast<int>(out_order.size()) != rank ||
+      (block_axis >= 0 && (block_axis >= rank || align_channels <= 0))) {
+    std::cerr << "无效的输出维顺序或分块维：" << block_axis << std::endl;
+    return -1;
+  }
+
+  // 行维（不含最内层）：分块时为除分块维外的全部维，否则为除最后一维外的维
+  std::vector<int> row_dims;
+  for (int d : out_order) {
+    if (d != block_axis) {
+      row_dims.push_back(d);
+    }
+  }
+  int inner_dim = -1;
+  std::int64_t row_len = align_channels;
+  std::int64_t blocks = 1;
+  if (block_axis < 0) {
+    inner_dim = row_dims.back();
+    row_dims.pop_back();
+    row_len = view.shape[inner_dim];
+  } else {
+    blocks = padded_channels(view.shape[block_axis], align_channels) /
+             align_channels;
+  }
+  std::int64_t rows = 1;
+  for (int d : row_dims) {
+    rows *= view.shape[d];
+  }
+  output.resize(blocks * rows * row_len);
+  if (output.empty()) {
+    return 0;
+  }
+
+  T *out = output.data();
+  std::vector<int> idx(row_dims.size());
+  for (std::int64_t b = 0; b < blocks; ++b) {
+    std::vector<GatherRun> runs;
+    std::int64_t lanes = row_len;
+    if (block_axis < 0) {
+      runs = table_runs(view.offsets[inner_dim], 0, row_len);
+    } else {
+      std::int64_t C = view.shape[block_axis];
+      lanes = std::min<std::int64_t>(align_channels, C - b * align_channels);
+      runs = table_runs(view.offsets[block_axis], b * align_channels,
+                        b * align_channels + lanes);
+    }
+    std::fill(idx.begin(), idx.end(), 0);
+    for (std::int64_t r = 0; r < rows; ++r) {
+      std::int64_t base = 0;
+      for (std::size_t k = 0; k < row_dims.size(); ++k) {
+        base += view.offsets[row_dims[k]][idx[k]];
+      }
+      const T *src = view.base + base;
+      for (const GatherRun &run : runs) {
+        if (run.len == 1) {
+          out[run.dst] = src[run.src];
+        } else {
+          copy_run(out + run.dst, src + run.src, run.len);
+        }
+      }
+      std::fill(out + lanes, out + row_len, T());
+      out += row_len;
+      for (int k = static_cast<int>(idx.size()) - 1;
+           k >= 0 && ++idx[k] == view.shape[row_dims[k]]; --k) {
+        idx[k] = 0;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename T>
+std::vector<int> view_order(const GatherView<T> &view) {
+  std::vector<int> order(view.shape.size());
+  for (std::size_t d = 0; d < order.size(); ++d) {
+    order[d] = d;
+  }
+  return order;
+}
+} // namespace
+
+template <typename T>
+int make_view_chw(GatherView<T> &view, const std::vector<T> &input,
+                  const std::vector<int> &in_shape) {
+  if (static_cast<std::int64_t>(input.size()) != shape_numel(in_shape)) {
+    std::cerr << "输入数据大小与形状不匹配：" << input.size() << std::endl;
+    return -1;
+  }
+  int rank = in_shape.size();
+  view.base = input.data();
+  view.shape = in_shape;
+  view.align_channels = 0;
+  view.offsets.assign(rank, {});
+  std::int64_t stride = 1;
+  for (int d = rank - 1; d >= 0; --d) {
+    view.offsets[d].resize(in_shape[d]);
+    for (int i = 0; i < in_shape[d]; ++i) {
+      view.offsets[d][i] = i * stride;
+    }
+    stride *= in_shape[d];
+  }
+  return 0;
+}
+
+template <typename T>
+int make_view_hwc(GatherView<T> &view, const std::vector<T> &input,
+                  const std::vector<int> &in_shape_hwc, int align_channels) {
+  int rank = in_shape_hwc.size();
+  if (rank < 3 || rank > 5 || align_channels <= 0 ||
+      static_cast<std::int64_t>(input.size()) !=
+          blocked_numel(in_shape_hwc, align_channels)) {
+    std::cerr << "输入数据大小与分块HWC形状不匹配：" << input.size()
+              << std::endl;
+    return -1;
+  }
+  std::int64_t A = align_channels;
+  view.base = input.data();
+  view.shape = in_shape_hwc;
+  view.align_channels = align_channels;
+  view.offsets.assign(rank, {});
+  // 空间维的偏移以像素为单位乘以align_channels，C维偏移包含块号和块内位置
+  std::int64_t pitch = 1;
+  for (int d = rank - 2; d >= 0; --d) {
+    view.offsets[d].resize(in_shape_hwc[d]);
+    for (int i = 0; i < in_shape_hwc[d]; ++i) {
+      view.offsets[d][i] = i * pitch * A;
+    }
+    pitch *= in_shape_hwc[d];
+  }
+  std::vector<std::int64_t> &channel = view.offsets[rank - 1];
+  channel.resize(in_shape_hwc[rank - 1]);
+  for (std::int64_t c = 0; c < in_shape_hwc[rank - 1]; ++c) {
+    channel[c] = c / A * pitch * A + c % A;
+  }
+  return 0;
+}
+
+template <typename T>
+int gather_view(GatherView<T> &view, const std::vector<int> &indices,
+                int axis) {
+  int rank = view.shape.size();
+  if (axis < 0 || axis >= rank) {
+    std::cerr << "无效的axis：" << axis << std::endl;
+    return -1;
+  }
+  int d = view.align_channels > 0 ? chw_axis_to_hwc(axis, rank) : axis;
+  int dim = view.shape[d];
+  std::vector<std::int64_t> table(indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    int idx = indices[i] >= 0 ? indices[i] : indices[i] + dim;
+    if (idx < 0 || idx >= dim) {
+      std::cerr << "索引越界：" << indices[i] << std::endl;
+      return -1;
+    }
+    table[i] = view.offsets[d][idx];
+  }
+  view.offsets[d].swap(table);
+  view.shape[d] = indices.size();
+  return 0;
+}
+
+template <typename T>
+int gather_chw_view(GatherView<T> &view, const std::vector<T> &input,
+                    const std::vector<int> &in_shape,
+                    const std::vector<int> &indices, int axis) {
+  if (make_view_chw(view, input, in_shape) != 0) {
+    return -1;
+  }
+  return gather_view(view, indices, axis);
+}
+
+template <typename T>
+int gather_hwc_view(GatherView<T> &view, const std::vector<T> &input,
+                    const std::vector<int> &in_shape_hwc,
+                    const std::vector<int> &indices, int axis_chw,
+                    int align_channels) {
+  if (make_view_hwc(view, input, in_shape_hwc, align_channels) != 0) {
+    return -1;
+  }
+  return gather_view(view, indices, axis_chw);
+}
+
+namespace rvv {
+template <typename T>
+int read_view(std::vector<T> &output, const GatherView<T> &view,
+              const std::vector<int> &out_order, int block_axis,
+              int align_channels) {
+  return read_view_impl(output, view, out_order, block_axis, align_channels,
+                        RvvRunCopy());
+}
+
+template <typename T>
+int materialize(std::vector<T> &output, const GatherView<T> &view) {
+  int block_axis = view.align_channels > 0 ? view.shape.size() - 1 : -1;
+  return read_view(output, view, view_order(view), block_axis,
+                   view.align_channels);
+}
+} // namespace rvv
+
+namespace mem {
+template <typename T>
+int read_view(std::vector<T> &output, const GatherView<T> &view,
+              const std::vector<int> &out_order, int block_axis,
+              int align_channels) {
+  return read_view_impl(output, view, out_order, block_axis, align_channels,
+                        MemRunCopy());
+}
+
+template <typename T>
+int materialize(std::vector<T> &output, const GatherView<T> &view) {
+  int block_axis = view.align_channels > 0 ? view.shape.size() - 1 : -1;
+  return read_view(output, view, view_order(view), block_axis,
+                   view.align_channels);
+}
+} // namespace mem
+
+// 与gather_hwc相同的元素类型（视图只做同类型读出）
+#define GATHER_VIEW_INSTANTIATE(T)                                            \
+  template int make_view_chw<T>(GatherView<T> &, const std::vector<T> &,      \
+                                const std::vector<int> &);                    \
+  template int make_view_hwc<T>(GatherView<T> &, const std::vector<T> &,      \
+                                const std::vector<int> &, int);               \
+  template int gather_view<T>(GatherView<T> &, const std::vector<int> &, int); \
+  template int gather_chw_view<T>(GatherView<T> &, const std::vector<T> &,    \
+                                  const std::vector<int> &,                   \
+                                  const std::vector<int> &, int);             \
+  template int gather_hwc_view<T>(GatherView<T> &, const std::vector<T> &,    \
+                                  const std::vector<int> &,                   \
+                                  const std::vector<int> &, int, int);        \
+  template int rvv::read_view<T>(std::vector<T> &, const GatherView<T> &,     \
+                                 const std::vector<int> &, int, int);         \
+  template int rvv::materialize<T>(std::vector<T> &, const GatherView<T> &);  \
+  template int mem::read_view<T>(std::vector<T> &, const GatherView<T> &,     \
+                                 const std::vector<int> &, int, int);         \
+  template int mem::materialize<T>(std::vector<T> &, const GatherView<T> &);
+
+GATHER_VIEW_INSTANTIATE(float)
+GATHER_VIEW_INSTANTIATE(float16)
+GATHER_VIEW_INSTANTIATE(bfloat16)
+GATHER_VIEW_INSTANTIATE(std::int8_t)
+GATHER_VIEW_INSTANTIATE(std::uint8_t)
+
+#undef GATHER_VIEW_INSTANTIATE
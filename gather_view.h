@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "elem_type.h"
+
+// gather的惰性视图：不拷贝数据，只记录输入基址、视图形状和每一维的偏移表，
+// 元素(i_0, ..., i_{r-1})位于base[offsets[0][i_0] + ... + offsets[r-1][i_{r-1}]]。
+// CHW视图（align_channels为0）的形状与gather_chw的输出相同；分块HWC视图的形状
+// 为HWC顺序，C维偏移表已包含分块，读出时按分块HWC布局排列、补齐通道为0。
+// 视图不持有输入，使用期间输入必须保持有效且不被修改
+template <typename T>
+struct GatherView {
+  const T *base = nullptr;
+  std::vector<int> shape;
+  std::vector<std::vector<std::int64_t>> offsets;
+  int align_channels = 0;
+};
+
+// 整个输入张量的视图（不做gather），输入大小与形状不符时返回-1
+template <typename T>
+int make_view_chw(GatherView<T> &view, const std::vector<T> &input,
+                  const std::vector<int> &in_shape);
+
+template <typename T>
+int make_view_hwc(GatherView<T> &view, const std::vector<T> &input,
+                  const std::vector<int> &in_shape_hwc, int align_channels);
+
+// 在视图上再做一次gather（只改写该维的偏移表），
+// axis对CHW视图为维号，对分块HWC视图为CHW编号（与gather_hwc相同）
+template <typename T>
+int gather_view(GatherView<T> &view, const std::vector<int> &indices,
+                int axis);
+
+// gather_chw / gather_hwc（展平索引）的视图版本，不拷贝数据
+template <typename T>
+int gather_chw_view(GatherView<T> &view, const std::vector<T> &input,
+                    const std::vector<int> &in_shape,
+                    const std::vector<int> &indices, int axis);
+
+template <typename T>
+int gather_hwc_view(GatherView<T> &view, const std::vector<T> &input,
+                    const std::vector<int> &in_shape_hwc,
+                    const std::vector<int> &indices, int axis_chw,
+                    int align_channels);
+
+// 按读出顺序（CHW视图为行优先，分块HWC视图为分块布局）逐个访问元素，
+// 补齐通道给出T()，供文件输出等逐元素消费的场景使用
+template <typename T, typename Fn>
+void for_each_view_element(const GatherView<T> &view, Fn fn) {
+  int rank = view.shape.size();
+  for (int d = 0; d < rank; ++d) {
+    if (view.shape[d] == 0) {
+      return;
+    }
+  }
+  int A = view.align_channels;
+  int C = view.shape[rank - 1];
+  int blocks = A > 0 ? (C + A - 1) / A : 1;
+  // 分块时最内层为块内通道，其余维在块号之内按行优先遍历
+  int outer_rank = A > 0 ? rank - 1 : rank;
+  std::vector<int> idx(outer_rank, 0);
+  for (int b = 0; b < blocks; ++b) {
+    bool done = false;
+    while (!done) {
+      std::int64_t off = 0;
+      for (int d = 0; d < outer_rank; ++d) {
+        off += view.offsets[d][idx[d]];
+      }
+      if (A > 0) {
+        for (int lane = 0; lane < A; ++lane) {
+          int c = b * A + lane;
+          fn(c < C ? view.base[off + view.offsets[rank - 1][c]] : T());
+        }
+      } else {
+        fn(view.base[off]);
+      }
+      int d = outer_rank - 1;
+      for (; d >= 0 && ++idx[d] == view.shape[d]; --d) {
+        idx[d] = 0;
+      }
+      done = d < 0;
+    }
+  }
+}
+
+// 读出视图。out_order[k]为输出第k维对应的视图维；block_axis>=0时该视图维
+// 按align_channels分块：块号在最外层，块内通道在最内层，补齐通道为0。
+// materialize按视图自身的布局读出，等价于对应gather的输出
+namespace rvv {
+template <typename T>
+int read_view(std::vector<T> &output, const GatherView<T> &view,
+              const std::vector<int> &out_order, int block_axis,
+              int align_channels);
+
+template <typename T>
+int materialize(std::vector<T> &output, const GatherView<T> &view);
+}
+
+namespace mem {
+template <typename T>
+int read_view(std::vector<T> &output, const GatherView<T> &view,
+              const std::vector<int> &out_order, int block_axis,
+              int align_channels);
+
+template <typename T>
+int materialize(std::vector<T> &output, const GatherView<T> &view);
+}
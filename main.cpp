@@ -102,6 +102,117 @@ int main() {
   // "chw/200_32_2__1_200/output.txt", 0,
   // "chw/200_32_2__1_200/true_output.txt");
 
+  // std::cout << "\nlarge tensor (> 8 GiB):\n";
+  // TestGatherHWCLarge(false, {9, 64, 128, 256, 128}, {0, 8, 3}, 0, 64);
+  // TestGatherHWCLarge(true, {9, 64, 128, 256, 128}, {0, 8, 3}, 0, 64);
+  // TestGatherHWCLarge(true, {9, 64, 128, 256, 128}, {5, 127}, 1, 64);
+
+  // std::cout << "\ngather_nd vs chained gather_hwc:\n";
+  // TestGatherNDHWC(false, {128, 128, 128}, 256, 2, 64);
+  // TestGatherNDHWC(true, {128, 128, 128}, 256, 2, 64);
+  // TestGatherNDHWC(true, {1, 16, 6, 4, 96}, 32, 3, 16);
+
+  // std::cout << "\ngather_elements vs convert route:\n";
+  // TestGatherElementsHWC(false, {128, 128, 160}, 128, 1, 64);
+  // TestGatherElementsHWC(true, {128, 128, 160}, 128, 1, 64);
+  // TestGatherElementsHWC(true, {128, 128, 160}, 128, 2, 64);
+  // TestGatherElementsHWC(true, {4, 64, 64, 96}, 32, 1, 32);
+  // TestGatherElementsHWC(true, {1, 16, 6, 4, 96}, 8, 2, 16);
+
+  // std::cout << "\nin-place scatter:\n";
+  // TestScatterNDHWC(false, {64, 32, 16, 16, 64}, 4, 2, 64);
+  // TestScatterNDHWC(true, {64, 32, 16, 16, 64}, 4, 2, 64);
+  // TestScatterElementsHWC(true, {128, 128, 160}, 16, 0, 64);
+  // TestScatterElementsHWC(true, {4, 64, 64, 96}, 32, 2, 32);
+
+  // std::cout << "\nscatter-add (gather backward):\n";
+  // TestScatterAdd(false, false, {256, 64, 64}, 1024, 0, 0, 4);
+  // TestScatterAdd(true, false, {256, 64, 64}, 1024, 0, 0, 4);
+  // TestScatterAdd(true, true, {64, 64, 256}, 1024, 0, 64, 4);
+  // TestScatterAdd(true, true, {8, 64, 64, 128}, 256, 2, 64, 4);
+
+  // std::cout << "\nfp16/bf16 storage:\n";
+  // TestGatherHWCHalf(true, {64, 64, 256}, {0, 5, 9, 17, 33, 63}, 1, 64);
+  // TestGatherHWCHalf(true, {8, 64, 64, 128}, {0, 32, 64, 127}, 1, 64);
+
+  // std::cout << "\nint8 per-channel quantized:\n";
+  // TestGatherHWCQuant(true, {64, 64, 256}, {0, 5, 9, 17, 33, 63}, 1, 64);
+  // TestGatherHWCQuant(true, {64, 64, 256}, {0, 3, 128, 255}, 0, 64);
+
+  // std::cout << "\nprepared gather plan:\n";
+  // TestGatherHWCPlan(true, {8, 8, 64}, {0, 2, 4, 6}, 1, 64, 10000);
+  // TestGatherHWCPlan(true, {8, 8, 64}, {1, 2, 3, 4, 5, 40}, 0, 16, 10000);
+
+  // std::cout << "\ngather chain (crop then subsample):\n";
+  // TestGatherHWCChain(true, {64, 64, 128}, {1, 2, 1},
+  //                    {{8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+  //                     {0, 2, 4, 6, 8, 10, 12, 14},
+  //                     {0, 2, 4, 6, 8, 10}},
+  //                    64);
+
+  // std::cout << "\nlazy gather view:\n";
+  // TestGatherHWCView(true, {64, 64, 256}, {0, 5, 9, 17, 33, 63}, 1, 64);
+  // TestGatherHWCView(true, {8, 64, 64, 128}, {0, 32, 64, 127}, 1, 64);
+
+  // std::cout << "\nsoftware prefetch (random indices):\n";
+  // TestGatherHWCPrefetch({16, 16, 32, 32, 128}, 64, 0, 64);
+  // TestGatherHWCPrefetch({4, 64, 32, 32, 128}, 256, 2, 64);
+  // TestGatherHWCPrefetch({4, 16, 128, 32, 128}, 512, 3, 64);
+
+  // std::cout << "\nW-axis small copies:\n";
+  // TestGatherHWCWidth({1, 16, 6, 4, 96}, {3, 0, 2}, 16, 1000);
+  // TestGatherHWCWidth({1, 16, 6, 4, 96}, {0, 1, 2, 3}, 64, 1000);
+  // TestGatherHWCWidth({8, 32, 32, 64}, {31, 7, 15, 0, 23}, 8, 100);
+
+  // std::cout << "\ngather_chw last axis (block_size 1):\n";
+  // TestGatherCHWSmallBlock(true, {128, 128, 64}, 32);
+  // TestGatherCHWSmallBlock(false, {128, 128, 64}, 32);
+
+  // std::cout << "\nLMUL autotune:\n";
+  // TestRvvVlen();
+  // TestRvvTune({8, 64, 64, 16}, {0, 5, 9, 17, 33, 63}, 2, 16, 20);
+  // TestRvvTune({8, 64, 64, 128}, {0, 32, 64, 127}, 1, 64, 20);
+
+  // std::cout << "\ntune cache:\n";
+  // gather_tune_load(gather_tune_default_path());
+  // TestGatherTune("gather_tune.txt", {8, 64, 64, 16}, {0, 5, 9, 17, 33, 63}, 2,
+  //                16, 20, 20);
+
+  // std::cout << "\nworkspace:\n";
+  // TestWorkspace(96, 128, 128, {0, 5, 17, 63}, 1, 16, 20);
+  // TestWorkspace(160, 64, 64, {3, 1, 100, 64}, 0, 64, 20);
+
+  // std::cout << "\naligned buffer:\n";
+  // TestAlignedBuffer({2, 4, 64, 64, 256}, {0, 17, 64, 129, 255}, 1, 64, 10);
+  // TestAlignedBuffer({2, 4, 64, 64, 256}, {0, 3, 5}, 3, 64, 10);
+
+  // std::cout << "\ntensor:\n";
+  // TestTensor({96, 128, 128}, {0, 5, 17, 63}, 1, 16, 10);
+  // TestTensor({2, 160, 64, 64}, {3, 1, 100, 64}, 1, 64, 10);
+  // TestTensor({2, 64, 4, 32, 32}, {0, 2, 3}, 2, 32, 10);
+
+  // std::cout << "\nbatch:\n";
+  // TestGatherBatch(48, 64, 40, 40, {0, 5, 17, 33}, 0, 16, 1, 20);
+  // TestGatherBatch(48, 64, 40, 40, {0, 5, 17, 33}, 0, 16, 0, 20);
+  // TestGatherBatch(48, 255, 20, 20, {0, 3, 7}, 1, 64, 0, 20);
+
+  // std::cout << "\nexecutor:\n";
+  // TestGatherExecutor(4, 8, 64, 160, 160, {0, 5, 17, 33}, 0, 16, 0, 8);
+  // TestGatherExecutor(4, 8, 64, 160, 160, {0, 3, 7, 9}, 1, 16, 0, 2);
+
+  // std::cout << "\nnuma:\n";
+  // TestGatherNuma({64, 160, 160}, {0, 5, 17, 33}, 0, 16, 2, 10);
+  // TestGatherNuma({2, 64, 80, 80}, {0, 3, 7, 9}, 1, 16, 2, 10);
+
+  // std::cout << "\nring:\n";
+  // TestGatherRing(1, 64, 40, 40, 8, {-1, -3, -5, 0}, 16, 32);
+  // TestGatherRing(1, 32, 80, 80, 16, {-1, -2, -4, -8, 0}, 16, 64);
+
+  // std::cout << "\nincremental:\n";
+  // TestGatherIncremental(64, 160, 160, {0, 5, 17, 33}, 1, 1, 16, 10);
+  // TestGatherIncremental(128, 80, 80, {0, 5, 17, 33}, 1, 0, 16, 10);
+  // TestGatherIncremental(128, 80, 80, {3, 7, 64, 100}, 0, 1, 16, 10);
+
   // std::cout << "Test time:\n";
   // TestGatherTime(0);
   // TestGatherTime(1);
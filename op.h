@@ -10,14 +10,89 @@
 #include <stdexcept>
 #include <vector>
 
+#include "aligned_buffer.h"
+#include "gather_view.h"
+
 using namespace std;
 
-float* readFile(const char* path, int len);
-int* readFileINT(const char* path, int len);
+float* readFile(const char* path, size_t len);
+int readFileAligned(const char* path, size_t len,
+                    AlignedVector<float>& output);
+int* readFileINT(const char* path, size_t len);
 void outputFile_line(const char* path, const vector<float>& output);
+void outputFile_line(const char* path, const GatherView<float>& view);
 void outputFile_line_int(const char* path, const vector<int>& output);
 void outputFile2d_line(const char* path, const vector<vector<int>>& output);
+// gettimeofday两次读数之间的毫秒数，供各Test函数计时
+float elapsed_ms(const struct timeval& start, const struct timeval& end);
 void TestGatherCHW(bool is_rvv, std::vector<int> in_shape,
                    std::vector<int> indices_shape, const char* input_path,
                    const char* indices_path, const char* output_path, int axis);
+float TestGatherHWC(bool is_rvv, std::vector<int> in_shape,
+                    std::vector<int> indices_shape, const char* input_path,
+                    const char* indices_path, const char* output_path,
+                    int axis, int align_channels);
+float TestGatherHWCLarge(bool is_rvv, std::vector<int> in_shape,
+                         std::vector<int> indices, int axis,
+                         int align_channels);
+float TestGatherNDHWC(bool is_rvv, std::vector<int> in_shape, int num_tuples,
+                      int k, int align_channels);
+float TestGatherElementsHWC(bool is_rvv, std::vector<int> in_shape,
+                            int num_indices, int axis, int align_channels);
+float TestScatterNDHWC(bool is_rvv, std::vector<int> data_shape,
+                       int num_tuples, int k, int align_channels);
+float TestScatterElementsHWC(bool is_rvv, std::vector<int> data_shape,
+                             int num_indices, int axis, int align_channels);
+float TestScatterAdd(bool is_rvv, bool is_hwc, std::vector<int> in_shape,
+                     int num_indices, int axis, int align_channels,
+                     int max_threads);
+float TestGatherHWCHalf(bool is_rvv, std::vector<int> in_shape,
+                        std::vector<int> indices, int axis,
+                        int align_channels);
+float TestGatherHWCQuant(bool is_rvv, std::vector<int> in_shape,
+                         std::vector<int> indices, int axis,
+                         int align_channels);
+float TestGatherHWCPlan(bool is_rvv, std::vector<int> in_shape,
+                        std::vector<int> indices, int axis,
+                        int align_channels, int frames);
+float TestGatherHWCChain(bool is_rvv, std::vector<int> in_shape,
+                         std::vector<int> axes,
+                         std::vector<std::vector<int>> indices,
+                         int align_channels);
+float TestGatherHWCView(bool is_rvv, std::vector<int> in_shape,
+                        std::vector<int> indices, int axis,
+                        int align_channels);
+float TestGatherHWCPrefetch(std::vector<int> in_shape, int num_indices,
+                            int axis, int align_channels);
+float TestGatherHWCWidth(std::vector<int> in_shape, std::vector<int> indices,
+                         int align_channels, int repeat);
+float TestGatherCHWSmallBlock(bool is_rvv, std::vector<int> in_shape,
+                              int num_indices);
+float TestRvvTune(std::vector<int> in_shape, std::vector<int> indices,
+                  int axis, int align_channels, int repeat);
+void TestRvvVlen();
+float TestGatherTune(const char *path, std::vector<int> in_shape,
+                     std::vector<int> indices, int axis, int align_channels,
+                     int tune_repeat, int repeat);
+float TestWorkspace(int c, int h, int w, std::vector<int> indices, int axis,
+                    int align_channels, int frames);
+float TestAlignedBuffer(std::vector<int> in_shape_hwc, std::vector<int> indices,
+                        int axis, int align_channels, int repeat);
+float TestTensor(std::vector<int> in_shape, std::vector<int> indices, int axis,
+                 int align_channels, int repeat);
+float TestGatherBatch(int num_jobs, int c, int h, int w,
+                      std::vector<int> indices, int axis, int align_channels,
+                      int num_threads, int repeat);
+float TestGatherExecutor(int num_clients, int requests, int c, int h, int w,
+                         std::vector<int> indices, int axis,
+                         int align_channels, int num_threads,
+                         int max_pending);
+float TestGatherNuma(std::vector<int> in_shape, std::vector<int> indices,
+                     int axis, int align_channels, int threads_per_node,
+                     int repeat);
+float TestGatherRing(int n, int c, int h, int w, int capacity,
+                     std::vector<int> indices, int align_channels, int steps);
+float TestGatherIncremental(int c, int h, int w, std::vector<int> indices,
+                            int axis, int dirty_axis, int align_channels,
+                            int frames);
 #endif
\ No newline at end of file
@@ -1,19 +1,24 @@
 #include "op.h"
 
-float* readFile(const char* path, int len) {
+float* readFile(const char* path, size_t len) {
   FILE* fp = fopen(path, "r");
   if (!fp) {
     printf("无法打开文件: %s\n", path);
     return nullptr;
   }
 
-  float* dataBuf = (float*)malloc(len * sizeof(float));
+  // 按kTensorAlignment对齐，仍可用free释放
+  float* dataBuf = nullptr;
+  if (posix_memalign((void**)&dataBuf, kTensorAlignment,
+                     (len > 0 ? len : 1) * sizeof(float)) != 0) {
+    dataBuf = nullptr;
+  }
   if (!dataBuf) {
     fclose(fp);  // 内存分配失败时关闭文件
     return nullptr;
   }
 
-  for (int i = 0; i < len; i++) {
+  for (size_t i = 0; i < len; i++) {
     if (fscanf(fp, "%f", &dataBuf[i]) != 1) {
       free(dataBuf);
       fclose(fp);  // 读取失败时关闭文件
@@ -25,17 +30,40 @@ float* readFile(const char* path, int len) {
   return dataBuf;
 }
 
-int* readFileINT(const char* path, int len) {
+// 读入len个float到对齐缓冲区（大张量可落在巨页上），失败时返回-1
+int readFileAligned(const char* path, size_t len,
+                    AlignedVector<float>& output) {
   FILE* fp = fopen(path, "r");
-  if (fp == NULL)
-    printf("cannot open file\n");
-  else {
-    int* dataBuf = (int*)malloc(len * sizeof(int));
-    for (int i = 0; i < len; i++) {
-      fscanf(fp, "%d", dataBuf + i);
+  if (!fp) {
+    printf("无法打开文件: %s\n", path);
+    return -1;
+  }
+
+  output.resize(len);
+  for (size_t i = 0; i < len; i++) {
+    if (fscanf(fp, "%f", &output[i]) != 1) {
+      output.clear();
+      fclose(fp);
+      return -1;
     }
-    return dataBuf;
   }
+
+  fclose(fp);
+  return 0;
+}
+
+int* readFileINT(const char* path, size_t len) {
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) {
+    printf("cannot open file\n");
+    return nullptr;
+  }
+  int* dataBuf = (int*)malloc(len * sizeof(int));
+  for (size_t i = 0; i < len; i++) {
+    fscanf(fp, "%d", dataBuf + i);
+  }
+  fclose(fp);
+  return dataBuf;
 }
 
 void outputFile_line(const char* path, const vector<float>& output) {
@@ -53,6 +81,19 @@ void outputFile_line(const char* path, const vector<float>& output) {
   // printf("Data written to %s\n", path);
 }
 
+// 直接输出gather视图，元素顺序与materialize的结果相同，不生成中间张量
+void outputFile_line(const char* path, const GatherView<float>& view) {
+  FILE* fp = fopen(path, "w+");
+  if (fp == NULL) {
+    printf("cannot open file for writing\n");
+    return;
+  }
+
+  for_each_view_element(view, [fp](float v) { fprintf(fp, "%.6f\n", v); });
+
+  fclose(fp);
+}
+
 void outputFile_line_int(const char* path, const vector<int>& output) {
   FILE* fp = fopen(path, "w+");
   if (fp == NULL) {
@@ -83,4 +124,10 @@ void outputFile2d_line(const char* path,
 
   fclose(fp);
   printf("Data written to %s\n", path);
-}
\ No newline at end of file
+}
+
+float elapsed_ms(const struct timeval& start, const struct timeval& end) {
+  return ((end.tv_sec - start.tv_sec) * 1000000.0 +
+          (end.tv_usec - start.tv_usec)) /
+         1000.0;
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <riscv_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "elem_type.h"
+
+// RVV搬运原语，按(输出类型, 输入类型)特化：
+// setvl(n)按该组合的元素宽度设置向量长度，copy/copy_strided搬运vl个元素，
+// stride以元素为单位（分块布局中通常是align_channels）。
+// 同类型时只是vle/vse（16位、8位类型按位搬运），
+// float32与float16之间在有Zvfh/Zvfhmin时用vfwcvt/vfncvt，否则（-march=rv64gcv）
+// 与bfloat16一样用整数移位转换，结果与half_bits_to_float/float_to_half_bits相同，
+// 与bfloat16之间用移位（截取/补齐高16位，收窄时就近舍入到偶数）
+template <typename out_t, typename in_t>
+struct RvvCopy;
+
+template <>
+struct RvvCopy<float, float> {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  static void copy(float *dst, const float *src, std::size_t vl) {
+    vse32_v_f32m8(dst, vle32_v_f32m8(src, vl), vl);
+  }
+  static void copy_strided(float *dst, const float *src, std::ptrdiff_t stride,
+                           std::size_t vl) {
+    std::ptrdiff_t bytes = stride * sizeof(float);
+    vsse32_v_f32m8(dst, bytes, vlse32_v_f32m8(src, bytes, vl), vl);
+  }
+};
+
+// float16和bfloat16之间同类型搬运只看位模式
+template <typename half_t>
+struct RvvCopy16 {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e16m8(n); }
+  static void copy(half_t *dst, const half_t *src, std::size_t vl) {
+    auto v = vle16_v_u16m8(reinterpret_cast<const std::uint16_t *>(src), vl);
+    vse16_v_u16m8(reinterpret_cast<std::uint16_t *>(dst), v, vl);
+  }
+  static void copy_strided(half_t *dst, const half_t *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    std::ptrdiff_t bytes = stride * sizeof(half_t);
+    auto v = vlse16_v_u16m8(reinterpret_cast<const std::uint16_t *>(src),
+                            bytes, vl);
+    vsse16_v_u16m8(reinterpret_cast<std::uint16_t *>(dst), bytes, v, vl);
+  }
+};
+
+template <>
+struct RvvCopy<float16, float16> : RvvCopy16<float16> {};
+
+template <>
+struct RvvCopy<bfloat16, bfloat16> : RvvCopy16<bfloat16> {};
+
+// int8_t和uint8_t（量化数据）同样只看位模式
+template <typename byte_t>
+struct RvvCopy8 {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e8m8(n); }
+  static void copy(byte_t *dst, const byte_t *src, std::size_t vl) {
+    auto v = vle8_v_u8m8(reinterpret_cast<const std::uint8_t *>(src), vl);
+    vse8_v_u8m8(reinterpret_cast<std::uint8_t *>(dst), v, vl);
+  }
+  static void copy_strided(byte_t *dst, const byte_t *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    auto v = vlse8_v_u8m8(reinterpret_cast<const std::uint8_t *>(src), stride,
+                          vl);
+    vsse8_v_u8m8(reinterpret_cast<std::uint8_t *>(dst), stride, v, vl);
+  }
+};
+
+template <>
+struct RvvCopy<std::int8_t, std::int8_t> : RvvCopy8<std::int8_t> {};
+
+template <>
+struct RvvCopy<std::uint8_t, std::uint8_t> : RvvCopy8<std::uint8_t> {};
+
+#if defined(__riscv_zvfh) || defined(__riscv_zvfhmin)
+template <>
+struct RvvCopy<float, float16> {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  static vfloat32m8_t widen(vfloat16m4_t v, std::size_t vl) {
+    return vfwcvt_f_f_v_f32m8(v, vl);
+  }
+  static void copy(float *dst, const float16 *src, std::size_t vl) {
+    auto v = vle16_v_f16m4(reinterpret_cast<const _Float16 *>(src), vl);
+    vse32_v_f32m8(dst, widen(v, vl), vl);
+  }
+  static void copy_strided(float *dst, const float16 *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    auto v = vlse16_v_f16m4(reinterpret_cast<const _Float16 *>(src),
+                            stride * sizeof(float16), vl);
+    vsse32_v_f32m8(dst, stride * sizeof(float), widen(v, vl), vl);
+  }
+};
+
+template <>
+struct RvvCopy<float16, float> {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  static void copy(float16 *dst, const float *src, std::size_t vl) {
+    auto v = vfncvt_f_f_w_f16m4(vle32_v_f32m8(src, vl), vl);
+    vse16_v_f16m4(reinterpret_cast<_Float16 *>(dst), v, vl);
+  }
+  static void copy_strided(float16 *dst, const float *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    auto v = vfncvt_f_f_w_f16m4(
+        vlse32_v_f32m8(src, stride * sizeof(float), vl), vl);
+    vsse16_v_f16m4(reinterpret_cast<_Float16 *>(dst),
+                   stride * sizeof(float16), v, vl);
+  }
+};
+#else
+template <>
+struct RvvCopy<float, float16> {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  // 与half_bits_to_float相同
+  static vfloat32m8_t widen(vuint16m4_t h, std::size_t vl) {
+    auto x = vzext_vf2_u32m8(h, vl);
+    auto sign = vsll_vx_u32m8(vand_vx_u32m8(x, 0x8000, vl), 16, vl);
+    auto exp = vand_vx_u32m8(vsrl_vx_u32m8(x, 10, vl), 0x1f, vl);
+    auto mant = vand_vx_u32m8(x, 0x3ff, vl);
+    // 规格化数：指数偏置从15改为127
+    auto u = vadd_vx_u32m8(vsll_vx_u32m8(vand_vx_u32m8(x, 0x7fff, vl), 13, vl),
+                           112 << 23, vl);
+    auto special = vor_vx_u32m8(vsll_vx_u32m8(mant, 13, vl), 0x7f800000, vl);
+    u = vmerge_vvm_u32m8(vmseq_vx_u32m8_b4(exp, 0x1f, vl), u, special, vl);
+    // 非规格化数（含0）：mant * 2^-24
+    auto sub = vreinterpret_v_f32m8_u32m8(vfmul_vf_f32m8(
+        vfcvt_f_xu_v_f32m8(mant, vl), 1.0f / 16777216.0f, vl));
+    u = vmerge_vvm_u32m8(vmseq_vx_u32m8_b4(exp, 0, vl), u, sub, vl);
+    return vreinterpret_v_u32m8_f32m8(vor_vv_u32m8(u, sign, vl));
+  }
+  static void copy(float *dst, const float16 *src, std::size_t vl) {
+    auto v = vle16_v_u16m4(reinterpret_cast<const std::uint16_t *>(src), vl);
+    vse32_v_f32m8(dst, widen(v, vl), vl);
+  }
+  static void copy_strided(float *dst, const float16 *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    auto v = vlse16_v_u16m4(reinterpret_cast<const std::uint16_t *>(src),
+                            stride * sizeof(float16), vl);
+    vsse32_v_f32m8(dst, stride * sizeof(float), widen(v, vl), vl);
+  }
+};
+
+template <>
+struct RvvCopy<float16, float> {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  // 与float_to_half_bits相同：先按规格化数舍入，再替换非规格化数、溢出和NaN
+  static vuint16m4_t narrow(vfloat32m8_t v, std::size_t vl) {
+    auto x = vreinterpret_v_f32m8_u32m8(v);
+    auto sign = vand_vx_u32m8(vsrl_vx_u32m8(x, 16, vl), 0x8000, vl);
+    auto abs = vand_vx_u32m8(x, 0x7fffffff, vl);
+    auto lsb = vand_vx_u32m8(vsrl_vx_u32m8(abs, 13, vl), 1, vl);
+    auto u = vsrl_vx_u32m8(
+        vadd_vv_u32m8(abs, vadd_vx_u32m8(lsb, 0xc8000fff, vl), vl), 13, vl);
+    // 非规格化数：加0.5f后尾数低位正好是以2^-24为单位的舍入结果
+    auto half = vfadd_vf_f32m8(vreinterpret_v_u32m8_f32m8(abs), 0.5f, vl);
+    auto sub = vsub_vx_u32m8(vreinterpret_v_f32m8_u32m8(half), 0x3f000000, vl);
+    u = vmerge_vvm_u32m8(vmsltu_vx_u32m8_b4(abs, 0x38800000, vl), u, sub, vl);
+    u = vmerge_vxm_u32m8(vmsgeu_vx_u32m8_b4(abs, 0x477ff000, vl), u, 0x7c00,
+                         vl);
+    u = vmerge_vxm_u32m8(vmsgtu_vx_u32m8_b4(abs, 0x7f800000, vl), u, 0x7e00,
+                         vl);
+    return vnsrl_wx_u16m4(vor_vv_u32m8(u, sign, vl), 0, vl);
+  }
+  static void copy(float16 *dst, const float *src, std::size_t vl) {
+    auto h = narrow(vle32_v_f32m8(src, vl), vl);
+    vse16_v_u16m4(reinterpret_cast<std::uint16_t *>(dst), h, vl);
+  }
+  static void copy_strided(float16 *dst, const float *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    auto h = narrow(vlse32_v_f32m8(src, stride * sizeof(float), vl), vl);
+    vsse16_v_u16m4(reinterpret_cast<std::uint16_t *>(dst),
+                   stride * sizeof(float16), h, vl);
+  }
+};
+#endif
+
+template <>
+struct RvvCopy<float, bfloat16> {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  static vfloat32m8_t widen(vuint16m4_t v, std::size_t vl) {
+    auto u = vsll_vx_u32m8(vzext_vf2_u32m8(v, vl), 16, vl);
+    return vreinterpret_v_u32m8_f32m8(u);
+  }
+  static void copy(float *dst, const bfloat16 *src, std::size_t vl) {
+    auto v = vle16_v_u16m4(reinterpret_cast<const std::uint16_t *>(src), vl);
+    vse32_v_f32m8(dst, widen(v, vl), vl);
+  }
+  static void copy_strided(float *dst, const bfloat16 *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    auto v = vlse16_v_u16m4(reinterpret_cast<const std::uint16_t *>(src),
+                            stride * sizeof(bfloat16), vl);
+    vsse32_v_f32m8(dst, stride * sizeof(float), widen(v, vl), vl);
+  }
+};
+
+template <>
+struct RvvCopy<bfloat16, float> {
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  // 与float_to_bfloat16_bits相同：加0x7fff和保留位的最低位后取高16位，NaN另行处理
+  static vuint16m4_t narrow(vfloat32m8_t v, std::size_t vl) {
+    auto x = vreinterpret_v_f32m8_u32m8(v);
+    auto lsb = vand_vx_u32m8(vsrl_vx_u32m8(x, 16, vl), 1, vl);
+    auto u = vadd_vv_u32m8(x, vadd_vx_u32m8(lsb, 0x7fff, vl), vl);
+    auto h = vnsrl_wx_u16m4(u, 16, vl);
+    auto quiet = vor_vx_u16m4(vnsrl_wx_u16m4(x, 16, vl), 0x40, vl);
+    return vmerge_vvm_u16m4(vmfne_vv_f32m8_b4(v, v, vl), h, quiet, vl);
+  }
+  static void copy(bfloat16 *dst, const float *src, std::size_t vl) {
+    auto h = narrow(vle32_v_f32m8(src, vl), vl);
+    vse16_v_u16m4(reinterpret_cast<std::uint16_t *>(dst), h, vl);
+  }
+  static void copy_strided(bfloat16 *dst, const float *src,
+                           std::ptrdiff_t stride, std::size_t vl) {
+    auto h = narrow(vlse32_v_f32m8(src, stride * sizeof(float), vl), vl);
+    vsse16_v_u16m4(reinterpret_cast<std::uint16_t *>(dst),
+                   stride * sizeof(bfloat16), h, vl);
+  }
+};
+
+// 按字节偏移表做索引加载（vluxei32）再连续写出，一条指令搬运多个不连续的小段。
+// 只支持同类型（按位搬运）：偏移为32位，数据为32/16/8位时LMUL分别为8/4/2，
+// vl按e32m8设置；类型转换组合的supported为false，调用方应走RvvCopy
+template <std::size_t bytes>
+struct RvvGatherBits;
+
+template <>
+struct RvvGatherBits<4> {
+  static void gather(void *dst, const void *src, const std::uint32_t *offsets,
+                     std::size_t vl) {
+    auto off = vle32_v_u32m8(offsets, vl);
+    auto v = vluxei32_v_u32m8(static_cast<const std::uint32_t *>(src), off, vl);
+    vse32_v_u32m8(static_cast<std::uint32_t *>(dst), v, vl);
+  }
+};
+
+template <>
+struct RvvGatherBits<2> {
+  static void gather(void *dst, const void *src, const std::uint32_t *offsets,
+                     std::size_t vl) {
+    auto off = vle32_v_u32m8(offsets, vl);
+    auto v = vluxei32_v_u16m4(static_cast<const std::uint16_t *>(src), off, vl);
+    vse16_v_u16m4(static_cast<std::uint16_t *>(dst), v, vl);
+  }
+};
+
+template <>
+struct RvvGatherBits<1> {
+  static void gather(void *dst, const void *src, const std::uint32_t *offsets,
+                     std::size_t vl) {
+    auto off = vle32_v_u32m8(offsets, vl);
+    auto v = vluxei32_v_u8m2(static_cast<const std::uint8_t *>(src), off, vl);
+    vse8_v_u8m2(static_cast<std::uint8_t *>(dst), v, vl);
+  }
+};
+
+template <typename out_t, typename in_t>
+struct RvvGather {
+  static const bool supported = false;
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  static void gather(out_t *, const in_t *, const std::uint32_t *,
+                     std::size_t) {}
+};
+
+template <typename T>
+struct RvvGather<T, T> {
+  static const bool supported = true;
+  static std::size_t setvl(std::size_t n) { return vsetvl_e32m8(n); }
+  static void gather(T *dst, const T *src, const std::uint32_t *offsets,
+                     std::size_t vl) {
+    RvvGatherBits<sizeof(T)>::gather(dst, src, offsets, vl);
+  }
+};
+
+// 按位搬运的LMUL可选版本（bytes为元素字节数，lmul为1/2/4/8），
+// stride_bytes以字节为单位。LMUL的选择见rvv_tune.h
+template <std::size_t bytes, int lmul>
+struct RvvCopyBits;
+
+#define RVV_COPY_BITS(bytes, sew, lmul)                                       \
+  template <>                                                                 \
+  struct RvvCopyBits<bytes, lmul> {                                           \
+    using bits_t = std::uint##sew##_t;                                        \
+    static std::size_t setvl(std::size_t n) {                                 \
+      return vsetvl_e##sew##m##lmul(n);                                       \
+    }                                                                         \
+    static void copy(void *dst, const void *src, std::size_t vl) {            \
+      auto v = vle##sew##_v_u##sew##m##lmul(static_cast<const bits_t *>(src), \
+                                            vl);                              \
+      vse##sew##_v_u##sew##m##lmul(static_cast<bits_t *>(dst), v, vl);        \
+    }                                                                         \
+    static void copy_strided(void *dst, const void *src,                      \
+                             std::ptrdiff_t stride_bytes, std::size_t vl) {   \
+      auto v = vlse##sew##_v_u##sew##m##lmul(                                 \
+          static_cast<const bits_t *>(src), stride_bytes, vl);                \
+      vsse##sew##_v_u##sew##m##lmul(static_cast<bits_t *>(dst), stride_bytes, \
+                                    v, vl);                                   \
+    }                                                                         \
+  };
+
+RVV_COPY_BITS(4, 32, 1)
+RVV_COPY_BITS(4, 32, 2)
+RVV_COPY_BITS(4, 32, 4)
+RVV_COPY_BITS(4, 32, 8)
+RVV_COPY_BITS(2, 16, 1)
+RVV_COPY_BITS(2, 16, 2)
+RVV_COPY_BITS(2, 16, 4)
+RVV_COPY_BITS(2, 16, 8)
+RVV_COPY_BITS(1, 8, 1)
+RVV_COPY_BITS(1, 8, 2)
+RVV_COPY_BITS(1, 8, 4)
+RVV_COPY_BITS(1, 8, 8)
+#undef RVV_COPY_BITS
+
+// 接口与RvvCopy相同、LMUL由模板参数给出的搬运原语。同类型组合按位搬运，
+// lmul=8时与RvvCopy等价；类型转换组合的寄存器分组由转换指令决定，沿用RvvCopy
+template <typename out_t, typename in_t, int lmul>
+struct RvvCopyLmul : RvvCopy<out_t, in_t> {};
+
+template <typename T, int lmul>
+struct RvvCopyLmul<T, T, lmul> {
+  using Bits = RvvCopyBits<sizeof(T), lmul>;
+  static std::size_t setvl(std::size_t n) { return Bits::setvl(n); }
+  static void copy(T *dst, const T *src, std::size_t vl) {
+    Bits::copy(dst, src, vl);
+  }
+  static void copy_strided(T *dst, const T *src, std::ptrdiff_t stride,
+                           std::size_t vl) {
+    Bits::copy_strided(dst, src, stride * sizeof(T), vl);
+  }
+};
@@ -0,0 +1,164 @@
+#include "rvv_tune.h"
+
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+constexpr int kLmuls[] = {1, 2, 4, 8};
+// 各长度档的上限，也是测量时的单次搬运字节数
+constexpr std::size_t kClassBytes[kRvvSizeClasses] = {64, 256, 1024, 4096,
+                                                      16384};
+
+struct LmulTable {
+  int lmul[kRvvCopyKinds][kRvvSizeClasses];
+};
+
+LmulTable default_table(std::size_t vlenb) {
+  LmulTable table;
+  for (int kind = 0; kind < kRvvCopyKinds; ++kind) {
+    for (int c = 0; c < kRvvSizeClasses; ++c) {
+      table.lmul[kind][c] =
+          rvv_default_lmul(static_cast<RvvCopyKind>(kind), c, vlenb);
+    }
+  }
+  return table;
+}
+
+// 首次使用时按运行时的VLEN初始化（局部静态变量的初始化是线程安全的）
+LmulTable &lmul_table() {
+  static LmulTable table = default_table(rvv_vlenb());
+  return table;
+}
+// 测量缓冲区：256KB的32位元素，跨步搬运的步长为16个元素（align_channels=16）
+constexpr std::size_t kBenchElems = 64 * 1024;
+constexpr std::ptrdiff_t kBenchStride = 16;
+
+// 在缓冲区内做一轮长度为elems的搬运（连续：依次搬运不重叠的段；
+// 跨步：每个块内通道各搬运一次），重复repeat轮，返回耗时（微秒）
+template <int lmul>
+double time_copy(RvvCopyKind kind, std::size_t elems,
+                 std::vector<std::uint32_t> &dst,
+                 const std::vector<std::uint32_t> &src, int repeat) {
+  using Copy = RvvCopyBits<4, lmul>;
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    std::size_t runs = kind == kRvvContiguous ? kBenchElems / elems
+                                              : static_cast<std::size_t>(
+                                                    kBenchStride);
+    for (std::size_t k = 0; k < runs; ++k) {
+      std::size_t base = kind == kRvvContiguous ? k * elems : k;
+      const std::uint32_t *s = src.data() + base;
+      std::uint32_t *d = dst.data() + base;
+      std::size_t n = elems;
+      while (n > 0) {
+        std::size_t vl = Copy::setvl(n);
+        if (kind == kRvvContiguous) {
+          Copy::copy(d, s, vl);
+          s += vl;
+          d += vl;
+        } else {
+          Copy::copy_strided(d, s, kBenchStride * sizeof(std::uint32_t), vl);
+          s += vl * kBenchStride;
+          d += vl * kBenchStride;
+        }
+        n -= vl;
+      }
+    }
+  }
+  gettimeofday(&end, NULL);
+  return (end.tv_sec - start.tv_sec) * 1000000.0 +
+         (end.tv_usec - start.tv_usec);
+}
+
+double time_copy_lmul(int lmul, RvvCopyKind kind, std::size_t elems,
+                      std::vector<std::uint32_t> &dst,
+                      const std::vector<std::uint32_t> &src, int repeat) {
+  switch (lmul) {
+  case 1:
+    return time_copy<1>(kind, elems, dst, src, repeat);
+  case 2:
+    return time_copy<2>(kind, elems, dst, src, repeat);
+  case 4:
+    return time_copy<4>(kind, elems, dst, src, repeat);
+  default:
+    return time_copy<8>(kind, elems, dst, src, repeat);
+  }
+}
+} // namespace
+
+int rvv_size_class(std::size_t bytes) {
+  int c = 0;
+  while (c < kRvvSizeClasses - 1 && bytes > kClassBytes[c]) {
+    ++c;
+  }
+  return c;
+}
+
+std::size_t rvv_vlenb() {
+  static const std::size_t vlenb = vsetvlmax_e8m1();
+  return vlenb;
+}
+
+int rvv_default_lmul(RvvCopyKind kind, int size_class, std::size_t vlenb) {
+  int max_lmul = kind == kRvvStrided && vlenb >= 32 ? 4 : 8;
+  int lmul = 1;
+  while (lmul < max_lmul && lmul * vlenb < kClassBytes[size_class]) {
+    lmul *= 2;
+  }
+  return lmul;
+}
+
+void rvv_reset_lmul() { lmul_table() = default_table(rvv_vlenb()); }
+
+std::size_t rvv_indexed_max_pixel() { return rvv_vlenb(); }
+
+int rvv_lmul(RvvCopyKind kind, std::size_t bytes) {
+  return lmul_table().lmul[kind][rvv_size_class(bytes)];
+}
+
+int rvv_set_lmul(RvvCopyKind kind, int size_class, int lmul) {
+  if (kind < 0 || kind >= kRvvCopyKinds || size_class < 0 ||
+      size_class >= kRvvSizeClasses ||
+      (lmul != 1 && lmul != 2 && lmul != 4 && lmul != 8)) {
+    return -1;
+  }
+  lmul_table().lmul[kind][size_class] = lmul;
+  return 0;
+}
+
+void rvv_autotune(int repeat, bool verbose) {
+  // 跨步搬运最多覆盖kBenchElems个元素：最长一档的元素数乘以步长
+  std::vector<std::uint32_t> src(kBenchElems + kBenchStride, 1);
+  std::vector<std::uint32_t> dst(kBenchElems + kBenchStride, 0);
+  for (int kind = 0; kind < kRvvCopyKinds; ++kind) {
+    for (int c = 0; c < kRvvSizeClasses; ++c) {
+      std::size_t elems = kClassBytes[c] / sizeof(std::uint32_t);
+      if (kind == kRvvStrided) {
+        elems = std::min<std::size_t>(elems, kBenchElems / kBenchStride);
+      }
+      RvvCopyKind k = static_cast<RvvCopyKind>(kind);
+      // 先以m8预热一轮，使缓冲区进入缓存
+      time_copy_lmul(8, k, elems, dst, src, 1);
+      double best_time = -1.0;
+      int best_lmul = 8;
+      for (int lmul : kLmuls) {
+        double t = time_copy_lmul(lmul, k, elems, dst, src, repeat);
+        if (verbose) {
+          printf("rvv tune %s,%6zu B,m%d %10.1f us\n",
+                 kind == kRvvContiguous ? "contiguous" : "strided",
+                 kClassBytes[c], lmul, t);
+        }
+        if (best_time < 0 || t < best_time) {
+          best_time = t;
+          best_lmul = lmul;
+        }
+      }
+      lmul_table().lmul[kind][c] = best_lmul;
+    }
+  }
+}
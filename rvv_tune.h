@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+
+#include "rvv_elem.h"
+
+// RVV搬运循环的LMUL选择。原来所有循环固定用m8：短搬运（如align_channels=16）
+// 时一次vsetvl只用到寄存器组的一小部分，跨步的vlse/vsse在m8下寄存器压力大、
+// 可能停顿。这里按(搬运类别, 单次搬运的字节数档)记录选用的LMUL，
+// 未调优时按运行时的VLEN取rvv_default_lmul的默认值，
+// rvv_autotune实测后改为最快的LMUL。
+// 表是进程内全局的，应在启动多线程gather之前调优或设置
+enum RvvCopyKind {
+  kRvvContiguous = 0, // vle/vse连续搬运
+  kRvvStrided = 1,    // vlse/vsse跨步搬运（C轴gather）
+  kRvvCopyKinds = 2
+};
+
+// 长度档：单次搬运<=64B、<=256B、<=1KB、<=4KB、更长
+constexpr int kRvvSizeClasses = 5;
+
+int rvv_size_class(std::size_t bytes);
+
+// 运行时的向量寄存器字节数（VLEN/8），首次调用时用vsetvlmax_e8m1读取。
+// 在qemu下可用-cpu rv64,v=true,vlen=256等设置不同的VLEN
+std::size_t rvv_vlenb();
+
+// 未调优时某一档的默认LMUL：取能在一次vsetvl内装下该档长度的最小LMUL
+// （寄存器组字节数lmul*vlenb不小于该档上限），最大为8；跨步搬运每个元素单独
+// 访存，VLEN>=256时上限为4以降低寄存器压力。K230（VLEN=128）下短搬运用m4/m8，
+// 更宽的实现上同样长度用更小的LMUL。纯函数，便于按任意vlenb检查选择逻辑
+int rvv_default_lmul(RvvCopyKind kind, int size_class, std::size_t vlenb);
+
+// 按当前VLEN把LMUL表恢复为默认值（首次使用时自动完成）
+void rvv_reset_lmul();
+
+// 小像素走索引加载（RvvGather，e32m8偏移）的上限：一条指令至少搬运两个像素，
+// 即像素元素数不超过vlenb（VLEN=128时为16个元素）
+std::size_t rvv_indexed_max_pixel();
+
+// 单次搬运bytes字节时选用的LMUL（1/2/4/8），未调优时为rvv_default_lmul
+int rvv_lmul(RvvCopyKind kind, std::size_t bytes);
+
+// 手动设置某一档的LMUL，lmul不是1/2/4/8时返回-1
+int rvv_set_lmul(RvvCopyKind kind, int size_class, int lmul);
+
+// 对每个(类别, 长度档)实测m1/m2/m4/m8的搬运耗时，记录最快的LMUL。
+// 只用gettimeofday计时、不依赖硬件计数器，在qemu等模拟器和板上都可运行
+// （模拟器下选出的是模拟开销最小的LMUL）。repeat为每次测量的重复次数，
+// verbose时打印每一档各LMUL的耗时
+void rvv_autotune(int repeat = 200, bool verbose = false);
+
+// 按lmul选择RvvCopyLmul<out_t, in_t, m>并调用fn(Copy())，
+// 供按LMUL模板化的内核在入口处分派
+template <typename out_t, typename in_t, typename Fn>
+int with_rvv_lmul(int lmul, Fn fn) {
+  switch (lmul) {
+  case 1:
+    return fn(RvvCopyLmul<out_t, in_t, 1>());
+  case 2:
+    return fn(RvvCopyLmul<out_t, in_t, 2>());
+  case 4:
+    return fn(RvvCopyLmul<out_t, in_t, 4>());
+  default:
+    return fn(RvvCopyLmul<out_t, in_t, 8>());
+  }
+}
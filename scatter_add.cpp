@@ -0,0 +1,334 @@
+#include "scatter_add.h"
+
+#include <riscv_vector.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include "tensor_util.h"
+
+namespace {
+// 按目标位置对索引分桶（稳定的计数排序），第d个桶是所有indices[n]==d的n，
+// 按n升序排列；之后每个目标只由一个线程按桶内顺序累加，结果与线程数无关
+struct IndexBuckets {
+  std::vector<size_t> start;  // D + 1个，第d个桶为order[start[d], start[d+1])
+  std::vector<size_t> order;
+};
+
+int bucket_indices(IndexBuckets& buckets, const std::vector<int>& indices,
+                   size_t D) {
+  buckets.start.assign(D + 1, 0);
+  buckets.order.resize(indices.size());
+  std::vector<size_t> target(indices.size());
+  for (size_t n = 0; n < indices.size(); ++n) {
+    int64_t idx = indices[n] >= 0 ? indices[n]
+                                  : indices[n] + static_cast<int64_t>(D);
+    if (idx < 0 || idx >= static_cast<int64_t>(D)) {
+      std::cerr << "索引越界：" << indices[n] << std::endl;
+      return -1;
+    }
+    target[n] = idx;
+    ++buckets.start[idx + 1];
+  }
+  for (size_t d = 0; d < D; ++d) {
+    buckets.start[d + 1] += buckets.start[d];
+  }
+  std::vector<size_t> fill(buckets.start.begin(), buckets.start.end() - 1);
+  for (size_t n = 0; n < indices.size(); ++n) {
+    buckets.order[fill[target[n]]++] = n;
+  }
+  return 0;
+}
+
+// 每个线程至少分到的累加元素数，太小的张量不值得创建线程
+constexpr size_t kMinWorkPerThread = 1 << 16;
+
+int resolve_threads(int num_threads, size_t work) {
+  if (num_threads <= 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  size_t useful = std::max<size_t>(work / kMinWorkPerThread, 1);
+  return std::max<int>(std::min<size_t>(num_threads, useful), 1);
+}
+
+// 把[0, total)均分给num_threads个线程，当前线程处理第一段
+template <typename Fn>
+void parallel_for(size_t total, int num_threads, Fn fn) {
+  size_t threads = std::min<size_t>(num_threads, total);
+  if (threads <= 1) {
+    fn(size_t{0}, total);
+    return;
+  }
+  size_t chunk = (total + threads - 1) / threads;
+  std::vector<std::thread> workers;
+  for (size_t begin = chunk; begin < total; begin += chunk) {
+    workers.emplace_back(fn, begin, std::min(total, begin + chunk));
+  }
+  fn(size_t{0}, chunk);
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+// 非通道轴的视图：grad_input为[outer][D][inner]，grad_output为[outer][N][inner]
+struct AddView {
+  size_t outer, D, N, inner;
+};
+
+// 按inner切分时的粒度（float个数），相邻线程不会写同一缓存行
+constexpr size_t kInnerGrain = 16;
+
+void add_rows_rvv(float* grad_in, const float* grad_out, const AddView& v,
+                  const IndexBuckets& buckets, size_t o0, size_t o1,
+                  size_t i0, size_t i1) {
+  for (size_t o = o0; o < o1; ++o) {
+    for (size_t d = 0; d < v.D; ++d) {
+      size_t b0 = buckets.start[d], b1 = buckets.start[d + 1];
+      if (b0 == b1) {
+        continue;
+      }
+      float* dst = grad_in + (o * v.D + d) * v.inner;
+      const float* src = grad_out + o * v.N * v.inner;
+      size_t i = i0;
+      while (i < i1) {
+        size_t vl = vsetvl_e32m8(i1 - i);
+        auto acc = vle32_v_f32m8(dst + i, vl);
+        for (size_t b = b0; b < b1; ++b) {
+          auto g = vle32_v_f32m8(src + buckets.order[b] * v.inner + i, vl);
+          acc = vfadd_vv_f32m8(acc, g, vl);
+        }
+        vse32_v_f32m8(dst + i, acc, vl);
+        i += vl;
+      }
+    }
+  }
+}
+
+void add_rows_mem(float* grad_in, const float* grad_out, const AddView& v,
+                  const IndexBuckets& buckets, size_t o0, size_t o1,
+                  size_t i0, size_t i1) {
+  for (size_t o = o0; o < o1; ++o) {
+    for (size_t d = 0; d < v.D; ++d) {
+      float* dst = grad_in + (o * v.D + d) * v.inner;
+      const float* src = grad_out + o * v.N * v.inner;
+      for (size_t b = buckets.start[d]; b < buckets.start[d + 1]; ++b) {
+        const float* g = src + buckets.order[b] * v.inner;
+        for (size_t i = i0; i < i1; ++i) {
+          dst[i] += g[i];
+        }
+      }
+    }
+  }
+}
+
+// outer足够多时按outer切分，否则按inner切分；两种切分下每个目标元素都只属于
+// 一个线程，且桶内累加顺序不变
+template <typename Kernel>
+void scatter_add_rows(std::vector<float>& grad_input,
+                      const std::vector<float>& grad_output, const AddView& v,
+                      const IndexBuckets& buckets, int num_threads,
+                      Kernel kernel) {
+  float* grad_in = grad_input.data();
+  const float* grad_out = grad_output.data();
+  if (v.outer >= static_cast<size_t>(num_threads)) {
+    parallel_for(v.outer, num_threads, [&](size_t begin, size_t end) {
+      kernel(grad_in, grad_out, v, buckets, begin, end, 0, v.inner);
+    });
+  } else {
+    size_t units = (v.inner + kInnerGrain - 1) / kInnerGrain;
+    parallel_for(units, num_threads, [&](size_t begin, size_t end) {
+      kernel(grad_in, grad_out, v, buckets, 0, v.outer, begin * kInnerGrain,
+             std::min(end * kInnerGrain, v.inner));
+    });
+  }
+}
+
+// 分块HWC的通道轴：grad_input为[in_cb][P][A]，grad_output为[out_cb][P][A]，
+// 通道c在第c/A个块的第c%A个位置；按像素[p0, p1)切分
+void add_channels_rvv(float* grad_in, const float* grad_out, size_t P,
+                      size_t A, const IndexBuckets& buckets, size_t p0,
+                      size_t p1) {
+  size_t C = buckets.start.size() - 1;
+  for (size_t c = 0; c < C; ++c) {
+    size_t b0 = buckets.start[c], b1 = buckets.start[c + 1];
+    if (b0 == b1) {
+      continue;
+    }
+    size_t p = p0;
+    while (p < p1) {
+      size_t vl = vsetvl_e32m8(p1 - p);
+      float* dst = grad_in + (c / A * P + p) * A + c % A;
+      auto acc = vlse32_v_f32m8(dst, A * sizeof(float), vl);
+      for (size_t b = b0; b < b1; ++b) {
+        size_t n = buckets.order[b];
+        const float* src = grad_out + (n / A * P + p) * A + n % A;
+        acc = vfadd_vv_f32m8(acc, vlse32_v_f32m8(src, A * sizeof(float), vl),
+                             vl);
+      }
+      vsse32_v_f32m8(dst, A * sizeof(float), acc, vl);
+      p += vl;
+    }
+  }
+}
+
+void add_channels_mem(float* grad_in, const float* grad_out, size_t P,
+                      size_t A, const IndexBuckets& buckets, size_t p0,
+                      size_t p1) {
+  size_t C = buckets.start.size() - 1;
+  for (size_t c = 0; c < C; ++c) {
+    for (size_t b = buckets.start[c]; b < buckets.start[c + 1]; ++b) {
+      size_t n = buckets.order[b];
+      for (size_t p = p0; p < p1; ++p) {
+        grad_in[(c / A * P + p) * A + c % A] +=
+            grad_out[(n / A * P + p) * A + n % A];
+      }
+    }
+  }
+}
+
+int scatter_add_chw_impl(std::vector<float>& grad_input,
+                         const std::vector<int>& in_shape,
+                         const std::vector<float>& grad_output,
+                         const std::vector<int>& indices, int axis,
+                         int num_threads, bool is_rvv) {
+  if (axis < 0 || axis >= static_cast<int>(in_shape.size())) {
+    std::cerr << "无效的axis：" << axis << std::endl;
+    return -1;
+  }
+  AddView v;
+  v.outer = std::accumulate(in_shape.begin(), in_shape.begin() + axis,
+                            size_t{1}, std::multiplies<size_t>{});
+  v.D = in_shape[axis];
+  v.N = indices.size();
+  v.inner = std::accumulate(in_shape.begin() + axis + 1, in_shape.end(),
+                            size_t{1}, std::multiplies<size_t>{});
+  if (grad_input.size() != v.outer * v.D * v.inner ||
+      grad_output.size() != v.outer * v.N * v.inner) {
+    std::cerr << "grad_input或grad_output大小与形状不匹配：" << grad_input.size()
+              << ", " << grad_output.size() << std::endl;
+    return -1;
+  }
+  IndexBuckets buckets;
+  if (bucket_indices(buckets, indices, v.D) != 0) {
+    return -1;
+  }
+  num_threads = resolve_threads(num_threads, grad_output.size());
+  if (is_rvv) {
+    scatter_add_rows(grad_input, grad_output, v, buckets, num_threads,
+                     add_rows_rvv);
+  } else {
+    scatter_add_rows(grad_input, grad_output, v, buckets, num_threads,
+                     add_rows_mem);
+  }
+  return 0;
+}
+
+int scatter_add_hwc_impl(std::vector<float>& grad_input,
+                         const std::vector<int>& in_shape_hwc,
+                         const std::vector<float>& grad_output,
+                         const std::vector<int>& indices, int axis_chw,
+                         int align_channels, int num_threads, bool is_rvv) {
+  int rank = in_shape_hwc.size();
+  if (rank < 3 || rank > 5 || axis_chw < 0 || axis_chw >= rank) {
+    std::cerr << "无效的输入形状或axis_chw：" << rank << ", " << axis_chw
+              << std::endl;
+    return -1;
+  }
+  if (static_cast<int64_t>(grad_input.size()) !=
+          blocked_numel(in_shape_hwc, align_channels) ||
+      static_cast<int64_t>(grad_output.size()) !=
+          gather_hwc_out_numel(in_shape_hwc, indices.size(), axis_chw,
+                               align_channels)) {
+    std::cerr << "grad_input或grad_output大小与形状不匹配：" << grad_input.size()
+              << ", " << grad_output.size() << std::endl;
+    return -1;
+  }
+  int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  IndexBuckets buckets;
+  if (bucket_indices(buckets, indices, in_shape_hwc[axis_hwc]) != 0) {
+    return -1;
+  }
+  num_threads = resolve_threads(num_threads, grad_output.size());
+
+  if (axis_hwc == rank - 1) {
+    size_t P = shape_numel(in_shape_hwc) / in_shape_hwc[rank - 1];
+    size_t A = align_channels;
+    float* grad_in = grad_input.data();
+    const float* grad_out = grad_output.data();
+    parallel_for(P, num_threads, [&](size_t begin, size_t end) {
+      if (is_rvv) {
+        add_channels_rvv(grad_in, grad_out, P, A, buckets, begin, end);
+      } else {
+        add_channels_mem(grad_in, grad_out, P, A, buckets, begin, end);
+      }
+    });
+    return 0;
+  }
+
+  // 非通道轴与CHW相同，只是outer包含通道块，inner包含align_channels
+  AddView v;
+  v.outer = padded_channels(in_shape_hwc[rank - 1], align_channels) /
+            align_channels;
+  for (int i = 0; i < axis_hwc; ++i) {
+    v.outer *= in_shape_hwc[i];
+  }
+  v.D = in_shape_hwc[axis_hwc];
+  v.N = indices.size();
+  v.inner = align_channels;
+  for (int i = axis_hwc + 1; i < rank - 1; ++i) {
+    v.inner *= in_shape_hwc[i];
+  }
+  if (is_rvv) {
+    scatter_add_rows(grad_input, grad_output, v, buckets, num_threads,
+                     add_rows_rvv);
+  } else {
+    scatter_add_rows(grad_input, grad_output, v, buckets, num_threads,
+                     add_rows_mem);
+  }
+  return 0;
+}
+}  // namespace
+
+namespace rvv {
+int scatter_add_chw(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis,
+                    int num_threads) {
+  return scatter_add_chw_impl(grad_input, in_shape, grad_output, indices, axis,
+                              num_threads, true);
+}
+
+int scatter_add_hwc(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape_hwc,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis_chw,
+                    int align_channels, int num_threads) {
+  return scatter_add_hwc_impl(grad_input, in_shape_hwc, grad_output, indices,
+                              axis_chw, align_channels, num_threads, true);
+}
+}  // namespace rvv
+
+namespace mem {
+int scatter_add_chw(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis,
+                    int num_threads) {
+  return scatter_add_chw_impl(grad_input, in_shape, grad_output, indices, axis,
+                              num_threads, false);
+}
+
+int scatter_add_hwc(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape_hwc,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis_chw,
+                    int align_channels, int num_threads) {
+  return scatter_add_hwc_impl(grad_input, in_shape_hwc, grad_output, indices,
+                              axis_chw, align_channels, num_threads, false);
+}
+}  // namespace mem
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+// gather_chw / gather_hwc的反向（梯度）：按gather的索引把grad_output累加回
+// grad_input，即grad_input[..., indices[n], ...] += grad_output[..., n, ...]。
+// grad_input必须已按输入形状分配好（清零或保留已有梯度），原地累加；
+// indices按展平顺序给出，多维索引与展平后的结果相同。
+// 重复索引时每个目标位置固定按n从小到大累加，不使用原子操作，
+// 结果与num_threads无关、逐位可复现；num_threads<=0时使用全部硬件线程
+namespace rvv {
+int scatter_add_chw(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis,
+                    int num_threads);
+
+// 分块HWC布局，axis_chw和align_channels与gather_hwc相同
+int scatter_add_hwc(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape_hwc,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis_chw,
+                    int align_channels, int num_threads);
+}
+
+namespace mem {
+int scatter_add_chw(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis,
+                    int num_threads);
+
+int scatter_add_hwc(std::vector<float>& grad_input,
+                    const std::vector<int>& in_shape_hwc,
+                    const std::vector<float>& grad_output,
+                    const std::vector<int>& indices, int axis_chw,
+                    int align_channels, int num_threads);
+}
@@ -0,0 +1,515 @@
+#include "tensor.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "convert.h"
+#include "gather.h"
+#include "gather_chw.h"
+#include "tensor_util.h"
+
+namespace {
+// [begin, end)维的元素数，超出int时抛出（convert_*的维度参数为int）
+int dims_product(const std::vector<int>& shape, int begin, int end) {
+  std::int64_t n = 1;
+  for (int d = begin; d < end; ++d) {
+    n *= shape[d];
+  }
+  if (n > std::numeric_limits<int>::max()) {
+    throw std::invalid_argument("张量维度之积超出int范围");
+  }
+  return static_cast<int>(n);
+}
+
+// 平面排布与(N, C, HW, 1)的分块排布之间的转换；
+// float走非模板的重载（convert_*<float, float>没有显式实例化）
+template <typename T>
+AlignedVector<T> planar_to_blocked(const AlignedVector<T>& input, int n, int c,
+                                   int hw, int align_channels) {
+  return convert_nchw_to_nhwc_4d<T, T>(input, n, c, hw, 1, align_channels);
+}
+
+AlignedVector<float> planar_to_blocked(const AlignedVector<float>& input,
+                                       int n, int c, int hw,
+                                       int align_channels) {
+  return convert_nchw_to_nhwc_4d(input, n, c, hw, 1, align_channels);
+}
+
+template <typename T>
+AlignedVector<T> blocked_to_planar(const AlignedVector<T>& input, int n, int c,
+                                   int hw, int align_channels) {
+  return convert_nhwc_to_nchw_4d<T, T>(input, n, c, hw, 1, align_channels);
+}
+
+AlignedVector<float> blocked_to_planar(const AlignedVector<float>& input,
+                                       int n, int c, int hw,
+                                       int align_channels) {
+  return convert_nhwc_to_nchw_4d(input, n, c, hw, 1, align_channels);
+}
+
+// 按下标顺序遍历shape的各维（odometer），dims为参与遍历的维，最后一维最快
+bool next_index(std::vector<int>& index, const std::vector<int>& shape,
+                const std::vector<int>& dims) {
+  for (int k = static_cast<int>(dims.size()) - 1; k >= 0; --k) {
+    int d = dims[k];
+    if (++index[d] < shape[d]) {
+      return true;
+    }
+    index[d] = 0;
+  }
+  return false;
+}
+}  // namespace
+
+template <typename T>
+Tensor<T>::Tensor(const std::vector<int>& shape, TensorLayout layout,
+                  int align_channels) {
+  init_layout(shape, layout, align_channels);
+  std::int64_t size = layout == kLayoutBlocked
+                          ? blocked_numel(shape_hwc(), align_channels)
+                          : numel();
+  data_ = std::make_shared<AlignedVector<T>>(size, T());
+}
+
+template <typename T>
+Tensor<T>::Tensor(AlignedVector<T> data, const std::vector<int>& shape,
+                  TensorLayout layout, int align_channels) {
+  init_layout(shape, layout, align_channels);
+  std::int64_t size = layout == kLayoutBlocked
+                          ? blocked_numel(shape_hwc(), align_channels)
+                          : numel();
+  if (static_cast<std::int64_t>(data.size()) != size) {
+    throw std::invalid_argument("输入数据大小与指定维度不匹配");
+  }
+  data_ = std::make_shared<AlignedVector<T>>(std::move(data));
+}
+
+template <typename T>
+Tensor<T>::Tensor(const std::vector<T>& data, const std::vector<int>& shape,
+                  TensorLayout layout, int align_channels)
+    : Tensor(AlignedVector<T>(data.begin(), data.end()), shape, layout,
+             align_channels) {}
+
+template <typename T>
+void Tensor<T>::init_layout(const std::vector<int>& shape, TensorLayout layout,
+                            int align_channels) {
+  int rank = shape.size();
+  if (rank == 0) {
+    throw std::invalid_argument("张量形状不能为空");
+  }
+  for (int d : shape) {
+    if (d < 0) {
+      throw std::invalid_argument("张量维度不能为负数");
+    }
+  }
+  if (layout == kLayoutBlocked &&
+      (rank < 3 || rank > 5 || align_channels <= 0)) {
+    throw std::invalid_argument("分块排布只支持3~5维且align_channels大于0");
+  }
+  shape_ = shape;
+  layout_ = layout;
+  align_channels_ = layout == kLayoutBlocked ? align_channels : 0;
+  offset_ = 0;
+  strides_.assign(rank, 0);
+  if (layout == kLayoutPlanar) {
+    std::int64_t stride = 1;
+    for (int d = rank - 1; d >= 0; --d) {
+      strides_[d] = stride;
+      stride *= shape[d];
+    }
+    block_stride_ = 0;
+    return;
+  }
+  // 块内通道连续，其余维在块内按行优先排列，最内层步长为align_channels
+  int c_axis = channel_axis();
+  std::int64_t stride = align_channels;
+  for (int d = rank - 1; d >= 0; --d) {
+    if (d == c_axis) {
+      continue;
+    }
+    strides_[d] = stride;
+    stride *= shape[d];
+  }
+  strides_[c_axis] = 1;
+  block_stride_ = stride;
+}
+
+template <typename T>
+int Tensor<T>::channel_axis() const {
+  if (rank() < 3) {
+    return -1;
+  }
+  return rank() == 3 ? 0 : 1;
+}
+
+template <typename T>
+std::vector<int> Tensor<T>::shape_hwc() const {
+  int c_axis = channel_axis();
+  if (c_axis < 0) {
+    return shape_;
+  }
+  std::vector<int> shape_hwc;
+  for (int d = 0; d < rank(); ++d) {
+    if (d != c_axis) {
+      shape_hwc.push_back(shape_[d]);
+    }
+  }
+  shape_hwc.push_back(shape_[c_axis]);
+  return shape_hwc;
+}
+
+template <typename T>
+std::int64_t Tensor<T>::numel() const {
+  return shape_.empty() ? 0 : shape_numel(shape_);
+}
+
+template <typename T>
+bool Tensor<T>::is_contiguous() const {
+  if (!data_ || offset_ != 0) {
+    return false;
+  }
+  Tensor<T> canonical;
+  canonical.init_layout(shape_, layout_, align_channels_);
+  std::int64_t size = layout_ == kLayoutBlocked
+                          ? blocked_numel(shape_hwc(), align_channels_)
+                          : numel();
+  return static_cast<std::int64_t>(data_->size()) == size &&
+         strides_ == canonical.strides_ &&
+         block_stride_ == canonical.block_stride_;
+}
+
+template <typename T>
+Tensor<T> Tensor<T>::reshape(const std::vector<int>& shape) const {
+  if (!is_contiguous()) {
+    throw std::invalid_argument("只有连续的张量能reshape，请先调用contiguous");
+  }
+  if (shape.empty() || shape_numel(shape) != numel()) {
+    throw std::invalid_argument("reshape前后元素数不一致");
+  }
+  Tensor<T> result;
+  result.init_layout(shape, layout_, align_channels_);
+  if (layout_ == kLayoutBlocked) {
+    int c_old = channel_axis();
+    int c_new = result.channel_axis();
+    if (shape[c_new] != shape_[c_old]) {
+      throw std::invalid_argument("分块排布reshape时C维大小不能改变");
+    }
+    // 存储中C维块在最外层，逻辑上C之前的维只有全为1或保持不变时，
+    // 按行主序reshape才等价于重排块内的非C维
+    bool leading_ones = dims_product(shape_, 0, c_old) == 1 &&
+                        dims_product(shape, 0, c_new) == 1;
+    bool same_leading =
+        c_old == c_new &&
+        std::equal(shape_.begin(), shape_.begin() + c_old, shape.begin());
+    if (!leading_ones && !same_leading) {
+      throw std::invalid_argument(
+          "分块排布reshape时C维之前的维须全为1或保持不变，"
+          "请先to_planar后在平面张量上reshape");
+    }
+  }
+  result.data_ = data_;
+  return result;
+}
+
+template <typename T>
+Tensor<T> Tensor<T>::slice(int axis, int start, int length) const {
+  if (axis < 0 || axis >= rank()) {
+    throw std::invalid_argument("无效的axis");
+  }
+  if (start < 0 || length < 0 || start + length > shape_[axis]) {
+    throw std::out_of_range("切片范围越界");
+  }
+  Tensor<T> result = *this;
+  result.shape_[axis] = length;
+  if (layout_ == kLayoutBlocked && axis == channel_axis()) {
+    if (start % align_channels_ != 0) {
+      throw std::invalid_argument(
+          "分块排布的C维切片起点必须是align_channels的整数倍");
+    }
+    result.offset_ += start / align_channels_ * block_stride_;
+  } else {
+    result.offset_ += start * strides_[axis];
+  }
+  return result;
+}
+
+template <typename T>
+Tensor<T> Tensor<T>::contiguous() const {
+  if (is_contiguous()) {
+    return *this;
+  }
+  Tensor<T> result(shape_, layout_, align_channels_);
+  if (numel() == 0) {
+    return result;
+  }
+  const T* src = data_->data() + offset_;
+  T* dst = result.data_->data();
+  std::vector<int> index(rank(), 0);
+  if (layout_ == kLayoutPlanar) {
+    // 逐行拷贝最后一维
+    std::vector<int> outer_dims;
+    for (int d = 0; d + 1 < rank(); ++d) {
+      outer_dims.push_back(d);
+    }
+    int len = shape_.back();
+    std::int64_t inner_stride = strides_.back();
+    do {
+      std::int64_t off = 0;
+      for (int d : outer_dims) {
+        off += index[d] * strides_[d];
+      }
+      for (int i = 0; i < len; ++i) {
+        *dst++ = src[off + i * inner_stride];
+      }
+    } while (next_index(index, shape_, outer_dims));
+    return result;
+  }
+  // 分块排布逐像素拷贝块内的有效通道，补齐通道保持为0
+  int c_axis = channel_axis();
+  int C = shape_[c_axis];
+  int A = align_channels_;
+  std::vector<int> outer_dims;
+  for (int d = 0; d < rank(); ++d) {
+    if (d != c_axis) {
+      outer_dims.push_back(d);
+    }
+  }
+  for (int cb = 0; cb * A < C; ++cb) {
+    int lanes = std::min(A, C - cb * A);
+    std::fill(index.begin(), index.end(), 0);
+    do {
+      std::int64_t off = cb * block_stride_;
+      for (int d : outer_dims) {
+        off += index[d] * strides_[d];
+      }
+      std::copy(src + off, src + off + lanes, dst);
+      dst += A;
+    } while (next_index(index, shape_, outer_dims));
+  }
+  return result;
+}
+
+template <typename T>
+std::int64_t Tensor<T>::element_offset(const std::vector<int>& index) const {
+  if (static_cast<int>(index.size()) != rank()) {
+    throw std::out_of_range("下标维数与张量不一致");
+  }
+  int c_axis = layout_ == kLayoutBlocked ? channel_axis() : -1;
+  std::int64_t off = offset_;
+  for (int d = 0; d < rank(); ++d) {
+    if (index[d] < 0 || index[d] >= shape_[d]) {
+      throw std::out_of_range("下标越界");
+    }
+    if (d == c_axis) {
+      off += index[d] / align_channels_ * block_stride_ +
+             index[d] % align_channels_;
+    } else {
+      off += index[d] * strides_[d];
+    }
+  }
+  return off;
+}
+
+template <typename T>
+T Tensor<T>::at(const std::vector<int>& index) const {
+  return (*data_)[element_offset(index)];
+}
+
+template <typename T>
+AlignedVector<T>& Tensor<T>::reset(const std::vector<int>& shape,
+                                   TensorLayout layout, int align_channels) {
+  init_layout(shape, layout, align_channels);
+  if (!data_ || data_.use_count() > 1) {
+    data_ = std::make_shared<AlignedVector<T>>();
+  } else {
+    // 保留容量但清空内容：C轴kernel只resize补0新增的元素，补齐通道
+    // 不能留下上一次写入的数据
+    data_->clear();
+  }
+  return *data_;
+}
+
+template <typename T>
+Tensor<T> to_blocked(const Tensor<T>& input, int align_channels) {
+  if (input.layout() == kLayoutBlocked) {
+    if (input.align_channels() == align_channels) {
+      return input;
+    }
+    return to_blocked(to_planar(input), align_channels);
+  }
+  if (input.rank() < 3 || input.rank() > 5 || align_channels <= 0) {
+    throw std::invalid_argument("分块排布只支持3~5维且align_channels大于0");
+  }
+  Tensor<T> src = input.contiguous();
+  const std::vector<int>& shape = src.shape();
+  int c_axis = src.channel_axis();
+  return Tensor<T>(
+      planar_to_blocked(src.storage(), dims_product(shape, 0, c_axis),
+                        shape[c_axis],
+                        dims_product(shape, c_axis + 1, src.rank()),
+                        align_channels),
+      shape, kLayoutBlocked, align_channels);
+}
+
+template <typename T>
+Tensor<T> to_planar(const Tensor<T>& input) {
+  if (input.layout() == kLayoutPlanar) {
+    return input;
+  }
+  Tensor<T> src = input.contiguous();
+  const std::vector<int>& shape = src.shape();
+  int c_axis = src.channel_axis();
+  return Tensor<T>(
+      blocked_to_planar(src.storage(), dims_product(shape, 0, c_axis),
+                        shape[c_axis],
+                        dims_product(shape, c_axis + 1, src.rank()),
+                        src.align_channels()),
+      shape, kLayoutPlanar, 0);
+}
+
+namespace {
+template <bool kRvv, typename out_t, typename in_t>
+int gather_tensor(Tensor<out_t>& output, const Tensor<in_t>& input,
+                  const std::vector<int>& indices, int axis) {
+  if (axis < 0 || axis >= input.rank()) {
+    std::cerr << "无效的axis：" << axis << std::endl;
+    return -1;
+  }
+  // 负索引在分发前统一加上轴长，分块和平面两条路径看到的索引一致
+  int dim = input.shape()[axis];
+  std::vector<int> normalized(indices);
+  for (int& index : normalized) {
+    if (index < -dim || index >= dim) {
+      std::cerr << "索引越界：" << index << std::endl;
+      return -1;
+    }
+    if (index < 0) {
+      index += dim;
+    }
+  }
+  // output与input共享存储时reset会换新的缓冲区，src保持输入不被覆盖
+  Tensor<in_t> src = input.contiguous();
+  std::vector<int> out_shape = src.shape();
+  out_shape[axis] = indices.size();
+  AlignedVector<out_t>& buffer =
+      output.reset(out_shape, src.layout(), src.align_channels());
+  int ret;
+  if (src.layout() == kLayoutBlocked) {
+    ret = kRvv ? rvv::gather_hwc<out_t, in_t>(
+                     buffer, src.storage(), src.shape_hwc(), normalized, axis,
+                     src.align_channels())
+               : mem::gather_hwc<out_t, in_t>(
+                     buffer, src.storage(), src.shape_hwc(), normalized, axis,
+                     src.align_channels());
+  } else {
+    ret = kRvv ? rvv::gather_chw<out_t, in_t>(buffer, src.storage(),
+                                              src.shape(), normalized, axis)
+               : mem::gather_chw<out_t, in_t>(buffer, src.storage(),
+                                              src.shape(), normalized, axis);
+  }
+  if (ret != 0) {
+    output = Tensor<out_t>();
+    return -1;
+  }
+  return 0;
+}
+
+template <bool kRvv, typename out_t, typename in_t>
+int gather_tensor(Tensor<out_t>& output, const Tensor<in_t>& input,
+                  const std::vector<int>& indices, int axis,
+                  TensorLayout out_layout, int align_channels) {
+  if (out_layout == kLayoutBlocked &&
+      (input.rank() < 3 || input.rank() > 5 || align_channels <= 0)) {
+    std::cerr << "无效的align_channels：" << align_channels << std::endl;
+    return -1;
+  }
+  if (input.layout() == out_layout &&
+      (out_layout == kLayoutPlanar ||
+       input.align_channels() == align_channels)) {
+    return gather_tensor<kRvv>(output, input, indices, axis);
+  }
+  Tensor<out_t> gathered;
+  if (gather_tensor<kRvv>(gathered, input, indices, axis) != 0) {
+    return -1;
+  }
+  output = out_layout == kLayoutBlocked ? to_blocked(gathered, align_channels)
+                                        : to_planar(gathered);
+  return 0;
+}
+}  // namespace
+
+#define TENSOR_INSTANTIATE(T)                                                  \
+  template class Tensor<T>;                                                    \
+  template Tensor<T> to_blocked<T>(const Tensor<T>&, int);                     \
+  template Tensor<T> to_planar<T>(const Tensor<T>&);
+
+TENSOR_INSTANTIATE(float)
+TENSOR_INSTANTIATE(float16)
+TENSOR_INSTANTIATE(bfloat16)
+TENSOR_INSTANTIATE(std::int8_t)
+TENSOR_INSTANTIATE(std::uint8_t)
+
+// 支持的(输出类型, 输入类型)组合，与gather_hwc相同
+#define TENSOR_GATHER_INSTANTIATE(out_t, in_t)                                 \
+  template int gather<out_t, in_t>(Tensor<out_t>&, const Tensor<in_t>&,        \
+                                   const std::vector<int>&, int);              \
+  template int gather<out_t, in_t>(Tensor<out_t>&, const Tensor<in_t>&,        \
+                                   const std::vector<int>&, int,               \
+                                   TensorLayout, int);
+
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis) {
+  return gather_tensor<true>(output, input, indices, axis);
+}
+
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis, TensorLayout out_layout,
+           int align_channels) {
+  return gather_tensor<true>(output, input, indices, axis, out_layout,
+                             align_channels);
+}
+
+TENSOR_GATHER_INSTANTIATE(float, float)
+TENSOR_GATHER_INSTANTIATE(float16, float16)
+TENSOR_GATHER_INSTANTIATE(bfloat16, bfloat16)
+TENSOR_GATHER_INSTANTIATE(float, float16)
+TENSOR_GATHER_INSTANTIATE(float16, float)
+TENSOR_GATHER_INSTANTIATE(float, bfloat16)
+TENSOR_GATHER_INSTANTIATE(bfloat16, float)
+TENSOR_GATHER_INSTANTIATE(std::int8_t, std::int8_t)
+TENSOR_GATHER_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis) {
+  return gather_tensor<false>(output, input, indices, axis);
+}
+
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis, TensorLayout out_layout,
+           int align_channels) {
+  return gather_tensor<false>(output, input, indices, axis, out_layout,
+                              align_channels);
+}
+
+TENSOR_GATHER_INSTANTIATE(float, float)
+TENSOR_GATHER_INSTANTIATE(float16, float16)
+TENSOR_GATHER_INSTANTIATE(bfloat16, bfloat16)
+TENSOR_GATHER_INSTANTIATE(float, float16)
+TENSOR_GATHER_INSTANTIATE(float16, float)
+TENSOR_GATHER_INSTANTIATE(float, bfloat16)
+TENSOR_GATHER_INSTANTIATE(bfloat16, float)
+TENSOR_GATHER_INSTANTIATE(std::int8_t, std::int8_t)
+TENSOR_GATHER_INSTANTIATE(std::uint8_t, std::uint8_t)
+}  // namespace mem
+
+#undef TENSOR_INSTANTIATE
+#undef TENSOR_GATHER_INSTANTIATE
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "elem_type.h"
+
+// 张量的元素类型
+enum TensorDType {
+  kDTypeFloat32 = 0,
+  kDTypeFloat16 = 1,
+  kDTypeBFloat16 = 2,
+  kDTypeInt8 = 3,
+  kDTypeUInt8 = 4
+};
+
+template <typename T>
+struct TensorDTypeOf;
+template <>
+struct TensorDTypeOf<float> {
+  static constexpr TensorDType value = kDTypeFloat32;
+};
+template <>
+struct TensorDTypeOf<float16> {
+  static constexpr TensorDType value = kDTypeFloat16;
+};
+template <>
+struct TensorDTypeOf<bfloat16> {
+  static constexpr TensorDType value = kDTypeBFloat16;
+};
+template <>
+struct TensorDTypeOf<std::int8_t> {
+  static constexpr TensorDType value = kDTypeInt8;
+};
+template <>
+struct TensorDTypeOf<std::uint8_t> {
+  static constexpr TensorDType value = kDTypeUInt8;
+};
+
+// 张量的物理排布
+enum TensorLayout {
+  kLayoutPlanar = 0,  // 行优先的CHW/NCHW/NCDHW，即gather_chw的排布
+  kLayoutBlocked = 1  // 分块HWC [cb][其余维][align_channels]，gather_hwc的排布
+};
+
+// 张量句柄：记录元素类型、逻辑形状、物理排布、步长和通道对齐，数据放在共享的
+// AlignedVector中。逻辑形状总是CHW编号（与gather_chw的in_shape、gather_hwc的
+// axis_chw相同），C维为3维时的第0维、4/5维时的第1维；分块排布交给kernel的
+// 形状由shape_hwc()给出，调用者不必再区分in_shape和in_shape_hwc。
+// 复制句柄、reshape和slice都不拷贝数据，与原张量共享存储。元素的位置：
+//   平面排布 data()[sum_d i_d * strides()[d]]
+//   分块排布 data()[sum_{d!=C} i_d * strides()[d]
+//                   + i_C / A * block_stride() + i_C % A]
+template <typename T>
+class Tensor {
+ public:
+  Tensor() = default;
+
+  // 新分配并清零。分块排布只支持3~5维且align_channels>0，
+  // 形状或参数无效时抛出std::invalid_argument（下同）
+  explicit Tensor(const std::vector<int>& shape,
+                  TensorLayout layout = kLayoutPlanar, int align_channels = 0);
+
+  // 接管/拷贝已有数据：平面排布为numel个元素，分块排布为补齐通道后的大小
+  Tensor(AlignedVector<T> data, const std::vector<int>& shape,
+         TensorLayout layout = kLayoutPlanar, int align_channels = 0);
+  Tensor(const std::vector<T>& data, const std::vector<int>& shape,
+         TensorLayout layout = kLayoutPlanar, int align_channels = 0);
+
+  TensorDType dtype() const { return TensorDTypeOf<T>::value; }
+  TensorLayout layout() const { return layout_; }
+  int align_channels() const { return align_channels_; }
+  int rank() const { return static_cast<int>(shape_.size()); }
+  const std::vector<int>& shape() const { return shape_; }
+  const std::vector<std::int64_t>& strides() const { return strides_; }
+  std::int64_t block_stride() const { return block_stride_; }
+  // C维的位置，不足3维时为-1
+  int channel_axis() const;
+  // 分块HWC顺序的形状（C在最后），即gather_hwc的in_shape_hwc
+  std::vector<int> shape_hwc() const;
+  std::int64_t numel() const;
+
+  const T* data() const { return data_ ? data_->data() + offset_ : nullptr; }
+  T* data() { return data_ ? data_->data() + offset_ : nullptr; }
+  bool shares_storage(const Tensor& other) const {
+    return data_ != nullptr && data_ == other.data_;
+  }
+
+  // 占满整个存储且为标准排布（分块排布的补齐通道也在存储中），
+  // 只有这样的张量能直接交给gather/convert的kernel
+  bool is_contiguous() const;
+  // is_contiguous时的整个存储，即kernel的输入
+  const AlignedVector<T>& storage() const { return *data_; }
+
+  // 只改变逻辑形状，不拷贝。要求is_contiguous且元素数不变；
+  // 分块排布还要求仍为3~5维、C维大小不变，且C维之前的维全为1或保持不变
+  // （C维之后的维可以任意合并、拆分），否则应在平面张量上reshape
+  Tensor reshape(const std::vector<int>& shape) const;
+
+  // 沿axis取[start, start + length)，不拷贝；
+  // 分块排布在C维切片时start必须是align_channels的整数倍
+  Tensor slice(int axis, int start, int length) const;
+
+  // is_contiguous时返回共享数据的自身，否则拷贝为标准排布（补齐通道为0）
+  Tensor contiguous() const;
+
+  // 按逻辑下标读一个元素，下标越界时抛出std::out_of_range
+  T at(const std::vector<int>& index) const;
+
+  // 把张量改为指定形状和排布的标准张量，返回存储供kernel写入：存储不与
+  // 其他张量共享时沿用原缓冲区并清空（保留容量，跨帧复用不重新分配），
+  // 否则换一个新的。写入后存储大小应与形状一致
+  AlignedVector<T>& reset(const std::vector<int>& shape, TensorLayout layout,
+                          int align_channels);
+
+ private:
+  void init_layout(const std::vector<int>& shape, TensorLayout layout,
+                   int align_channels);
+  std::int64_t element_offset(const std::vector<int>& index) const;
+
+  std::shared_ptr<AlignedVector<T>> data_;
+  std::int64_t offset_ = 0;
+  std::vector<int> shape_;
+  std::vector<std::int64_t> strides_;
+  std::int64_t block_stride_ = 0;
+  TensorLayout layout_ = kLayoutPlanar;
+  int align_channels_ = 0;
+};
+
+// 排布转换：已是目标排布（分块排布还要求align_channels相同）时直接返回
+// 共享数据的输入，不做任何拷贝；否则调用convert_*转换。
+// 任意维数都按N=C之前各维之积、HW=C之后各维之积的NCHW转换
+template <typename T>
+Tensor<T> to_blocked(const Tensor<T>& input, int align_channels);
+
+template <typename T>
+Tensor<T> to_planar(const Tensor<T>& input);
+
+// 按输入排布分派：平面排布调用gather_chw，分块排布调用gather_hwc，
+// axis为CHW编号，输出与输入的排布和align_channels相同。
+// 输入不是is_contiguous时先拷贝为标准排布。参数错误时返回-1。
+// 类型组合与gather_hwc相同（含float）
+namespace rvv {
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis);
+
+// 指定输出排布：排布相同时不做转换，不同时先在输入排布上gather、
+// 再转换gather后（通常更小）的张量
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis, TensorLayout out_layout,
+           int align_channels);
+}  // namespace rvv
+
+namespace mem {
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis);
+
+template <typename out_t, typename in_t>
+int gather(Tensor<out_t>& output, const Tensor<in_t>& input,
+           const std::vector<int>& indices, int axis, TensorLayout out_layout,
+           int align_channels);
+}  // namespace mem
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// 形状的元素总数，按64位累乘避免int溢出
+inline std::int64_t shape_numel(const std::vector<int>& shape) {
+  std::int64_t numel = 1;
+  for (auto d : shape) {
+    numel *= d;
+  }
+  return numel;
+}
+
+// 按align_channels分块补零后的通道数
+inline std::int64_t padded_channels(std::int64_t c, int align_channels) {
+  return (c + align_channels - 1) / align_channels * align_channels;
+}
+
+// 分块HWC张量（C在最后、按align_channels补零）的元素总数
+inline std::int64_t blocked_numel(const std::vector<int>& shape_hwc,
+                                  int align_channels) {
+  std::int64_t numel = padded_channels(shape_hwc.back(), align_channels);
+  for (std::size_t i = 0; i + 1 < shape_hwc.size(); ++i) {
+    numel *= shape_hwc[i];
+  }
+  return numel;
+}
+
+// 元素数能用int32表示时，kernel走32位偏移的快速路径
+inline bool fits_int32(std::int64_t numel) {
+  return numel <= std::numeric_limits<std::int32_t>::max();
+}
+
+// CHW编号的axis转换为分块HWC形状中的位置（C在最后）
+// 3维CHW: C->2, H->0, W->1; 4维NCHW: N->0, C->3, H->1, W->2;
+// 5维NCDHW: N->0, C->4, D->1, H->2, W->3
+inline int chw_axis_to_hwc(int axis_chw, int rank) {
+  int c_axis = rank == 3 ? 0 : 1;
+  if (axis_chw == c_axis) {
+    return rank - 1;
+  }
+  return axis_chw < c_axis ? axis_chw : axis_chw - 1;
+}
+
+// 分块HWC布局下gather的输出元素数（C轴gather时输出通道同样补零对齐）
+inline std::int64_t gather_hwc_out_numel(const std::vector<int>& in_shape_hwc,
+                                         std::size_t num_indices, int axis_chw,
+                                         int align_channels) {
+  int rank = in_shape_hwc.size();
+  int axis_hwc = chw_axis_to_hwc(axis_chw, rank);
+  std::int64_t numel = 1;
+  for (int i = 0; i < rank - 1; ++i) {
+    numel *= i == axis_hwc ? static_cast<std::int64_t>(num_indices)
+                           : in_shape_hwc[i];
+  }
+  std::int64_t c = axis_hwc == rank - 1
+                       ? static_cast<std::int64_t>(num_indices)
+                       : in_shape_hwc[rank - 1];
+  return numel * padded_channels(c, align_channels);
+}
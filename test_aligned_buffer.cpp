@@ -0,0 +1,76 @@
+#include "aligned_buffer.h"
+#include "gather.h"
+#include "op.h"
+#include "tensor_util.h"
+
+namespace {
+const char *huge_page_mode_name(HugePageMode mode) {
+  switch (mode) {
+  case kHugePageNone:
+    return "none";
+  case kHugePageTransparent:
+    return "thp";
+  default:
+    return "hugetlb";
+  }
+}
+} // namespace
+
+// 对比std::vector与AlignedVector（分别不用巨页、透明巨页、显式巨页）存放的
+// 分块HWC张量上gather_hwc的耗时与结果。大的5维张量沿C轴gather时每个像素
+// 跨一次页，TLB缺失的差别体现在耗时上（rt-smart上没有性能计数器）。
+// 打印数据指针的对齐余数和实际落在巨页上的分配次数
+float TestAlignedBuffer(std::vector<int> in_shape_hwc, std::vector<int> indices,
+                        int axis, int align_channels, int repeat) {
+  size_t numel = blocked_numel(in_shape_hwc, align_channels);
+  std::vector<float> input(numel);
+  for (size_t i = 0; i < numel; ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+
+  struct timeval start, end;
+  std::vector<float> expected;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    rvv::gather_hwc(expected, input, in_shape_hwc, indices, axis,
+                    align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float vector_time_use = elapsed_ms(start, end) / repeat;
+  printf("std::vector %zu KB,axis_%d,channel_%2d,input %% 64 = %2zu,"
+         "%7.3f ms\n",
+         numel * sizeof(float) / 1024, axis, align_channels,
+         reinterpret_cast<uintptr_t>(input.data()) % 64, vector_time_use);
+
+  HugePageMode saved_mode = huge_page_mode();
+  float best_time_use = vector_time_use;
+  const HugePageMode modes[] = {kHugePageNone, kHugePageTransparent,
+                                kHugePageExplicit};
+  for (HugePageMode mode : modes) {
+    set_huge_page_mode(mode);
+    size_t huge_before = huge_page_allocations();
+    AlignedVector<float> aligned_input(input.begin(), input.end());
+    AlignedVector<float> output;
+    gettimeofday(&start, NULL);
+    for (int r = 0; r < repeat; ++r) {
+      rvv::gather_hwc(output, aligned_input, in_shape_hwc, indices, axis,
+                      align_channels);
+    }
+    gettimeofday(&end, NULL);
+    float time_use = elapsed_ms(start, end) / repeat;
+    best_time_use = std::min(best_time_use, time_use);
+    bool same = output.size() == expected.size() &&
+                std::equal(output.begin(), output.end(), expected.begin());
+    printf("aligned %-7s,%s,input %% %zu = %zu,output %% %zu = %zu,"
+           "huge page allocations %zu,%7.3f ms\n",
+           huge_page_mode_name(mode), same ? "ok" : "failed",
+           kTensorAlignment,
+           reinterpret_cast<uintptr_t>(aligned_input.data()) %
+               kTensorAlignment,
+           kTensorAlignment,
+           reinterpret_cast<uintptr_t>(output.data()) % kTensorAlignment,
+           huge_page_allocations() - huge_before, time_use);
+  }
+  set_huge_page_mode(saved_mode);
+  return best_time_use;
+}
@@ -0,0 +1,72 @@
+#include "gather.h"
+#include "gather_batch.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// 模拟检测头：num_jobs个小特征图（高宽依次为h、h/2、h/4循环），每个都沿axis
+// 按indices做gather。对比逐个调用gather_hwc、每帧准备并执行批量gather、
+// 复用批量计划三种方式的每帧耗时和吞吐（每毫秒完成的gather数）
+float TestGatherBatch(int num_jobs, int c, int h, int w,
+                      std::vector<int> indices, int axis, int align_channels,
+                      int num_threads, int repeat) {
+  std::vector<std::vector<float>> inputs(num_jobs);
+  std::vector<std::vector<float>> loop_outputs(num_jobs);
+  std::vector<std::vector<float>> batch_outputs(num_jobs);
+  std::vector<GatherJob<float, float>> jobs;
+  std::int64_t bytes = 0;
+  for (int i = 0; i < num_jobs; ++i) {
+    int scale = 1 << (i % 3);
+    std::vector<int> shape_hwc = {std::max(h / scale, 1),
+                                  std::max(w / scale, 1), c};
+    inputs[i].resize(blocked_numel(shape_hwc, align_channels));
+    for (size_t k = 0; k < inputs[i].size(); ++k) {
+      inputs[i][k] = static_cast<float>((k + i) % 1024);
+    }
+    jobs.push_back({&batch_outputs[i], &inputs[i], shape_hwc, indices, axis,
+                    align_channels});
+    bytes += gather_hwc_out_numel(shape_hwc, indices.size(), axis,
+                                  align_channels) *
+             sizeof(float);
+  }
+
+  struct timeval start, end;
+  bool ok = true;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    for (int i = 0; i < num_jobs; ++i) {
+      ok = ok && rvv::gather_hwc(loop_outputs[i], inputs[i],
+                                 jobs[i].in_shape_hwc, indices, axis,
+                                 align_channels) == 0;
+    }
+  }
+  gettimeofday(&end, NULL);
+  float loop_time_use = elapsed_ms(start, end) / repeat;
+
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    ok = ok && rvv::gather_hwc_batch(jobs, num_threads) == 0;
+  }
+  gettimeofday(&end, NULL);
+  float oneshot_time_use = elapsed_ms(start, end) / repeat;
+  ok = ok && batch_outputs == loop_outputs;
+
+  GatherBatchPlan batch;
+  ok = ok && prepare_gather_batch(batch, jobs, num_threads) == 0;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    ok = ok && rvv::gather_hwc_batch(jobs, batch) == 0;
+  }
+  gettimeofday(&end, NULL);
+  float batch_time_use = elapsed_ms(start, end) / repeat;
+  ok = ok && batch_outputs == loop_outputs;
+
+  printf("batch %d jobs,%d_%d_%d,axis_%d,channel_%2d,%s,%d threads,%zu tasks,"
+         "%6.1f KB/frame,loop %7.3f ms (%6.1f jobs/ms),"
+         "batch %7.3f ms (%6.1f jobs/ms),planned %7.3f ms (%6.1f jobs/ms)\n",
+         num_jobs, c, h, w, axis, align_channels, ok ? "ok" : "failed",
+         batch.num_threads, batch.tasks.size(), bytes / 1024.0, loop_time_use,
+         num_jobs / loop_time_use, oneshot_time_use,
+         num_jobs / oneshot_time_use, batch_time_use,
+         num_jobs / batch_time_use);
+  return batch_time_use;
+}
@@ -0,0 +1,69 @@
+#include "gather.h"
+#include "gather_plan.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// 依次调用gather_hwc（每步写出中间张量）与合并成一次多轴搬运的gather链的耗时对比，
+// axes[i]和indices[i]为第i步的axis（CHW编号）和索引
+float TestGatherHWCChain(bool is_rvv, std::vector<int> in_shape,
+                         std::vector<int> axes,
+                         std::vector<std::vector<int>> indices,
+                         int align_channels) {
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  int C = in_shape.back();
+  size_t P = input_size / padded_channels(C, align_channels);
+  for (size_t i = 0; i < input_size; ++i) {
+    int c = i / (P * align_channels) * align_channels + i % align_channels;
+    input[i] = c < C ? static_cast<float>(i % 1024) : 0.0f;
+  }
+  std::vector<GatherOp> ops;
+  for (size_t k = 0; k < axes.size(); ++k) {
+    ops.push_back({axes[k], indices[k]});
+  }
+
+  struct timeval start, end;
+  int ret = 0;
+  std::vector<float> current = input;
+  std::vector<int> shape = in_shape;
+  gettimeofday(&start, NULL);
+  for (const GatherOp &op : ops) {
+    std::vector<float> next;
+    if (is_rvv) {
+      ret |= rvv::gather_hwc(next, current, shape, op.indices, op.axis_chw,
+                             align_channels);
+    } else {
+      ret |= mem::gather_hwc(next, current, shape, op.indices, op.axis_chw,
+                             align_channels);
+    }
+    shape[chw_axis_to_hwc(op.axis_chw, shape.size())] = op.indices.size();
+    current.swap(next);
+  }
+  gettimeofday(&end, NULL);
+  float sequential_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                               (end.tv_usec - start.tv_usec)) /
+                              1000.0 / 1.0;
+
+  std::vector<float> output;
+  std::vector<int> out_shape;
+  gettimeofday(&start, NULL);
+  if (is_rvv) {
+    ret |= rvv::gather_hwc_chain(output, out_shape, input, in_shape, ops,
+                                 align_channels);
+  } else {
+    ret |= mem::gather_hwc_chain(output, out_shape, input, in_shape, ops,
+                                 align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float chain_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                          (end.tv_usec - start.tv_usec)) /
+                         1000.0 / 1.0;
+
+  bool same = ret == 0 && output == current && out_shape == shape;
+  printf(
+      "gather_hwc chain rank%zu,%zu steps,channel_%2d,%s,"
+      "sequential %7.3f ms,chain %7.3f ms\n",
+      in_shape.size(), ops.size(), align_channels, same ? "ok" : "failed",
+      sequential_time_use, chain_time_use);
+  return chain_time_use;
+}
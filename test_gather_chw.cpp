@@ -6,11 +6,11 @@ void TestGatherCHW(bool is_rvv, std::vector<int> in_shape,
                    std::vector<int> indices_shape, const char* input_path,
                    const char* indices_path, const char* output_path,
                    int axis) {
-  int input_size = 1;
+  size_t input_size = 1;
   for (auto i : in_shape) {
     input_size *= i;
   }
-  int num_indices = 1;
+  size_t num_indices = 1;
   for (auto i : indices_shape) {
     num_indices *= i;
   }
@@ -21,6 +21,7 @@ void TestGatherCHW(bool is_rvv, std::vector<int> in_shape,
   std::vector<int> indices{indices_data, indices_data + num_indices};
 
   std::vector<float> output;
+  std::vector<int> out_shape;
 
   float* input_data = readFile(input_path, input_size);
   std::vector<float> input;
@@ -47,9 +48,11 @@ void TestGatherCHW(bool is_rvv, std::vector<int> in_shape,
 
   gettimeofday(&start, NULL);
   if (is_rvv) {
-    rvv::gather_chw(output, input, in_shape, indices, axis);
+    rvv::gather_chw(output, out_shape, input, in_shape, indices, indices_shape,
+                    axis);
   } else {
-    mem::gather_chw(output, input, in_shape, indices, axis);
+    mem::gather_chw(output, out_shape, input, in_shape, indices, indices_shape,
+                    axis);
   }
   gettimeofday(&end, NULL);
   float calculate_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
@@ -0,0 +1,49 @@
+#include <cstdlib>
+
+#include "gather_chw.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// 最后一维上的gather_chw（block_size == 1）：逐元素搬运（原实现的做法，每个输出
+// 元素一次拷贝）与小块内核（整行索引一次完成）的耗时对比
+float TestGatherCHWSmallBlock(bool is_rvv, std::vector<int> in_shape,
+                              int num_indices) {
+  std::vector<float> input(shape_numel(in_shape));
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  int axis = in_shape.size() - 1;
+  int dim = in_shape[axis];
+  std::vector<int> indices(num_indices);
+  srand(2024);
+  for (int i = 0; i < num_indices; ++i) {
+    indices[i] = rand() % dim;
+  }
+
+  struct timeval start, end;
+  size_t outer = input.size() / dim;
+  std::vector<float> expected(outer * num_indices);
+  gettimeofday(&start, NULL);
+  for (size_t o = 0; o < outer; ++o) {
+    for (int i = 0; i < num_indices; ++i) {
+      copy_elems(expected.data() + o * num_indices + i,
+                 input.data() + o * dim + indices[i], 1);
+    }
+  }
+  gettimeofday(&end, NULL);
+  float element_time_use = elapsed_ms(start, end);
+
+  std::vector<float> output(expected.size());
+  gettimeofday(&start, NULL);
+  int ret = is_rvv ? rvv::gather_chw(output, input, in_shape, indices, axis)
+                   : mem::gather_chw(output, input, in_shape, indices, axis);
+  gettimeofday(&end, NULL);
+  float kernel_time_use = elapsed_ms(start, end);
+
+  bool same = ret == 0 && output == expected;
+  printf("gather_chw last axis rank%zu,%d indices,%s,"
+         "per element %7.3f ms,small block %7.3f ms\n",
+         in_shape.size(), num_indices, same ? "ok" : "failed",
+         element_time_use, kernel_time_use);
+  return kernel_time_use;
+}
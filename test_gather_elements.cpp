@@ -0,0 +1,147 @@
+#include <cstdlib>
+
+#include "convert.h"
+#include "gather_elements.h"
+#include "op.h"
+#include "tensor_util.h"
+
+namespace {
+// CHW侧的标量GatherElements：输入视为[outer][D][inner]，输出视为[outer][Q][inner]
+void gather_elements_chw_ref(std::vector<float> &output,
+                             const std::vector<float> &input,
+                             const std::vector<int> &in_shape,
+                             const std::vector<int> &indices,
+                             const std::vector<int> &indices_shape, int axis) {
+  size_t outer = 1, inner = 1;
+  for (int i = 0; i < axis; ++i) {
+    outer *= in_shape[i];
+  }
+  for (size_t i = axis + 1; i < in_shape.size(); ++i) {
+    inner *= in_shape[i];
+  }
+  size_t D = in_shape[axis];
+  size_t Q = indices_shape[axis];
+  output.resize(outer * Q * inner);
+  for (size_t o = 0; o < outer; ++o) {
+    for (size_t q = 0; q < Q; ++q) {
+      for (size_t e = 0; e < inner; ++e) {
+        size_t off = (o * Q + q) * inner + e;
+        int idx = indices[off];
+        idx = idx >= 0 ? idx : idx + D;
+        output[off] = input[(o * D + idx) * inner + e];
+      }
+    }
+  }
+}
+
+// 分块HWC形状对应的CHW侧形状（5维按转换函数的LNCHW顺序，即N, D, C, H, W）
+std::vector<int> chw_shape_of(const std::vector<int> &shape_hwc) {
+  std::vector<int> shape(shape_hwc.begin(), shape_hwc.end() - 1);
+  shape.insert(shape.end() - 2, shape_hwc.back());
+  return shape;
+}
+
+// CHW编号的axis在chw_shape_of顺序中的位置
+int chw_axis_of(int axis_chw, int rank) {
+  if (rank != 5) {
+    return axis_chw;
+  }
+  return axis_chw == 1 ? 2 : (axis_chw == 2 ? 1 : axis_chw);
+}
+
+std::vector<float> to_chw(const std::vector<float> &x,
+                          const std::vector<int> &s, int align_channels) {
+  if (s.size() == 3) {
+    return convert_hwc_to_chw_3d(x, s[2], s[0], s[1], align_channels);
+  }
+  if (s.size() == 4) {
+    return convert_nhwc_to_nchw_4d(x, s[0], s[3], s[1], s[2], align_channels);
+  }
+  return convert_lnhwc_to_lnchw_5d(x, s[0], s[1], s[2], s[3], s[4],
+                                   align_channels);
+}
+
+std::vector<float> to_hwc(const std::vector<float> &x,
+                          const std::vector<int> &s, int align_channels) {
+  if (s.size() == 3) {
+    return convert_chw_to_hwc_3d(x, s[2], s[0], s[1], align_channels);
+  }
+  if (s.size() == 4) {
+    return convert_nchw_to_nhwc_4d(x, s[0], s[3], s[1], s[2], align_channels);
+  }
+  return convert_lnchw_to_lnhwc_5d(x, s[0], s[1], s[2], s[3], s[4],
+                                   align_channels);
+}
+} // namespace
+
+// GatherElements与"转换到CHW、标量循环、再转换回分块HWC"的耗时对比，
+// 输入数据和索引在内存中随机生成，索引同时生成分块HWC和CHW两种排布
+float TestGatherElementsHWC(bool is_rvv, std::vector<int> in_shape,
+                            int num_indices, int axis, int align_channels) {
+  int rank = in_shape.size();
+  int axis_hwc = chw_axis_to_hwc(axis, rank);
+  std::vector<int> indices_shape = in_shape;
+  indices_shape[axis_hwc] = num_indices;
+
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size, 0.0f);
+  int C = in_shape[rank - 1];
+  int64_t P = shape_numel(in_shape) / C;
+  for (int64_t p = 0; p < P; ++p) {
+    for (int c = 0; c < C; ++c) {
+      input[(c / align_channels * P + p) * align_channels +
+            c % align_channels] = static_cast<float>(rand()) / RAND_MAX;
+    }
+  }
+
+  // 按逻辑坐标生成索引，分别写入分块HWC位置和CHW位置
+  int out_C = indices_shape[rank - 1];
+  int64_t out_P = shape_numel(indices_shape) / out_C;
+  int64_t hw = static_cast<int64_t>(indices_shape[rank - 3]) *
+               indices_shape[rank - 2];
+  std::vector<int> indices_hwc(blocked_numel(indices_shape, align_channels), 0);
+  std::vector<int> indices_chw(shape_numel(indices_shape));
+  for (int64_t p = 0; p < out_P; ++p) {
+    for (int c = 0; c < out_C; ++c) {
+      int idx = rand() % in_shape[axis_hwc];
+      indices_hwc[(c / align_channels * out_P + p) * align_channels +
+                  c % align_channels] = idx;
+      indices_chw[(p / hw * out_C + c) * hw + p % hw] = idx;
+    }
+  }
+
+  struct timeval start, end;
+  std::vector<float> output;
+  gettimeofday(&start, NULL);
+  int ret;
+  if (is_rvv) {
+    ret = rvv::gather_elements_hwc(output, input, in_shape, indices_hwc,
+                                   indices_shape, axis, align_channels);
+  } else {
+    ret = mem::gather_elements_hwc(output, input, in_shape, indices_hwc,
+                                   indices_shape, axis, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float elements_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                             (end.tv_usec - start.tv_usec)) /
+                            1000.0 / 1.0;
+
+  gettimeofday(&start, NULL);
+  std::vector<float> chw = to_chw(input, in_shape, align_channels);
+  std::vector<float> chw_out;
+  gather_elements_chw_ref(chw_out, chw, chw_shape_of(in_shape), indices_chw,
+                          chw_shape_of(indices_shape), chw_axis_of(axis, rank));
+  std::vector<float> converted = to_hwc(chw_out, indices_shape, align_channels);
+  gettimeofday(&end, NULL);
+  float convert_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                            (end.tv_usec - start.tv_usec)) /
+                           1000.0 / 1.0;
+
+  bool same = ret == 0 && output == converted;
+  printf(
+      "gather_elements rank%d,axis_%d,indices %5d,channel_%2d,%s,"
+      "gather_elements %7.3f ms,convert route %7.3f ms\n",
+      rank, axis, num_indices, align_channels, same ? "ok" : "failed",
+      elements_time_use, convert_time_use);
+  return elements_time_use;
+}
@@ -0,0 +1,106 @@
+#include <thread>
+
+#include "convert.h"
+#include "gather.h"
+#include "gather_executor.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// num_clients个线程模拟并发的流水线阶段，每个阶段依次发出requests个gather
+// 请求（第i个阶段的特征图高宽为h、h/2、h/4循环，负载不均）和一个CHW到HWC的
+// convert请求。对比各阶段各自单线程调用与共用执行器（num_threads个工作线程，
+// 最多max_pending个未完成请求）的总耗时、结果，以及被窃取执行的tile数
+float TestGatherExecutor(int num_clients, int requests, int c, int h, int w,
+                         std::vector<int> indices, int axis,
+                         int align_channels, int num_threads,
+                         int max_pending) {
+  std::vector<std::vector<int>> shapes(num_clients);
+  std::vector<std::vector<float>> inputs(num_clients);
+  std::vector<float> chw(static_cast<size_t>(c) * h * w);
+  for (size_t i = 0; i < chw.size(); ++i) {
+    chw[i] = static_cast<float>(i % 1024);
+  }
+  for (int i = 0; i < num_clients; ++i) {
+    int scale = 1 << (i % 3);
+    shapes[i] = {std::max(h / scale, 1), std::max(w / scale, 1), c};
+    inputs[i].resize(blocked_numel(shapes[i], align_channels));
+    for (size_t k = 0; k < inputs[i].size(); ++k) {
+      inputs[i][k] = static_cast<float>((k + i) % 1024);
+    }
+  }
+
+  // 各阶段单线程、互不协调
+  std::vector<std::vector<std::vector<float>>> expected(
+      num_clients, std::vector<std::vector<float>>(requests));
+  std::vector<float> expected_hwc =
+      convert_chw_to_hwc_3d(chw, c, h, w, align_channels);
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  {
+    std::vector<std::thread> clients;
+    for (int i = 0; i < num_clients; ++i) {
+      clients.emplace_back([&, i]() {
+        for (int r = 0; r < requests; ++r) {
+          rvv::gather_hwc(expected[i][r], inputs[i], shapes[i], indices, axis,
+                          align_channels);
+        }
+        std::vector<float> hwc =
+            convert_chw_to_hwc_3d(chw, c, h, w, align_channels);
+      });
+    }
+    for (auto &t : clients) {
+      t.join();
+    }
+  }
+  gettimeofday(&end, NULL);
+  float direct_time_use = elapsed_ms(start, end);
+
+  // 共用执行器，每个阶段先提交全部请求再等待
+  std::vector<std::vector<std::vector<float>>> outputs(
+      num_clients, std::vector<std::vector<float>>(requests));
+  std::vector<std::vector<float>> converted(num_clients);
+  std::vector<int> failed(num_clients, 0);
+  GatherExecutor executor(num_threads, max_pending);
+  gettimeofday(&start, NULL);
+  {
+    std::vector<std::thread> clients;
+    for (int i = 0; i < num_clients; ++i) {
+      clients.emplace_back([&, i]() {
+        std::vector<std::future<int>> futures;
+        for (int r = 0; r < requests; ++r) {
+          GatherJob<float, float> job = {&outputs[i][r], &inputs[i], shapes[i],
+                                         indices, axis, align_channels};
+          futures.push_back(executor.submit_gather_hwc(job));
+        }
+        futures.push_back(executor.submit([&, i]() {
+          converted[i] = convert_chw_to_hwc_3d(chw, c, h, w, align_channels);
+          return 0;
+        }));
+        for (auto &f : futures) {
+          failed[i] += f.get() != 0;
+        }
+      });
+    }
+    for (auto &t : clients) {
+      t.join();
+    }
+  }
+  gettimeofday(&end, NULL);
+  float executor_time_use = elapsed_ms(start, end);
+
+  // 不切分任务的返回值原样作为future的结果
+  bool same = executor.submit([] { return 7; }).get() == 7 &&
+              executor.submit([] { return 0; }).get() == 0;
+  for (int i = 0; i < num_clients; ++i) {
+    same = same && failed[i] == 0 && outputs[i] == expected[i] &&
+           converted[i] == expected_hwc;
+  }
+  printf("executor %d clients x %d requests,%d_%d_%d,axis_%d,channel_%2d,%s,"
+         "%d threads,max pending %d,direct %7.3f ms,executor %7.3f ms,"
+         "%zu tiles (%zu stolen)\n",
+         num_clients, requests, c, h, w, axis, align_channels,
+         same ? "ok" : "failed", executor.num_threads(), max_pending,
+         direct_time_use, executor_time_use, executor.tiles_executed(),
+         executor.tiles_stolen());
+  return executor_time_use;
+}
@@ -0,0 +1,87 @@
+#include "gather.h"
+#include "op.h"
+#include "tensor_util.h"
+
+namespace {
+template <typename out_t, typename in_t>
+float time_gather_hwc(bool is_rvv, std::vector<out_t> &output,
+                      const std::vector<in_t> &input,
+                      const std::vector<int> &in_shape,
+                      const std::vector<int> &indices, int axis,
+                      int align_channels) {
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  if (is_rvv) {
+    rvv::gather_hwc<out_t, in_t>(output, input, in_shape, indices, axis,
+                                 align_channels);
+  } else {
+    mem::gather_hwc<out_t, in_t>(output, input, in_shape, indices, axis,
+                                 align_channels);
+  }
+  gettimeofday(&end, NULL);
+  return ((end.tv_sec - start.tv_sec) * 1000000.0 +
+          (end.tv_usec - start.tv_usec)) /
+         1000.0 / 1.0;
+}
+
+// 读output.size()个输入元素、写output.size()个输出元素的带宽，单位GB/s
+template <typename out_t, typename in_t>
+float gather_bandwidth(const std::vector<out_t> &output, float time_ms) {
+  double bytes = output.size() * (sizeof(out_t) + sizeof(in_t));
+  return time_ms > 0 ? bytes / (time_ms * 1e6) : 0.0f;
+}
+} // namespace
+
+// float32与16位存储（float16/bfloat16）的gather耗时和带宽对比，
+// 以及写出时融合精度转换（float16->float32、float32->float16）的耗时。
+// 16位输入由float32输入逐元素转换得到，结果转回float32后应与float32的gather一致
+float TestGatherHWCHalf(bool is_rvv, std::vector<int> in_shape,
+                        std::vector<int> indices, int axis,
+                        int align_channels) {
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    // 取float16和bfloat16都能精确表示的值，保证各路径结果可以逐位比较
+    input[i] = static_cast<float>(i % 256) / 16.0f;
+  }
+  std::vector<float16> input_f16(input_size);
+  std::vector<bfloat16> input_bf16(input_size);
+  copy_elems(input_f16.data(), input.data(), input_size);
+  copy_elems(input_bf16.data(), input.data(), input_size);
+
+  std::vector<float> out_f32;
+  std::vector<float16> out_f16;
+  std::vector<bfloat16> out_bf16;
+  std::vector<float> out_widen;
+  std::vector<float16> out_narrow;
+  float f32_time = time_gather_hwc(is_rvv, out_f32, input, in_shape, indices,
+                                   axis, align_channels);
+  float f16_time = time_gather_hwc(is_rvv, out_f16, input_f16, in_shape,
+                                   indices, axis, align_channels);
+  float bf16_time = time_gather_hwc(is_rvv, out_bf16, input_bf16, in_shape,
+                                    indices, axis, align_channels);
+  float widen_time = time_gather_hwc(is_rvv, out_widen, input_f16, in_shape,
+                                     indices, axis, align_channels);
+  float narrow_time = time_gather_hwc(is_rvv, out_narrow, input, in_shape,
+                                      indices, axis, align_channels);
+
+  size_t n = out_f32.size();
+  bool same = out_f16.size() == n && out_bf16.size() == n &&
+              out_widen == out_f32 && out_narrow.size() == n;
+  for (size_t i = 0; same && i < n; ++i) {
+    same = elem_cast<float>(out_f16[i]) == out_f32[i] &&
+           elem_cast<float>(out_bf16[i]) == out_f32[i] &&
+           out_narrow[i].bits == out_f16[i].bits;
+  }
+
+  printf(
+      "gather_hwc half rank%zu,axis_%d,channel_%2d,%s,"
+      "f32 %7.3f ms %6.2f GB/s,f16 %7.3f ms %6.2f GB/s,"
+      "bf16 %7.3f ms %6.2f GB/s,f16->f32 %7.3f ms,f32->f16 %7.3f ms\n",
+      in_shape.size(), axis, align_channels, same ? "ok" : "failed", f32_time,
+      gather_bandwidth<float, float>(out_f32, f32_time), f16_time,
+      gather_bandwidth<float16, float16>(out_f16, f16_time), bf16_time,
+      gather_bandwidth<bfloat16, bfloat16>(out_bf16, bf16_time), widen_time,
+      narrow_time);
+  return f16_time;
+}
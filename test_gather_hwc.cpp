@@ -0,0 +1,107 @@
+#include "gather.h"
+#include "op.h"
+#include "tensor_util.h"
+
+float TestGatherHWC(bool is_rvv, std::vector<int> in_shape,
+                    std::vector<int> indices_shape, const char* input_path,
+                    const char* indices_path, const char* output_path,
+                    int axis, int align_channels) {
+  size_t input_size = shape_numel(in_shape);
+  size_t num_indices = shape_numel(indices_shape);
+
+  struct timeval start, end;
+
+  int* indices_data = readFileINT(indices_path, num_indices);
+  std::vector<int> indices{indices_data, indices_data + num_indices};
+
+  std::vector<float> output;
+  std::vector<int> out_shape;
+
+  float* input_data_ptr = readFile(input_path, input_size);
+  std::vector<float> input_data{input_data_ptr, input_data_ptr + input_size};
+
+  gettimeofday(&start, NULL);
+  if (is_rvv) {
+    rvv::gather_hwc(output, out_shape, input_data, in_shape, indices,
+                    indices_shape, axis, align_channels);
+  } else {
+    mem::gather_hwc(output, out_shape, input_data, in_shape, indices,
+                    indices_shape, axis, align_channels);
+  }
+
+  gettimeofday(&end, NULL);
+  float calculate_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                              (end.tv_usec - start.tv_usec)) /
+                             1000.0 / 1.0;
+
+  outputFile_line(output_path, output);
+
+  float all_time = calculate_time_use;
+
+  if (in_shape.size() == 3) {
+    printf(
+        "input{%2d, %2d, %2d},axis{%d},channel_%2d,calculate %7.3f "
+        "ms,all_time %.3f ms\n",
+        in_shape[0], in_shape[1], in_shape[2], axis, align_channels,
+        calculate_time_use, all_time);
+  } else if (in_shape.size() == 4) {
+    printf(
+        "input{%2d, %2d, %2d, %2d},axis{%d},channel_%2d,calculate %7.3f "
+        "ms,all_time %.3f ms\n",
+        in_shape[0], in_shape[1], in_shape[2], in_shape[3], axis,
+        align_channels, calculate_time_use, all_time);
+  } else if (in_shape.size() == 5) {
+    printf(
+        "input{%2d, %2d, %2d, %2d, %2d},axis{%d},channel_%2d,calculate "
+        "%7.3f ms,all_time %.3f ms\n",
+        in_shape[0], in_shape[1], in_shape[2], in_shape[3], in_shape[4],
+        axis, align_channels, calculate_time_use, all_time);
+  }
+  printf("output shape{");
+  for (size_t i = 0; i < out_shape.size(); ++i) {
+    printf(i == 0 ? "%d" : ", %d", out_shape[i]);
+  }
+  printf("}\n");
+  return all_time;
+}
+
+// 大张量（可超过8 GiB）的gather耗时测试，输入数据直接在内存中生成，不读文件
+float TestGatherHWCLarge(bool is_rvv, std::vector<int> in_shape,
+                         std::vector<int> indices, int axis,
+                         int align_channels) {
+  std::vector<int> padded_shape = in_shape;
+  padded_shape.back() = padded_channels(in_shape.back(), align_channels);
+  size_t input_size = shape_numel(padded_shape);
+
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  std::vector<float> output;
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  int ret;
+  if (is_rvv) {
+    ret = rvv::gather_hwc(output, input, in_shape, indices, axis,
+                          align_channels);
+  } else {
+    ret = mem::gather_hwc(output, input, in_shape, indices, axis,
+                          align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float calculate_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                              (end.tv_usec - start.tv_usec)) /
+                             1000.0 / 1.0;
+
+  double in_gib = input_size * sizeof(float) / (1024.0 * 1024.0 * 1024.0);
+  double out_gib = output.size() * sizeof(float) / (1024.0 * 1024.0 * 1024.0);
+  printf(
+      "large rank%zu,axis{%d},channel_%2d,%s,input %.2f GiB,output %.2f "
+      "GiB,offset %s,calculate %9.3f ms,%.2f GiB/s\n",
+      in_shape.size(), axis, align_channels, ret == 0 ? "ok" : "failed",
+      in_gib, out_gib,
+      fits_int32(input_size) && fits_int32(output.size()) ? "int32" : "int64",
+      calculate_time_use, out_gib * 2 / (calculate_time_use / 1000.0));
+  return calculate_time_use;
+}
@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include "gather_incremental.h"
+#include "op.h"
+#include "tensor_util.h"
+
+namespace {
+// 改写分块HWC输入[cb][h][w][A]中沿dirty_axis（CHW编号，0为C、1为H）
+// 第[begin, end)个位置的数据
+void touch_input(std::vector<float> &input, int c, int h, int w,
+                 int align_channels, int dirty_axis, int begin, int end,
+                 float value) {
+  int A = align_channels;
+  int blocks = padded_channels(c, A) / A;
+  for (int cb = 0; cb < blocks; ++cb) {
+    for (int y = 0; y < h; ++y) {
+      for (int x = 0; x < w; ++x) {
+        for (int lane = 0; lane < A; ++lane) {
+          int ch = cb * A + lane;
+          int pos = dirty_axis == 0 ? ch : y;
+          if (ch < c && pos >= begin && pos < end) {
+            input[((static_cast<size_t>(cb) * h + y) * w + x) * A + lane] =
+                value;
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+// 每帧只有输入的一部分改变：dirty_axis为0时是前若干个通道块，为1时是
+// 顶部的H条带，比例从1/16到全部。对比每帧全量gather_hwc与增量更新的耗时
+// 和写入的输出元素数，并检查增量结果与全量结果一致
+float TestGatherIncremental(int c, int h, int w, std::vector<int> indices,
+                            int axis, int dirty_axis, int align_channels,
+                            int frames) {
+  std::vector<int> shape = {h, w, c};
+  std::vector<float> input(blocked_numel(shape, align_channels));
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  GatherPlan plan;
+  IncrementalGather<float, float> inc;
+  if (prepare_gather_hwc(plan, shape, indices, axis, align_channels) != 0 ||
+      inc.prepare(shape, indices, axis, align_channels) != 0 ||
+      inc.update(input) != 0) {
+    printf("incremental %d_%d_%d,axis_%d,failed\n", c, h, w, axis);
+    return 0;
+  }
+
+  int blocks = padded_channels(c, align_channels) / align_channels;
+  int extent = dirty_axis == 0 ? blocks : h;
+  float time_use = 0;
+  for (int parts = 16; parts >= 1; parts /= 2) {
+    int len = std::max(extent / parts, 1);
+    int end_pos = dirty_axis == 0 ? std::min(len * align_channels, c) : len;
+    std::vector<float> expected;
+    float full_time_use = 0, inc_time_use = 0;
+    double fraction = 0;
+    std::int64_t updated = 0;
+    bool same = true;
+    struct timeval start, end;
+    for (int f = 0; f < frames; ++f) {
+      touch_input(input, c, h, w, align_channels, dirty_axis, 0, end_pos,
+                  static_cast<float>(f * 16 + parts));
+      gettimeofday(&start, NULL);
+      rvv::gather_hwc(expected, input, plan);
+      gettimeofday(&end, NULL);
+      full_time_use += elapsed_ms(start, end);
+
+      gettimeofday(&start, NULL);
+      same = same && inc.mark_dirty(dirty_axis, 0, end_pos) == 0;
+      fraction = inc.dirty_fraction();
+      same = same && inc.update(input) == 0;
+      gettimeofday(&end, NULL);
+      inc_time_use += elapsed_ms(start, end);
+      updated = inc.last_updated();
+    }
+    same = same && inc.output() == expected;
+    time_use = inc_time_use / frames;
+    printf("incremental %d_%d_%d,axis_%d,channel_%2d,dirty %s %5.1f%%,%s,"
+           "updated %lld/%zu,full %7.3f ms,incremental %7.3f ms\n",
+           c, h, w, axis, align_channels, dirty_axis == 0 ? "blocks" : "rows",
+           fraction * 100, same ? "ok" : "failed",
+           static_cast<long long>(updated), expected.size(),
+           full_time_use / frames, time_use);
+  }
+  return time_use;
+}
@@ -0,0 +1,74 @@
+#include <cstdlib>
+
+#include "gather.h"
+#include "gather_nd.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// GatherND与"逐维链式gather_hwc"的耗时对比，输入数据和坐标元组在内存中随机生成
+// 链式做法对每个被索引维各调用一次gather_hwc，每次都生成完整的中间张量
+// （k=2时得到num_tuples x num_tuples个像素，再取对角线才是GatherND的结果）
+float TestGatherNDHWC(bool is_rvv, std::vector<int> in_shape, int num_tuples,
+                      int k, int align_channels) {
+  int rank = in_shape.size();
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(rand()) / RAND_MAX;
+  }
+
+  std::vector<int> indices(num_tuples * k);
+  std::vector<std::vector<int>> per_axis(k, std::vector<int>(num_tuples));
+  for (int t = 0; t < num_tuples; ++t) {
+    for (int j = 0; j < k; ++j) {
+      indices[t * k + j] = rand() % in_shape[j];
+      per_axis[j][t] = indices[t * k + j];
+    }
+  }
+
+  struct timeval start, end;
+  std::vector<float> output;
+  std::vector<int> out_shape;
+  gettimeofday(&start, NULL);
+  int ret;
+  if (is_rvv) {
+    ret = rvv::gather_nd_hwc(output, out_shape, input, in_shape, indices,
+                             {num_tuples, k}, align_channels);
+  } else {
+    ret = mem::gather_nd_hwc(output, out_shape, input, in_shape, indices,
+                             {num_tuples, k}, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float nd_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                       (end.tv_usec - start.tv_usec)) /
+                      1000.0 / 1.0;
+
+  gettimeofday(&start, NULL);
+  std::vector<float> chained = input;
+  std::vector<int> chained_shape = in_shape;
+  for (int j = 0; j < k; ++j) {
+    // HWC顺序的第j维对应的CHW编号axis
+    int axis_chw = rank == 3 ? j + 1 : (j == 0 ? 0 : j + 1);
+    std::vector<float> tmp;
+    if (is_rvv) {
+      rvv::gather_hwc(tmp, chained, chained_shape, per_axis[j], axis_chw,
+                      align_channels);
+    } else {
+      mem::gather_hwc(tmp, chained, chained_shape, per_axis[j], axis_chw,
+                      align_channels);
+    }
+    chained_shape[j] = num_tuples;
+    chained.swap(tmp);
+  }
+  gettimeofday(&end, NULL);
+  float chained_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                            (end.tv_usec - start.tv_usec)) /
+                           1000.0 / 1.0;
+
+  printf(
+      "gather_nd rank%d,tuples{%d, %d},channel_%2d,%s,gather_nd %7.3f "
+      "ms,chained gather_hwc %7.3f ms (%zu vs %zu floats written)\n",
+      rank, num_tuples, k, align_channels, ret == 0 ? "ok" : "failed",
+      nd_time_use, chained_time_use, output.size(), chained.size());
+  return nd_time_use;
+}
@@ -0,0 +1,69 @@
+#include "gather.h"
+#include "gather_numa.h"
+#include "op.h"
+#include "tensor.h"
+#include "tensor_util.h"
+
+// 对比1个节点与2个节点（实际节点不足时用numactl式的CPU均分模拟，只绑定
+// 线程不迁移内存）上按通道块划分的to_blocked_numa + gather_numa，
+// 与单线程to_blocked + rvv::gather的结果与耗时；输入分别按首次写入、
+// 通道块和交错三种方式放置。in_shape为平面排布的形状
+float TestGatherNuma(std::vector<int> in_shape, std::vector<int> indices,
+                     int axis, int align_channels, int threads_per_node,
+                     int repeat) {
+  std::vector<float> data(shape_numel(in_shape));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 1024);
+  }
+  Tensor<float> planar(data, in_shape);
+
+  struct timeval start, end;
+  Tensor<float> expected_blocked, expected;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    expected_blocked = to_blocked(planar, align_channels);
+    rvv::gather(expected, expected_blocked, indices, axis);
+  }
+  gettimeofday(&end, NULL);
+  float base_time_use = elapsed_ms(start, end) / repeat;
+
+  NumaTopology real;
+  numa_topology(real, 0);
+  const char *placement_names[] = {"first touch", "channel blocks",
+                                   "interleave"};
+  float time_use = base_time_use;
+  for (int nodes = 1; nodes <= 2; ++nodes) {
+    NumaTopology topo;
+    if (static_cast<int>(real.node_cpus.size()) == nodes) {
+      topo = real;
+    } else {
+      numa_topology(topo, nodes);
+    }
+    for (int p = kNumaFirstTouch; p <= kNumaInterleave; ++p) {
+      NumaPlacement placement = static_cast<NumaPlacement>(p);
+      Tensor<float> source(data, in_shape);
+      bool placed =
+          numa_place(source, topo, placement, align_channels) == 0;
+      Tensor<float> blocked, output;
+      bool same = true;
+      gettimeofday(&start, NULL);
+      for (int r = 0; r < repeat; ++r) {
+        blocked = to_blocked_numa(source, align_channels, topo,
+                                  threads_per_node);
+        same = same && rvv::gather_numa(output, blocked, indices, axis, topo,
+                                        threads_per_node) == 0;
+      }
+      gettimeofday(&end, NULL);
+      time_use = elapsed_ms(start, end) / repeat;
+      same = same && blocked.storage() == expected_blocked.storage() &&
+             output.storage() == expected.storage();
+      printf("numa %d node%s%s,rank%d,axis_%d,channel_%2d,%s,%s%s,"
+             "%d threads/node,baseline %7.3f ms,numa %7.3f ms\n",
+             nodes, nodes > 1 ? "s" : "", topo.simulated ? " (simulated)" : "",
+             planar.rank(), axis, align_channels, same ? "ok" : "failed",
+             placement_names[p], placed ? "" : " (not placed)",
+             threads_per_node, base_time_use, time_use);
+    }
+  }
+  return time_use;
+}
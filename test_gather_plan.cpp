@@ -0,0 +1,65 @@
+#include "gather.h"
+#include "gather_plan.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// 同一形状、axis和索引连续gather frames帧时，每帧调用gather_hwc与
+// 预先准备计划、每帧只执行计划的单次耗时对比（小张量上主要是调用开销）
+float TestGatherHWCPlan(bool is_rvv, std::vector<int> in_shape,
+                        std::vector<int> indices, int axis,
+                        int align_channels, int frames) {
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+
+  struct timeval start, end;
+  std::vector<float> output;
+  int ret = 0;
+  gettimeofday(&start, NULL);
+  for (int f = 0; f < frames; ++f) {
+    if (is_rvv) {
+      ret |= rvv::gather_hwc(output, input, in_shape, indices, axis,
+                             align_channels);
+    } else {
+      ret |= mem::gather_hwc(output, input, in_shape, indices, axis,
+                             align_channels);
+    }
+  }
+  gettimeofday(&end, NULL);
+  float direct_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                           (end.tv_usec - start.tv_usec)) /
+                          frames;
+
+  GatherPlan plan;
+  gettimeofday(&start, NULL);
+  ret |= prepare_gather_hwc(plan, in_shape, indices, axis, align_channels);
+  gettimeofday(&end, NULL);
+  float prepare_time_use = (end.tv_sec - start.tv_sec) * 1000000.0 +
+                           (end.tv_usec - start.tv_usec);
+
+  std::vector<float> planned;
+  gettimeofday(&start, NULL);
+  for (int f = 0; f < frames; ++f) {
+    if (is_rvv) {
+      ret |= rvv::gather_hwc(planned, input, plan);
+    } else {
+      ret |= mem::gather_hwc(planned, input, plan);
+    }
+  }
+  gettimeofday(&end, NULL);
+  float plan_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                         (end.tv_usec - start.tv_usec)) /
+                        frames;
+
+  bool same = ret == 0 && planned == output;
+  printf(
+      "gather_hwc plan rank%zu,axis_%d,indices %3zu,channel_%2d,%s,"
+      "direct %8.3f us/frame,prepare %8.3f us,execute %8.3f us/frame,"
+      "%zu runs\n",
+      in_shape.size(), axis, indices.size(), align_channels,
+      same ? "ok" : "failed", direct_time_use, prepare_time_use,
+      plan_time_use, plan.runs.size());
+  return plan_time_use;
+}
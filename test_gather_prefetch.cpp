@@ -0,0 +1,52 @@
+#include <cstdlib>
+#include <string>
+
+#include "gather.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// 随机索引下gather_hwc与带软件预取的gather_hwc_prefetch的耗时对比，
+// 依次测试自动选择的预取距离和固定距离1/2/4/8/16，返回最快的预取耗时
+float TestGatherHWCPrefetch(std::vector<int> in_shape, int num_indices,
+                            int axis, int align_channels) {
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  int dim = in_shape[chw_axis_to_hwc(axis, in_shape.size())];
+  std::vector<int> indices(num_indices);
+  srand(2024);
+  for (int i = 0; i < num_indices; ++i) {
+    indices[i] = rand() % dim;
+  }
+
+  struct timeval start, end;
+  std::vector<float> expected;
+  gettimeofday(&start, NULL);
+  int ret = rvv::gather_hwc(expected, input, in_shape, indices, axis,
+                            align_channels);
+  gettimeofday(&end, NULL);
+  float base_time_use = elapsed_ms(start, end);
+  printf("gather_hwc prefetch rank%zu,axis_%d,channel_%2d,%d indices,"
+         "no prefetch %7.3f ms\n",
+         in_shape.size(), axis, align_channels, num_indices, base_time_use);
+
+  float best_time_use = -1.0f;
+  for (int distance : {0, 1, 2, 4, 8, 16}) {
+    std::vector<float> output;
+    gettimeofday(&start, NULL);
+    int r = rvv::gather_hwc_prefetch(output, input, in_shape, indices, axis,
+                                     align_channels, distance);
+    gettimeofday(&end, NULL);
+    float time_use = elapsed_ms(start, end);
+    bool same = ret == 0 && r == 0 && output == expected;
+    printf("  distance %-4s %s,%7.3f ms\n",
+           distance > 0 ? std::to_string(distance).c_str() : "auto",
+           same ? "ok" : "failed", time_use);
+    if (best_time_use < 0 || time_use < best_time_use) {
+      best_time_use = time_use;
+    }
+  }
+  return best_time_use;
+}
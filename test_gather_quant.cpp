@@ -0,0 +1,96 @@
+#include <cstdlib>
+
+#include "gather.h"
+#include "gather_quant.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// int8逐通道量化张量的gather与"先反量化成float32再gather"的耗时对比，
+// 输入在内存中随机生成（分块HWC布局，补零通道为0），
+// 反量化gather结果后应与float32的gather逐位一致
+float TestGatherHWCQuant(bool is_rvv, std::vector<int> in_shape,
+                         std::vector<int> indices, int axis,
+                         int align_channels) {
+  int rank = in_shape.size();
+  int C = in_shape[rank - 1];
+  QuantParams in_params;
+  in_params.axis = rank == 3 ? 0 : 1;
+  for (int c = 0; c < C; ++c) {
+    in_params.scales.push_back(0.01f * (c % 7 + 1));
+    in_params.zero_points.push_back(c % 5 - 2);
+  }
+
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<std::int8_t> input(input_size, 0);
+  int64_t P = shape_numel(in_shape) / C;
+  for (int64_t p = 0; p < P; ++p) {
+    for (int c = 0; c < C; ++c) {
+      input[(c / align_channels * P + p) * align_channels +
+            c % align_channels] = rand() % 256 - 128;
+    }
+  }
+
+  struct timeval start, end;
+  std::vector<std::int8_t> output;
+  QuantParams out_params;
+  gettimeofday(&start, NULL);
+  int ret;
+  if (is_rvv) {
+    ret = rvv::gather_hwc_quant(output, out_params, input, in_params, in_shape,
+                                indices, axis, align_channels);
+  } else {
+    ret = mem::gather_hwc_quant(output, out_params, input, in_params, in_shape,
+                                indices, axis, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float quant_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                          (end.tv_usec - start.tv_usec)) /
+                         1000.0 / 1.0;
+
+  // 对比路径：整张量反量化（计入耗时）后做float32的gather
+  gettimeofday(&start, NULL);
+  std::vector<float> dequant(input_size, 0.0f);
+  for (int64_t p = 0; p < P; ++p) {
+    for (int c = 0; c < C; ++c) {
+      size_t off = (c / align_channels * P + p) * align_channels +
+                   c % align_channels;
+      dequant[off] = (input[off] - in_params.zero_points[c]) *
+                     in_params.scales[c];
+    }
+  }
+  std::vector<float> output_f32;
+  if (is_rvv) {
+    rvv::gather_hwc(output_f32, dequant, in_shape, indices, axis,
+                    align_channels);
+  } else {
+    mem::gather_hwc(output_f32, dequant, in_shape, indices, axis,
+                    align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float float_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                          (end.tv_usec - start.tv_usec)) /
+                         1000.0 / 1.0;
+
+  // 用输出的量化参数反量化gather结果，检查参数是否随通道一起搬运
+  int out_C = chw_axis_to_hwc(axis, rank) == rank - 1 ? indices.size() : C;
+  int64_t out_P = output_f32.size() / padded_channels(out_C, align_channels);
+  bool same = ret == 0 && output.size() == output_f32.size() &&
+              out_params.scales.size() == static_cast<size_t>(out_C);
+  for (int64_t p = 0; same && p < out_P; ++p) {
+    for (int c = 0; same && c < out_C; ++c) {
+      size_t off = (c / align_channels * out_P + p) * align_channels +
+                   c % align_channels;
+      same = (output[off] - out_params.zero_points[c]) *
+                 out_params.scales[c] ==
+             output_f32[off];
+    }
+  }
+
+  printf(
+      "gather_hwc int8 rank%d,axis_%d,channel_%2d,%s,"
+      "int8 %7.3f ms (%zu bytes),dequant+f32 %7.3f ms (%zu bytes)\n",
+      rank, axis, align_channels, same ? "ok" : "failed", quant_time_use,
+      output.size() * sizeof(std::int8_t), float_time_use,
+      output_f32.size() * sizeof(float));
+  return quant_time_use;
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <deque>
+
+#include "gather.h"
+#include "gather_ring.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// 每步到来一帧分块NHWC特征图（n, c, h, w），在最近capacity帧的窗口上沿L维
+// 按indices（相对窗口，负数从最新一帧倒数）取帧。对比每步按时间顺序重建
+// 连续5D张量后gather_hwc，与环形窗口原地追加后gather_ring的结果与耗时
+float TestGatherRing(int n, int c, int h, int w, int capacity,
+                     std::vector<int> indices, int align_channels, int steps) {
+  std::vector<int> frame_shape = {n, h, w, c};
+  std::int64_t frame_numel = blocked_numel(frame_shape, align_channels);
+  int num_blocks = padded_channels(c, align_channels) / align_channels;
+  std::int64_t block_numel = frame_numel / num_blocks;
+  std::vector<AlignedVector<float>> frames(steps);
+  for (int s = 0; s < steps; ++s) {
+    frames[s].resize(frame_numel);
+    for (std::int64_t i = 0; i < frame_numel; ++i) {
+      frames[s][i] = static_cast<float>((i + s * 7) % 1024);
+    }
+  }
+
+  // 每步重建连续窗口
+  std::deque<const AlignedVector<float> *> window;
+  std::vector<AlignedVector<float>> expected(steps);
+  AlignedVector<float> contiguous;
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (int s = 0; s < steps; ++s) {
+    window.push_back(&frames[s]);
+    if (static_cast<int>(window.size()) > capacity) {
+      window.pop_front();
+    }
+    int L = window.size();
+    contiguous.resize(frame_numel * L);
+    for (int cb = 0; cb < num_blocks; ++cb) {
+      for (int l = 0; l < L; ++l) {
+        std::copy(window[l]->begin() + cb * block_numel,
+                  window[l]->begin() + (cb + 1) * block_numel,
+                  contiguous.begin() + (cb * L + l) * block_numel);
+      }
+    }
+    if (L == capacity) {
+      rvv::gather_hwc(expected[s], contiguous, {L, n, h, w, c}, indices, 0,
+                      align_channels);
+    }
+  }
+  gettimeofday(&end, NULL);
+  float rebuild_time_use = elapsed_ms(start, end);
+
+  // 环形窗口
+  FrameRing<float> ring(frame_shape, capacity, align_channels);
+  std::vector<AlignedVector<float>> outputs(steps);
+  bool same = true;
+  gettimeofday(&start, NULL);
+  for (int s = 0; s < steps; ++s) {
+    same = same && ring.push(frames[s]) == 0;
+    if (ring.size() == capacity) {
+      same = same && rvv::gather_ring(outputs[s], ring, indices) == 0;
+    }
+  }
+  gettimeofday(&end, NULL);
+  float ring_time_use = elapsed_ms(start, end);
+  same = same && outputs == expected;
+
+  printf("ring %d_%d_%d_%d,window %d,%zu indices,channel_%2d,%s,%d steps,"
+         "rebuild %7.3f ms,ring %7.3f ms\n",
+         n, c, h, w, capacity, indices.size(), align_channels,
+         same ? "ok" : "failed", steps, rebuild_time_use, ring_time_use);
+  return ring_time_use;
+}
@@ -0,0 +1,52 @@
+#include "gather.h"
+#include "gather_tune.h"
+#include "op.h"
+#include "tensor_util.h"
+
+namespace {
+float time_gather(std::vector<float> &output, const std::vector<float> &input,
+                  const std::vector<int> &in_shape,
+                  const std::vector<int> &indices, int axis,
+                  int align_channels, int repeat) {
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (int k = 0; k < repeat; ++k) {
+    rvv::gather_hwc(output, input, in_shape, indices, axis, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  return ((end.tv_sec - start.tv_sec) * 1000000.0 +
+          (end.tv_usec - start.tv_usec)) /
+         1000.0 / repeat;
+}
+} // namespace
+
+// 离线调优并写入path，清空缓存后重新加载，对比无缓存和加载缓存后
+// rvv::gather_hwc的耗时与结果。tune_repeat为调优时每次测量的重复次数
+float TestGatherTune(const char *path, std::vector<int> in_shape,
+                     std::vector<int> indices, int axis, int align_channels,
+                     int tune_repeat, int repeat) {
+  printf("gather tune cpu %s\n", gather_tune_cpu_signature().c_str());
+  gather_tune_clear();
+  int count = gather_tune_all(path, tune_repeat, true);
+  printf("gather tune %d entries written to %s\n", count, path);
+
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  gather_tune_clear();
+  std::vector<float> default_output, tuned_output;
+  float default_time_use = time_gather(default_output, input, in_shape,
+                                       indices, axis, align_channels, repeat);
+
+  int ret = gather_tune_load(path);
+  float tuned_time_use = time_gather(tuned_output, input, in_shape, indices,
+                                     axis, align_channels, repeat);
+  bool same = count > 0 && ret == 0 && default_output == tuned_output;
+  printf("gather_hwc tune cache rank%zu,axis_%d,channel_%2d,%s,"
+         "default %7.3f ms,cached %7.3f ms\n",
+         in_shape.size(), axis, align_channels, same ? "ok" : "failed",
+         default_time_use, tuned_time_use);
+  return tuned_time_use;
+}
@@ -0,0 +1,87 @@
+#include "convert.h"
+#include "gather.h"
+#include "gather_view.h"
+#include "op.h"
+#include "tensor_util.h"
+
+namespace {
+// 按维数调用分块HWC到CHW的转换
+std::vector<float> hwc_to_chw(const std::vector<float> &input,
+                              const std::vector<int> &shape_hwc,
+                              int align_channels) {
+  const std::vector<int> &s = shape_hwc;
+  if (s.size() == 3) {
+    return convert_hwc_to_chw_3d(input, s[2], s[0], s[1], align_channels);
+  }
+  if (s.size() == 4) {
+    return convert_nhwc_to_nchw_4d(input, s[0], s[3], s[1], s[2],
+                                   align_channels);
+  }
+  return convert_lnhwc_to_lnchw_5d(input, s[0], s[1], s[2], s[3], s[4],
+                                   align_channels);
+}
+} // namespace
+
+// gather_hwc写出结果与创建视图后按需读出的耗时对比，
+// 以及gather后再转换为CHW与直接从视图转换（不写中间张量）的耗时对比
+float TestGatherHWCView(bool is_rvv, std::vector<int> in_shape,
+                        std::vector<int> indices, int axis,
+                        int align_channels) {
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  int C = in_shape.back();
+  size_t P = input_size / padded_channels(C, align_channels);
+  for (size_t i = 0; i < input_size; ++i) {
+    int c = i / (P * align_channels) * align_channels + i % align_channels;
+    input[i] = c < C ? static_cast<float>(i % 1024) : 0.0f;
+  }
+
+  struct timeval start, end;
+  int ret = 0;
+  std::vector<float> gathered;
+  std::vector<int> out_shape = in_shape;
+  out_shape[chw_axis_to_hwc(axis, in_shape.size())] = indices.size();
+  gettimeofday(&start, NULL);
+  if (is_rvv) {
+    ret |= rvv::gather_hwc(gathered, input, in_shape, indices, axis,
+                           align_channels);
+  } else {
+    ret |= mem::gather_hwc(gathered, input, in_shape, indices, axis,
+                           align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float gather_time_use = elapsed_ms(start, end);
+
+  GatherView<float> view;
+  std::vector<float> materialized;
+  gettimeofday(&start, NULL);
+  ret |= gather_hwc_view(view, input, in_shape, indices, axis, align_channels);
+  if (is_rvv) {
+    ret |= rvv::materialize(materialized, view);
+  } else {
+    ret |= mem::materialize(materialized, view);
+  }
+  gettimeofday(&end, NULL);
+  float view_time_use = elapsed_ms(start, end);
+
+  gettimeofday(&start, NULL);
+  std::vector<float> converted = hwc_to_chw(gathered, out_shape, align_channels);
+  gettimeofday(&end, NULL);
+  float convert_time_use = elapsed_ms(start, end) + gather_time_use;
+
+  gettimeofday(&start, NULL);
+  std::vector<float> view_converted = convert_hwc_to_chw(view);
+  gettimeofday(&end, NULL);
+  float view_convert_time_use = elapsed_ms(start, end);
+
+  bool same = ret == 0 && materialized == gathered &&
+              view.shape == out_shape && view_converted == converted;
+  printf(
+      "gather_hwc view rank%zu,axis_%d,channel_%2d,%s,"
+      "gather %7.3f ms,view+materialize %7.3f ms,"
+      "gather+convert %7.3f ms,view convert %7.3f ms\n",
+      in_shape.size(), axis, align_channels, same ? "ok" : "failed",
+      gather_time_use, view_time_use, convert_time_use,
+      view_convert_time_use);
+  return view_time_use;
+}
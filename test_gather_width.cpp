@@ -0,0 +1,47 @@
+#include "gather.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// W轴gather的逐像素开销：rvv（展平外层循环、合并连续索引、小像素索引加载）与
+// mem版本各重复repeat次，输出每个输出像素（align_channels个元素）的平均耗时
+float TestGatherHWCWidth(std::vector<int> in_shape, std::vector<int> indices,
+                         int align_channels, int repeat) {
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  int rank = in_shape.size();
+  int axis = rank - 1; // CHW编号中W总是最后一维
+  double pixels = gather_hwc_out_numel(in_shape, indices.size(), axis,
+                                       align_channels) /
+                  static_cast<double>(align_channels);
+
+  struct timeval start, end;
+  int ret = 0;
+  std::vector<float> rvv_output, mem_output;
+  gettimeofday(&start, NULL);
+  for (int k = 0; k < repeat; ++k) {
+    ret |= rvv::gather_hwc(rvv_output, input, in_shape, indices, axis,
+                           align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float rvv_time_use = elapsed_ms(start, end) / repeat;
+
+  gettimeofday(&start, NULL);
+  for (int k = 0; k < repeat; ++k) {
+    ret |= mem::gather_hwc(mem_output, input, in_shape, indices, axis,
+                           align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float mem_time_use = elapsed_ms(start, end) / repeat;
+
+  bool same = ret == 0 && rvv_output == mem_output;
+  printf(
+      "gather_hwc W axis rank%d,%zu indices,channel_%2d,%s,"
+      "rvv %7.3f ms (%6.1f ns/pixel),mem %7.3f ms (%6.1f ns/pixel)\n",
+      rank, indices.size(), align_channels, same ? "ok" : "failed",
+      rvv_time_use, rvv_time_use * 1e6 / pixels, mem_time_use,
+      mem_time_use * 1e6 / pixels);
+  return rvv_time_use;
+}
@@ -0,0 +1,74 @@
+#include "gather.h"
+#include "op.h"
+#include "rvv_tune.h"
+#include "tensor_util.h"
+
+namespace {
+float time_gather(std::vector<float> &output, const std::vector<float> &input,
+                  const std::vector<int> &in_shape,
+                  const std::vector<int> &indices, int axis,
+                  int align_channels, int repeat) {
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (int k = 0; k < repeat; ++k) {
+    rvv::gather_hwc(output, input, in_shape, indices, axis, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  return ((end.tv_sec - start.tv_sec) * 1000000.0 +
+          (end.tv_usec - start.tv_usec)) /
+         1000.0 / repeat;
+}
+} // namespace
+
+// 全部为m8（原行为）、按VLEN的默认LMUL与rvv_autotune之后rvv::gather_hwc的
+// 耗时对比，同时打印调优过程中各档各LMUL的实测耗时
+float TestRvvTune(std::vector<int> in_shape, std::vector<int> indices,
+                  int axis, int align_channels, int repeat) {
+  size_t input_size = blocked_numel(in_shape, align_channels);
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  for (int kind = 0; kind < kRvvCopyKinds; ++kind) {
+    for (int c = 0; c < kRvvSizeClasses; ++c) {
+      rvv_set_lmul(static_cast<RvvCopyKind>(kind), c, 8);
+    }
+  }
+  std::vector<float> m8_output, tuned_output;
+  float m8_time_use = time_gather(m8_output, input, in_shape, indices, axis,
+                                  align_channels, repeat);
+
+  rvv_reset_lmul();
+  std::vector<float> default_output;
+  float default_time_use = time_gather(default_output, input, in_shape,
+                                       indices, axis, align_channels, repeat);
+
+  rvv_autotune(200, true);
+  float tuned_time_use = time_gather(tuned_output, input, in_shape, indices,
+                                     axis, align_channels, repeat);
+
+  bool same = m8_output == tuned_output && m8_output == default_output;
+  printf("gather_hwc lmul rank%zu,axis_%d,channel_%2d,VLEN %zu,%s,"
+         "m8 %7.3f ms,default %7.3f ms,tuned %7.3f ms\n",
+         in_shape.size(), axis, align_channels, rvv_vlenb() * 8,
+         same ? "ok" : "failed", m8_time_use, default_time_use,
+         tuned_time_use);
+  return tuned_time_use;
+}
+
+// 打印运行时读到的VLEN和据此选出的默认LMUL表、索引加载的像素上限，
+// 在qemu下用-cpu rv64,v=true,vlen=128/256/512分别运行即可检查选择逻辑
+void TestRvvVlen() {
+  rvv_reset_lmul();
+  printf("VLEN %zu,indexed pixel <= %zu elements\n", rvv_vlenb() * 8,
+         rvv_indexed_max_pixel());
+  const char *names[kRvvCopyKinds] = {"contiguous", "strided"};
+  for (int kind = 0; kind < kRvvCopyKinds; ++kind) {
+    printf("  %-10s lmul:", names[kind]);
+    for (int c = 0; c < kRvvSizeClasses; ++c) {
+      printf(" m%d", rvv_default_lmul(static_cast<RvvCopyKind>(kind), c,
+                                      rvv_vlenb()));
+    }
+    printf("\n");
+  }
+}
@@ -0,0 +1,72 @@
+#include <cstdlib>
+
+#include "op.h"
+#include "scatter_add.h"
+#include "tensor_util.h"
+
+// 并行scatter-add（gather的反向）在1到max_threads个线程下的耗时，
+// 索引随机生成（num_indices大于axis维长度时必有重复），
+// 并检查各线程数下的结果与单线程逐位一致
+float TestScatterAdd(bool is_rvv, bool is_hwc, std::vector<int> in_shape,
+                     int num_indices, int axis, int align_channels,
+                     int max_threads) {
+  int rank = in_shape.size();
+  int axis_dim = is_hwc ? in_shape[chw_axis_to_hwc(axis, rank)]
+                        : in_shape[axis];
+  std::vector<int> indices(num_indices);
+  for (int i = 0; i < num_indices; ++i) {
+    indices[i] = rand() % axis_dim;
+  }
+
+  size_t in_size, out_size;
+  if (is_hwc) {
+    in_size = blocked_numel(in_shape, align_channels);
+    out_size =
+        gather_hwc_out_numel(in_shape, num_indices, axis, align_channels);
+  } else {
+    in_size = shape_numel(in_shape);
+    out_size = in_size / axis_dim * num_indices;
+  }
+  std::vector<float> grad_output(out_size);
+  for (size_t i = 0; i < out_size; ++i) {
+    grad_output[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+  }
+
+  std::vector<float> reference;
+  float single_time_use = 0;
+  bool same = true;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    std::vector<float> grad_input(in_size, 0.0f);
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    int ret;
+    if (is_hwc) {
+      ret = is_rvv ? rvv::scatter_add_hwc(grad_input, in_shape, grad_output,
+                                          indices, axis, align_channels,
+                                          threads)
+                   : mem::scatter_add_hwc(grad_input, in_shape, grad_output,
+                                          indices, axis, align_channels,
+                                          threads);
+    } else {
+      ret = is_rvv ? rvv::scatter_add_chw(grad_input, in_shape, grad_output,
+                                          indices, axis, threads)
+                   : mem::scatter_add_chw(grad_input, in_shape, grad_output,
+                                          indices, axis, threads);
+    }
+    gettimeofday(&end, NULL);
+    float time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                      (end.tv_usec - start.tv_usec)) /
+                     1000.0 / 1.0;
+    if (threads == 1) {
+      reference = grad_input;
+      single_time_use = time_use;
+    }
+    same = same && ret == 0 && grad_input == reference;
+    printf(
+        "scatter_add %s rank%d,axis_%d,indices %5d,threads %2d,%s,%7.3f ms,"
+        "speedup %5.2fx\n",
+        is_hwc ? "hwc" : "chw", rank, axis, num_indices, threads,
+        same ? "ok" : "failed", time_use, single_time_use / time_use);
+  }
+  return single_time_use;
+}
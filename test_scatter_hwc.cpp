@@ -0,0 +1,164 @@
+#include <cstdlib>
+#include <cstring>
+
+#include "gather_elements.h"
+#include "gather_nd.h"
+#include "op.h"
+#include "tensor_util.h"
+
+// ScatterND原地写回的耗时，与整块拷贝data（非原地实现至少要付出的代价）对比；
+// 元组互不重复，写回后再用gather_nd_hwc取出，检查与updates一致
+float TestScatterNDHWC(bool is_rvv, std::vector<int> data_shape,
+                       int num_tuples, int k, int align_channels) {
+  int rank = data_shape.size();
+  size_t data_size = blocked_numel(data_shape, align_channels);
+  std::vector<float> data(data_size);
+  for (size_t i = 0; i < data_size; ++i) {
+    data[i] = static_cast<float>(rand()) / RAND_MAX;
+  }
+
+  // 从全部切片中不重复地抽取num_tuples个，再拆成坐标元组
+  int64_t num_slices = 1;
+  for (int j = 0; j < k; ++j) {
+    num_slices *= data_shape[j];
+  }
+  if (num_tuples > num_slices) {
+    num_tuples = num_slices;
+  }
+  std::vector<int64_t> pool(num_slices);
+  for (int64_t i = 0; i < num_slices; ++i) {
+    pool[i] = i;
+  }
+  std::vector<int> indices(num_tuples * k);
+  for (int t = 0; t < num_tuples; ++t) {
+    std::swap(pool[t], pool[t + rand() % (num_slices - t)]);
+    int64_t slice = pool[t];
+    for (int j = k - 1; j >= 0; --j) {
+      indices[t * k + j] = slice % data_shape[j];
+      slice /= data_shape[j];
+    }
+  }
+
+  std::vector<int> updates_shape = {num_tuples};
+  updates_shape.insert(updates_shape.end(), data_shape.begin() + k,
+                       data_shape.end());
+  std::vector<float> updates(blocked_numel(updates_shape, align_channels));
+  for (size_t i = 0; i < updates.size(); ++i) {
+    updates[i] = static_cast<float>(rand()) / RAND_MAX;
+  }
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  int ret;
+  if (is_rvv) {
+    ret = rvv::scatter_nd_hwc(data, data_shape, indices, {num_tuples, k},
+                              updates, align_channels);
+  } else {
+    ret = mem::scatter_nd_hwc(data, data_shape, indices, {num_tuples, k},
+                              updates, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float scatter_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                            (end.tv_usec - start.tv_usec)) /
+                           1000.0 / 1.0;
+
+  gettimeofday(&start, NULL);
+  std::vector<float> copy(data_size);
+  std::memcpy(copy.data(), data.data(), data_size * sizeof(float));
+  gettimeofday(&end, NULL);
+  float copy_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                         (end.tv_usec - start.tv_usec)) /
+                        1000.0 / 1.0;
+
+  std::vector<float> gathered;
+  std::vector<int> gathered_shape;
+  mem::gather_nd_hwc(gathered, gathered_shape, data, data_shape, indices,
+                     {num_tuples, k}, align_channels);
+  bool same = ret == 0 && gathered == updates;
+  printf(
+      "scatter_nd rank%d,tuples{%d, %d},channel_%2d,%s,scatter_nd %7.3f "
+      "ms,full copy %7.3f ms\n",
+      rank, num_tuples, k, align_channels, same ? "ok" : "failed",
+      scatter_time_use, copy_time_use);
+  return scatter_time_use;
+}
+
+// ScatterElements原地写回的耗时，与整块拷贝data对比；
+// 沿axis的索引为(q + shift) % D，num_indices不超过D时同一条纤维上互不重复，写回后用
+// gather_elements_hwc取出，检查与updates一致
+float TestScatterElementsHWC(bool is_rvv, std::vector<int> data_shape,
+                             int num_indices, int axis, int align_channels) {
+  int rank = data_shape.size();
+  int axis_hwc = chw_axis_to_hwc(axis, rank);
+  std::vector<int> indices_shape = data_shape;
+  indices_shape[axis_hwc] = num_indices;
+  int D = data_shape[axis_hwc];
+  int shift = rand() % D;
+
+  size_t data_size = blocked_numel(data_shape, align_channels);
+  std::vector<float> data(data_size, 0.0f);
+  int C = data_shape[rank - 1];
+  int64_t P = shape_numel(data_shape) / C;
+  for (int64_t p = 0; p < P; ++p) {
+    for (int c = 0; c < C; ++c) {
+      data[(c / align_channels * P + p) * align_channels +
+           c % align_channels] = static_cast<float>(rand()) / RAND_MAX;
+    }
+  }
+
+  // 按逻辑坐标生成索引和更新值，补零通道保持为0
+  int upd_C = indices_shape[rank - 1];
+  int64_t upd_P = shape_numel(indices_shape) / upd_C;
+  int64_t axis_stride = 1;
+  for (int i = axis_hwc + 1; i < rank - 1; ++i) {
+    axis_stride *= indices_shape[i];
+  }
+  size_t indices_size = blocked_numel(indices_shape, align_channels);
+  std::vector<int> indices(indices_size, 0);
+  std::vector<float> updates(indices_size, 0.0f);
+  for (int64_t p = 0; p < upd_P; ++p) {
+    for (int c = 0; c < upd_C; ++c) {
+      int q = axis_hwc == rank - 1
+                  ? c
+                  : p / axis_stride % indices_shape[axis_hwc];
+      size_t off = (c / align_channels * upd_P + p) * align_channels +
+                   c % align_channels;
+      indices[off] = (q + shift) % D;
+      updates[off] = static_cast<float>(rand()) / RAND_MAX;
+    }
+  }
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  int ret;
+  if (is_rvv) {
+    ret = rvv::scatter_elements_hwc(data, data_shape, indices, indices_shape,
+                                    updates, axis, align_channels);
+  } else {
+    ret = mem::scatter_elements_hwc(data, data_shape, indices, indices_shape,
+                                    updates, axis, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float scatter_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                            (end.tv_usec - start.tv_usec)) /
+                           1000.0 / 1.0;
+
+  gettimeofday(&start, NULL);
+  std::vector<float> copy(data_size);
+  std::memcpy(copy.data(), data.data(), data_size * sizeof(float));
+  gettimeofday(&end, NULL);
+  float copy_time_use = ((end.tv_sec - start.tv_sec) * 1000000.0 +
+                         (end.tv_usec - start.tv_usec)) /
+                        1000.0 / 1.0;
+
+  std::vector<float> gathered;
+  mem::gather_elements_hwc(gathered, data, data_shape, indices, indices_shape,
+                           axis, align_channels);
+  bool same = ret == 0 && gathered == updates;
+  printf(
+      "scatter_elements rank%d,axis_%d,indices %5d,channel_%2d,%s,"
+      "scatter_elements %7.3f ms,full copy %7.3f ms\n",
+      rank, axis, num_indices, align_channels, same ? "ok" : "failed",
+      scatter_time_use, copy_time_use);
+  return scatter_time_use;
+}
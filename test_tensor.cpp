@@ -0,0 +1,106 @@
+#include "convert.h"
+#include "gather.h"
+#include "op.h"
+#include "tensor.h"
+#include "tensor_util.h"
+
+namespace {
+// 按维数调用转换（形状为HWC顺序），模拟只拿到裸数据、不确定排布的调用者
+AlignedVector<float> hwc_to_chw(const AlignedVector<float> &x,
+                                const std::vector<int> &s,
+                                int align_channels) {
+  if (s.size() == 3) {
+    return convert_hwc_to_chw_3d(x, s[2], s[0], s[1], align_channels);
+  }
+  if (s.size() == 4) {
+    return convert_nhwc_to_nchw_4d(x, s[0], s[3], s[1], s[2], align_channels);
+  }
+  return convert_lnhwc_to_lnchw_5d(x, s[0], s[1], s[2], s[3], s[4],
+                                   align_channels);
+}
+
+AlignedVector<float> chw_to_hwc(const AlignedVector<float> &x,
+                                const std::vector<int> &s,
+                                int align_channels) {
+  if (s.size() == 3) {
+    return convert_chw_to_hwc_3d(x, s[2], s[0], s[1], align_channels);
+  }
+  if (s.size() == 4) {
+    return convert_nchw_to_nhwc_4d(x, s[0], s[3], s[1], s[2], align_channels);
+  }
+  return convert_lnchw_to_lnhwc_5d(x, s[0], s[1], s[2], s[3], s[4],
+                                   align_channels);
+}
+} // namespace
+
+// 上一级输出分块HWC张量，下一级要沿axis做gather。只拿到裸数据的调用者为了
+// 保险先转回CHW再转成分块HWC后gather；Tensor记录了排布，to_blocked直接返回
+// 原张量，gather按排布分派。对比两者的结果与耗时，并检查平面输入直接输出
+// 分块排布、切片视图上的gather与先拷贝后gather的结果一致
+float TestTensor(std::vector<int> in_shape, std::vector<int> indices, int axis,
+                 int align_channels, int repeat) {
+  std::vector<float> data(shape_numel(in_shape));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 1024);
+  }
+  Tensor<float> planar(data, in_shape);
+  Tensor<float> blocked = to_blocked(planar, align_channels);
+  std::vector<int> shape_hwc = blocked.shape_hwc();
+  bool skipped = to_blocked(blocked, align_channels).shares_storage(blocked);
+
+  struct timeval start, end;
+  AlignedVector<float> expected;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    AlignedVector<float> chw =
+        hwc_to_chw(blocked.storage(), shape_hwc, align_channels);
+    AlignedVector<float> hwc = chw_to_hwc(chw, shape_hwc, align_channels);
+    rvv::gather_hwc(expected, hwc, shape_hwc, indices, axis, align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float convert_time_use = elapsed_ms(start, end) / repeat;
+
+  Tensor<float> output;
+  bool same = true;
+  gettimeofday(&start, NULL);
+  for (int r = 0; r < repeat; ++r) {
+    same = same && rvv::gather(output, to_blocked(blocked, align_channels),
+                               indices, axis) == 0;
+  }
+  gettimeofday(&end, NULL);
+  float tensor_time_use = elapsed_ms(start, end) / repeat;
+  same = same && output.storage() == expected;
+
+  // 平面输入、输出分块排布：先gather再转换
+  Tensor<float> from_planar;
+  same = same && rvv::gather(from_planar, planar, indices, axis,
+                             kLayoutBlocked, align_channels) == 0 &&
+         from_planar.storage() == expected;
+
+  // 非C维的前半切片：视图上gather与拷贝后gather一致
+  int slice_axis = axis == blocked.channel_axis() ? blocked.rank() - 1 : axis;
+  int half = (blocked.shape()[slice_axis] + 1) / 2;
+  Tensor<float> view = blocked.slice(slice_axis, 0, half);
+  std::vector<int> view_indices = {0, half - 1};
+  Tensor<float> from_view, from_copy;
+  same = same && !view.is_contiguous() && view.shares_storage(blocked) &&
+         rvv::gather(from_view, view, view_indices, slice_axis) == 0 &&
+         rvv::gather(from_copy, view.contiguous(), view_indices,
+                     slice_axis) == 0 &&
+         from_view.storage() == from_copy.storage();
+
+  // 同一个输出张量先沿非C维、再沿C维gather：沿用的缓冲区不能留下上一次的
+  // 数据，补齐通道为0，结果与新的输出张量一致
+  int c_axis = blocked.channel_axis();
+  Tensor<float> reused, fresh;
+  same = same && rvv::gather(reused, blocked, {0}, c_axis == 0 ? 1 : 0) == 0 &&
+         rvv::gather(reused, blocked, {0}, c_axis) == 0 &&
+         rvv::gather(fresh, blocked, {0}, c_axis) == 0 &&
+         reused.storage() == fresh.storage();
+
+  printf("tensor rank%d,axis_%d,channel_%2d,%s,to_blocked %s,"
+         "convert+gather %7.3f ms,tensor gather %7.3f ms\n",
+         blocked.rank(), axis, align_channels, same ? "ok" : "failed",
+         skipped ? "skipped" : "copied", convert_time_use, tensor_time_use);
+  return tensor_time_use;
+}
@@ -0,0 +1,71 @@
+#include "convert.h"
+#include "gather.h"
+#include "op.h"
+#include "tensor_util.h"
+#include "workspace.h"
+
+// 模拟逐帧处理：CHW转HWC、沿axis做gather、再转回CHW，输出和临时张量都从同一个
+// 工作区取用、每帧结束时reset。与每次新分配的版本对比结果和每帧耗时，
+// 打印首帧与之后各帧的耗时、工作区的峰值与持有的容量
+float TestWorkspace(int c, int h, int w, std::vector<int> indices, int axis,
+                    int align_channels, int frames) {
+  std::vector<float> input(static_cast<size_t>(c) * h * w);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 1024);
+  }
+  std::vector<int> in_shape_hwc = {h, w, c};
+  int dim = axis == 0 ? c : (axis == 1 ? h : w);
+  int out_c = axis == 0 ? static_cast<int>(indices.size()) : c;
+  int out_h = axis == 1 ? static_cast<int>(indices.size()) : h;
+  int out_w = axis == 2 ? static_cast<int>(indices.size()) : w;
+
+  struct timeval start, end;
+  std::vector<float> expected;
+  gettimeofday(&start, NULL);
+  for (int f = 0; f < frames; ++f) {
+    std::vector<float> hwc =
+        convert_chw_to_hwc_3d(input, c, h, w, align_channels);
+    std::vector<float> gathered;
+    rvv::gather_hwc(gathered, hwc, in_shape_hwc, indices, axis,
+                    align_channels);
+    expected = convert_hwc_to_chw_3d(gathered, out_c, out_h, out_w,
+                                     align_channels);
+  }
+  gettimeofday(&end, NULL);
+  float new_time_use = elapsed_ms(start, end) / frames;
+
+  Workspace ws;
+  bool same = dim > 0;
+  float first_time_use = 0.0f;
+  gettimeofday(&start, NULL);
+  for (int f = 0; f < frames; ++f) {
+    struct timeval frame_start, frame_end;
+    gettimeofday(&frame_start, NULL);
+    std::vector<float> &hwc =
+        convert_chw_to_hwc_3d(input, c, h, w, align_channels, ws);
+    std::vector<float> &gathered = ws.acquire<float>(
+        gather_hwc_out_numel(in_shape_hwc, indices.size(), axis,
+                             align_channels));
+    rvv::gather_hwc(gathered, hwc, in_shape_hwc, indices, axis,
+                    align_channels);
+    std::vector<float> &output = convert_hwc_to_chw_3d(
+        gathered, out_c, out_h, out_w, align_channels, ws);
+    same = same && output == expected;
+    ws.reset();
+    gettimeofday(&frame_end, NULL);
+    if (f == 0) {
+      first_time_use = elapsed_ms(frame_start, frame_end);
+    }
+  }
+  gettimeofday(&end, NULL);
+  float ws_time_use = elapsed_ms(start, end) / frames;
+
+  printf("workspace %d_%d_%d,axis_%d,channel_%2d,%d frames,%s,"
+         "new %7.3f ms,workspace %7.3f ms (first %7.3f ms),"
+         "high water %zu KB,reserved %zu KB,%zu buffers\n",
+         c, h, w, axis, align_channels, frames, same ? "ok" : "failed",
+         new_time_use, ws_time_use, first_time_use,
+         ws.high_water_bytes() / 1024, ws.reserved_bytes() / 1024,
+         ws.buffer_count());
+  return ws_time_use;
+}
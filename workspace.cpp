@@ -0,0 +1,44 @@
+#include "workspace.h"
+
+#include <algorithm>
+
+void Workspace::release(std::size_t mark) {
+  if (mark >= acquired_.size()) {
+    return;
+  }
+  // 归还前按当前容量统计一次，使用者可能在取用后扩容
+  update_high_water();
+  for (std::size_t k = mark; k < acquired_.size(); ++k) {
+    buffers_[acquired_[k]]->busy = false;
+  }
+  acquired_.resize(mark);
+}
+
+int Workspace::shrink() {
+  if (!acquired_.empty()) {
+    return -1;
+  }
+  buffers_.clear();
+  last_.clear();
+  return 0;
+}
+
+std::size_t Workspace::used_bytes() const {
+  std::size_t bytes = 0;
+  for (std::size_t index : acquired_) {
+    bytes += buffers_[index]->capacity_bytes();
+  }
+  return bytes;
+}
+
+std::size_t Workspace::reserved_bytes() const {
+  std::size_t bytes = 0;
+  for (const auto& buf : buffers_) {
+    bytes += buf->capacity_bytes();
+  }
+  return bytes;
+}
+
+void Workspace::update_high_water() {
+  high_water_ = std::max(high_water_, used_bytes());
+}
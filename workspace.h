@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// 跨帧复用的工作区：gather输出、convert_*的输出和补零临时张量都从这里取
+// std::vector缓冲区。缓冲区归还后保留容量，下一帧按同样的顺序取用时不再
+// 调用malloc，避免rt-smart上反复申请几百MB造成的堆碎片和延迟尖峰。
+// 取用按栈的顺序记录：mark()/release(mark)或WorkspaceScope归还某一点之后取用的
+// 缓冲区，reset()在帧之间归还全部缓冲区。不是线程安全的，每个线程用各自的工作区
+//   std::vector<float>& out = ws.acquire<float>(n);
+//   rvv::gather_hwc(out, input, in_shape_hwc, indices, axis_chw, align);
+class Workspace {
+ public:
+  Workspace() = default;
+  Workspace(const Workspace&) = delete;
+  Workspace& operator=(const Workspace&) = delete;
+
+  // 取一个空的（size为0）缓冲区并预留n个元素。优先沿用上一次在同一取用位置
+  // 使用的缓冲区（每帧顺序相同时第一帧之后不再分配），其次选容量不小于n的
+  // 最小空闲缓冲区，没有时选同类型容量最大的空闲缓冲区
+  // （扩容一次后留在工作区）；n为0（大小未知）时不按容量筛选，
+  // 沿用上次的或选容量最大的空闲缓冲区。
+  // 返回的引用在归还前有效，使用者可以resize超过n
+  template <typename T>
+  std::vector<T>& acquire(std::size_t n);
+
+  // 当前的取用位置，release(mark)归还此后取用的全部缓冲区
+  std::size_t mark() const { return acquired_.size(); }
+  void release(std::size_t mark);
+
+  // 帧之间调用：归还全部缓冲区，容量保留
+  void reset() { release(0); }
+
+  // 释放全部缓冲区的内存（如分辨率变化后），仍有缓冲区未归还时不释放并返回-1
+  int shrink();
+
+  // 取用中的缓冲区容量之和、其历史最大值（按取用和归还时的容量统计）
+  // 与工作区持有的全部容量（字节）
+  std::size_t used_bytes() const;
+  std::size_t high_water_bytes() const { return high_water_; }
+  std::size_t reserved_bytes() const;
+  std::size_t buffer_count() const { return buffers_.size(); }
+
+ private:
+  struct BufferBase {
+    virtual ~BufferBase() = default;
+    virtual std::size_t capacity_bytes() const = 0;
+    bool busy = false;
+  };
+  template <typename T>
+  struct Buffer : BufferBase {
+    std::vector<T> data;
+    std::size_t capacity_bytes() const override {
+      return data.capacity() * sizeof(T);
+    }
+  };
+
+  void update_high_water();
+
+  std::vector<std::unique_ptr<BufferBase>> buffers_;
+  // 取用顺序，元素为buffers_的下标
+  std::vector<std::size_t> acquired_;
+  // 每个取用位置上一次使用的缓冲区下标
+  std::vector<std::size_t> last_;
+  std::size_t high_water_ = 0;
+};
+
+// 作用域内取用的缓冲区在析构时归还（如convert_*的补零临时张量）
+class WorkspaceScope {
+ public:
+  explicit WorkspaceScope(Workspace& ws) : ws_(ws), mark_(ws.mark()) {}
+  ~WorkspaceScope() { ws_.release(mark_); }
+  WorkspaceScope(const WorkspaceScope&) = delete;
+  WorkspaceScope& operator=(const WorkspaceScope&) = delete;
+
+ private:
+  Workspace& ws_;
+  std::size_t mark_;
+};
+
+template <typename T>
+std::vector<T>& Workspace::acquire(std::size_t n) {
+  const std::size_t bytes = n * sizeof(T);
+  const std::size_t pos = acquired_.size();
+  Buffer<T>* best = nullptr;
+  std::size_t best_index = 0;
+  if (pos < last_.size() && !buffers_[last_[pos]]->busy) {
+    Buffer<T>* buf = dynamic_cast<Buffer<T>*>(buffers_[last_[pos]].get());
+    if (buf != nullptr && (n == 0 || buf->capacity_bytes() >= bytes)) {
+      best = buf;
+      best_index = last_[pos];
+    }
+  }
+  if (best == nullptr) {
+    for (std::size_t i = 0; i < buffers_.size(); ++i) {
+      if (buffers_[i]->busy) {
+        continue;
+      }
+      Buffer<T>* buf = dynamic_cast<Buffer<T>*>(buffers_[i].get());
+      if (buf == nullptr) {
+        continue;
+      }
+      std::size_t cap = buf->capacity_bytes();
+      bool better = best == nullptr;
+      if (!better) {
+        std::size_t best_cap = best->capacity_bytes();
+        bool fits = n > 0 && cap >= bytes;
+        bool best_fits = n > 0 && best_cap >= bytes;
+        // 都装得下时取较小的，否则取较大的
+        better = fits != best_fits ? fits
+                                   : (fits ? cap < best_cap : cap > best_cap);
+      }
+      if (better) {
+        best = buf;
+        best_index = i;
+      }
+    }
+  }
+  if (best == nullptr) {
+    buffers_.emplace_back(new Buffer<T>());
+    best = static_cast<Buffer<T>*>(buffers_.back().get());
+    best_index = buffers_.size() - 1;
+  }
+  best->busy = true;
+  best->data.clear();
+  best->data.reserve(n);
+  acquired_.push_back(best_index);
+  if (pos < last_.size()) {
+    last_[pos] = best_index;
+  } else {
+    last_.push_back(best_index);
+  }
+  update_high_water();
+  return best->data;
+}